@@ -0,0 +1,359 @@
+#ifndef JS_ABORT_H
+#define JS_ABORT_H
+
+// Cancellation (AbortController / AbortSignal) and structured task groups.
+//
+// An AbortSignal is a cheap handle to shared state, so copies observe the same
+// abort. Operations that accept a signal (abortable(), timers, js::fs) settle
+// with the abort reason once it fires. Awaiting coroutines then unwind and
+// free their frames instead of waiting on work nobody needs any more.
+// Signals are meant to be aborted from the event loop thread.
+
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/any.h"
+#include "async.h"
+#include "event_loop.h"
+
+namespace js {
+
+namespace detail {
+
+// DOMException-style error value ({ name, message })
+inline js::any domException(const char* name, const char* message) {
+    object error;
+    error.set("_type", string("Error"));
+    error.set("name", string(name));
+    error.set("message", string(message));
+    return js::any(error);
+}
+
+inline js::any abortError() {
+    return domException("AbortError", "This operation was aborted");
+}
+
+} // namespace detail
+
+class AbortController;
+
+// AbortSignal - observes the abort of its controller
+class AbortSignal {
+public:
+    using listener_type = std::function<void(const js::any& reason)>;
+    using listener_id = size_t;
+
+    // A default-constructed signal never aborts and allocates nothing
+    AbortSignal() = default;
+
+    // Copies share the state; the properties stay bound to their own signal
+    AbortSignal(const AbortSignal& other) : state_(other.state_) {}
+    AbortSignal(AbortSignal&& other) noexcept : state_(std::move(other.state_)) {}
+
+    AbortSignal& operator=(const AbortSignal& other) {
+        state_ = other.state_;
+        return *this;
+    }
+
+    AbortSignal& operator=(AbortSignal&& other) noexcept {
+        state_ = std::move(other.state_);
+        return *this;
+    }
+
+    // signal.aborted - read as a property, as in TypeScript, or called
+    struct AbortedProperty {
+        const AbortSignal* signal;
+
+        operator bool() const { return signal->state_ && signal->state_->aborted; }
+        bool operator()() const { return *this; }
+    };
+
+    // signal.reason - read as a property, as in TypeScript, or called
+    struct ReasonProperty {
+        const AbortSignal* signal;
+
+        operator js::any() const {
+            return signal->state_ ? signal->state_->reason : js::any();
+        }
+        js::any operator()() const { return *this; }
+    };
+
+    AbortedProperty aborted{this};
+    ReasonProperty reason{this};
+
+    void throwIfAborted() const {
+        if (aborted()) throw state_->reason;
+    }
+
+    // Register an abort listener; returns 0 (and never calls it) if the signal
+    // cannot abort or already has
+    listener_id onAbort(listener_type listener) const {
+        if (!state_ || state_->aborted) return 0;
+        listener_id id = state_->nextListener++;
+        state_->listeners.emplace_back(id, std::move(listener));
+        return id;
+    }
+
+    void removeListener(listener_id id) const {
+        if (!state_ || id == 0) return;
+        auto& listeners = state_->listeners;
+        for (auto it = listeners.begin(); it != listeners.end(); ++it) {
+            if (it->first == id) {
+                listeners.erase(it);
+                return;
+            }
+        }
+    }
+
+    // signal.addEventListener("abort", listener)
+    listener_id addEventListener(const string& type, std::function<void()> listener) const {
+        if (type.value() != "abort") return 0;
+        return onAbort([listener = std::move(listener)](const js::any&) { listener(); });
+    }
+
+    // AbortSignal.abort(reason) - an already aborted signal
+    static AbortSignal abort(js::any reason = detail::abortError()) {
+        AbortSignal signal(std::make_shared<State>());
+        signal.signalAbort(std::move(reason));
+        return signal;
+    }
+
+    // AbortSignal.timeout(ms) - aborts with a TimeoutError after the delay.
+    // The timer is cleared when the last copy of the signal goes away.
+    static AbortSignal timeout(number milliseconds) {
+        AbortSignal signal(std::make_shared<State>());
+        std::weak_ptr<State> weak = signal.state_;
+        signal.state_->timer = EventLoop::instance().setTimer(
+            std::chrono::milliseconds(static_cast<long long>(milliseconds.value())), [weak] {
+                if (auto state = weak.lock()) {
+                    state->timer = 0;
+                    AbortSignal(state).signalAbort(
+                        detail::domException("TimeoutError", "The operation timed out."));
+                }
+            });
+        return signal;
+    }
+
+    // AbortSignal.any(signals) - aborts as soon as any input does
+    static AbortSignal any(const std::vector<AbortSignal>& signals) {
+        AbortSignal combined(std::make_shared<State>());
+        for (const auto& signal : signals) {
+            if (signal.aborted()) {
+                combined.signalAbort(signal.reason());
+                return combined;
+            }
+        }
+        std::weak_ptr<State> weak = combined.state_;
+        for (const auto& signal : signals) {
+            signal.onAbort([weak](const js::any& reason) {
+                if (auto state = weak.lock()) {
+                    AbortSignal(state).signalAbort(reason);
+                }
+            });
+        }
+        return combined;
+    }
+
+private:
+    friend class AbortController;
+
+    struct State {
+        bool aborted = false;
+        js::any reason;
+        std::vector<std::pair<listener_id, listener_type>> listeners;
+        listener_id nextListener = 1;
+        EventLoop::timer_id timer = 0;
+
+        ~State() {
+            if (timer) EventLoop::instance().clearTimer(timer);
+        }
+    };
+
+    explicit AbortSignal(std::shared_ptr<State> state) : state_(std::move(state)) {}
+
+    void signalAbort(js::any reason) const {
+        if (!state_ || state_->aborted) return;
+        auto keepAlive = state_;
+        keepAlive->aborted = true;
+        keepAlive->reason = std::move(reason);
+        auto listeners = std::exchange(keepAlive->listeners, {});
+        for (auto& entry : listeners) {
+            entry.second(keepAlive->reason);
+        }
+    }
+
+    std::shared_ptr<State> state_;
+};
+
+// AbortController - owns the signal handed out to cancellable operations
+class AbortController {
+public:
+    AbortController() : signal(std::make_shared<AbortSignal::State>()) {}
+
+    void abort(js::any reason = detail::abortError()) const {
+        signal.signalAbort(std::move(reason));
+    }
+
+    AbortSignal signal;
+};
+
+namespace detail {
+
+// Mirrors a promise until the signal aborts, then rejects with the reason
+template<typename T>
+class AbortableState : public Continuation<T> {
+public:
+    AbortableState(std::shared_ptr<Promise<T>> result, AbortSignal signal)
+        : result_(std::move(result)), signal_(std::move(signal)) {
+        std::weak_ptr<Promise<T>> weak = result_;
+        listener_ = signal_.onAbort([weak](const js::any& reason) {
+            if (auto result = weak.lock()) {
+                result->rejectWith(std::make_exception_ptr(reason));
+            }
+        });
+    }
+
+    void fulfilled(size_t, const settled_value_t<T>& value) override {
+        signal_.removeListener(listener_);
+        if constexpr (std::is_void_v<T>) {
+            result_->resolveWith();
+        } else {
+            result_->resolveWith(value);
+        }
+    }
+
+    void rejected(size_t, std::exception_ptr error) override {
+        signal_.removeListener(listener_);
+        result_->rejectWith(error);
+    }
+
+private:
+    std::shared_ptr<Promise<T>> result_;
+    AbortSignal signal_;
+    AbortSignal::listener_id listener_ = 0;
+};
+
+} // namespace detail
+
+// Await `promise` but give up as soon as `signal` aborts. The awaiting
+// coroutine resumes with the abort reason thrown; the underlying operation is
+// only stopped if it observes the signal itself.
+template<typename T>
+std::shared_ptr<Promise<T>> abortable(std::shared_ptr<Promise<T>> promise, const AbortSignal& signal) {
+    if (signal.aborted()) {
+        return Promise<T>::reject(std::make_exception_ptr(signal.reason()));
+    }
+    auto result = std::make_shared<Promise<T>>();
+    promise->subscribe(std::make_shared<detail::AbortableState<T>>(result, signal));
+    return result;
+}
+
+template<typename T>
+std::shared_ptr<Promise<T>> abortable(const Task<T>& task, const AbortSignal& signal) {
+    return abortable(task.promise(), signal);
+}
+
+// TaskGroup - structured concurrency scope.
+//
+// Children share the group's signal. The first failure aborts it so siblings
+// can unwind, and wait() settles only after every child has finished,
+// rejecting with that first failure.
+class TaskGroup {
+public:
+    TaskGroup() : state_(std::make_shared<State>()) {}
+
+    const AbortSignal& signal() const { return state_->controller.signal; }
+
+    size_t running() const { return state_->running; }
+
+    template<typename T>
+    void spawn(std::shared_ptr<Promise<T>> child) {
+        ++state_->running;
+        child->subscribe(std::make_shared<Child<T>>(state_));
+    }
+
+    template<typename T>
+    void spawn(const Task<T>& child) {
+        spawn(child.promise());
+    }
+
+    // spawn([](js::AbortSignal signal) -> js::Task<T> { ... }); nothing is
+    // started once the group has been cancelled
+    template<typename Factory>
+        requires std::is_invocable_v<Factory&, const AbortSignal&>
+    void spawn(Factory&& factory) {
+        if (signal().aborted()) return;
+        spawn(factory(signal()));
+    }
+
+    // Abort every child
+    void cancel(js::any reason = detail::abortError()) const {
+        state_->controller.abort(std::move(reason));
+    }
+
+    // Settles once all children have finished
+    std::shared_ptr<Promise<void>> wait() {
+        if (!state_->done) {
+            state_->done = std::make_shared<Promise<void>>();
+        }
+        if (state_->running == 0) {
+            state_->settle();
+        }
+        return state_->done;
+    }
+
+private:
+    struct State {
+        AbortController controller;
+        size_t running = 0;
+        std::exception_ptr failure;
+        std::shared_ptr<Promise<void>> done;
+
+        void settle() {
+            if (!done) return;
+            if (failure) {
+                done->rejectWith(failure);
+            } else {
+                done->resolveWith();
+            }
+        }
+    };
+
+    template<typename T>
+    class Child : public detail::Continuation<T> {
+    public:
+        explicit Child(std::shared_ptr<State> group) : group_(std::move(group)) {}
+
+        void fulfilled(size_t, const detail::settled_value_t<T>&) override {
+            finish();
+        }
+
+        void rejected(size_t, std::exception_ptr error) override {
+            if (!group_->failure) {
+                group_->failure = error;
+                group_->controller.abort(detail::reasonOf(error));
+            }
+            finish();
+        }
+
+    private:
+        void finish() {
+            if (--group_->running == 0) {
+                group_->settle();
+            }
+        }
+
+        std::shared_ptr<State> group_;
+    };
+
+    std::shared_ptr<State> state_;
+};
+
+} // namespace js
+
+#endif // JS_ABORT_H
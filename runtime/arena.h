@@ -0,0 +1,180 @@
+#ifndef JS_ARENA_H
+#define JS_ARENA_H
+
+// Bump-pointer arenas for request-scoped allocations (--memory=arena).
+//
+// A js::ArenaScope makes a per-thread arena the current memory resource for
+// its lifetime. While it is open, js::arena_new<T>() and the storage of
+// js::array / js::object come from that arena, and individual frees are
+// no-ops. When the scope ends the arena is reset in one step and its blocks
+// are kept for the next scope at the same depth. Nothing allocated inside a
+// scope may outlive it.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "memory_resource.h"
+
+namespace js {
+
+class Arena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t defaultBlockSize = 64 * 1024;
+
+    // Blocks come from `upstream` (the process-wide resource by default)
+    explicit Arena(size_t blockSize = defaultBlockSize,
+                   std::pmr::memory_resource* upstream = get_memory_resource())
+        : blockSize_(blockSize), upstream_(upstream) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena() override {
+        release(blocks_);
+        release(large_);
+    }
+
+    // Forget every allocation; blocks are kept for reuse
+    void reset() noexcept {
+        release(large_);
+        current_ = nullptr;
+        cursor_ = limit_ = nullptr;
+        bytesAllocated_ = 0;
+    }
+
+    size_t bytesAllocated() const noexcept { return bytesAllocated_; }
+
+    // Arena of the innermost open ArenaScope on this thread, if any
+    static Arena* current() noexcept {
+        Stack& stack = scopes();
+        return stack.depth > 0 ? stack.arenas[stack.depth - 1].get() : nullptr;
+    }
+
+protected:
+    void* do_allocate(size_t size, size_t alignment) override {
+        if (size > blockSize_ / 4) {
+            // Oversized requests get a block of their own, dropped on reset
+            large_ = newBlock(size + alignment, large_);
+            bytesAllocated_ += size;
+            return alignUp(large_->data(), alignment);
+        }
+
+        char* start = cursor_ ? alignUp(cursor_, alignment) : nullptr;
+        if (!start || start + size > limit_) {
+            nextBlock();
+            start = alignUp(cursor_, alignment);
+        }
+        cursor_ = start + size;
+        bytesAllocated_ += size;
+        return start;
+    }
+
+    // Arena memory is released when its scope ends
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    friend class ArenaScope;
+
+    struct Block {
+        Block* next;
+        size_t size;
+
+        char* data() { return reinterpret_cast<char*>(this + 1); }
+    };
+
+    // Arenas by scope depth, reused across scopes
+    struct Stack {
+        std::vector<std::unique_ptr<Arena>> arenas;
+        size_t depth = 0;
+    };
+
+    static Stack& scopes() {
+        thread_local Stack stack;
+        return stack;
+    }
+
+    void nextBlock() {
+        Block*& next = current_ ? current_->next : blocks_;
+        if (!next) {
+            next = newBlock(blockSize_, nullptr);
+        }
+        current_ = next;
+        cursor_ = next->data();
+        limit_ = cursor_ + next->size;
+    }
+
+    Block* newBlock(size_t size, Block* next) {
+        void* memory = upstream_->allocate(sizeof(Block) + size, alignof(std::max_align_t));
+        return new (memory) Block{next, size};
+    }
+
+    void release(Block*& head) noexcept {
+        while (head) {
+            Block* next = head->next;
+            upstream_->deallocate(head, sizeof(Block) + head->size, alignof(std::max_align_t));
+            head = next;
+        }
+    }
+
+    static char* alignUp(char* pointer, size_t alignment) {
+        auto address = reinterpret_cast<std::uintptr_t>(pointer);
+        return pointer + ((alignment - address % alignment) % alignment);
+    }
+
+    size_t blockSize_;
+    std::pmr::memory_resource* upstream_;
+    Block* blocks_ = nullptr;
+    Block* large_ = nullptr;
+    Block* current_ = nullptr;
+    char* cursor_ = nullptr;
+    char* limit_ = nullptr;
+    size_t bytesAllocated_ = 0;
+};
+
+// Makes a fresh arena current until the end of the enclosing block
+class ArenaScope {
+public:
+    ArenaScope() : arena_(acquire()), resource_(arena_) {}
+
+    ~ArenaScope() {
+        arena_->reset();
+        --Arena::scopes().depth;
+    }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+    Arena& arena() { return *arena_; }
+
+private:
+    static Arena* acquire() {
+        Arena::Stack& stack = Arena::scopes();
+        if (stack.depth == stack.arenas.size()) {
+            stack.arenas.push_back(std::make_unique<Arena>());
+        }
+        return stack.arenas[stack.depth++].get();
+    }
+
+    Arena* arena_;
+    ResourceScope resource_;
+};
+
+// Class instance allocation for --memory=arena: control block and object come
+// from the current resource (the innermost arena, if any)
+template<typename T, typename... Args>
+std::shared_ptr<T> arena_new(Args&&... args) {
+    return std::allocate_shared<T>(allocator<T>(current_resource()), std::forward<Args>(args)...);
+}
+
+} // namespace js
+
+#endif // JS_ARENA_H
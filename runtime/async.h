@@ -5,11 +5,19 @@
 #include <exception>
 #include <memory>
 #include <functional>
+#include <iterator>
 #include <variant>
 #include <optional>
 #include <vector>
 #include <queue>
 #include <atomic>
+#include <deque>
+#include <type_traits>
+#include <utility>
+
+#include "core/any.h"
+#include "coroutine.h"
+#include "event_loop.h"
 
 namespace js {
 
@@ -28,6 +36,42 @@ enum class PromiseState {
 template<typename T>
 using PromiseResult = std::variant<std::monostate, T, std::exception_ptr>;
 
+// Outcome of one input of Promise.allSettled
+template<typename T>
+struct PromiseSettledResult {
+    string status;              // "fulfilled" or "rejected"
+    std::optional<T> value;
+    any reason;
+};
+
+template<>
+struct PromiseSettledResult<void> {
+    string status;
+    any reason;
+};
+
+namespace detail {
+
+template<typename T>
+using settled_value_t = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+// Settlement receiver registered directly on a promise.
+//
+// The combinators register one shared state object on every input instead of
+// chaining then()/catch_() promises per element; the index says which input
+// settled. Promises settle on the event loop thread, so no locking is needed.
+template<typename T>
+struct Continuation {
+    virtual ~Continuation() = default;
+    virtual void fulfilled(size_t index, const settled_value_t<T>& value) = 0;
+    virtual void rejected(size_t index, std::exception_ptr error) = 0;
+};
+
+template<typename T>
+using ContinuationList = std::vector<std::pair<std::shared_ptr<Continuation<T>>, size_t>>;
+
+} // namespace detail
+
 // Promise implementation
 template<typename T>
 class Promise : public std::enable_shared_from_this<Promise<T>> {
@@ -43,24 +87,24 @@ public:
     explicit Promise(Executor&& executor) : state_(PromiseState::Pending) {
         try {
             executor(
-                [this](const T& value) { resolve(value); },
-                [this](std::exception_ptr error) { reject(error); }
+                [this](const T& value) { resolveWith(value); },
+                [this](std::exception_ptr error) { rejectWith(error); }
             );
         } catch (...) {
-            reject(std::current_exception());
+            rejectWith(std::current_exception());
         }
     }
     
     // Static factory methods
     static std::shared_ptr<Promise<T>> resolve(const T& value) {
         auto promise = std::make_shared<Promise<T>>();
-        promise->resolve(value);
+        promise->resolveWith(value);
         return promise;
     }
     
     static std::shared_ptr<Promise<T>> reject(std::exception_ptr error) {
         auto promise = std::make_shared<Promise<T>>();
-        promise->reject(error);
+        promise->rejectWith(error);
         return promise;
     }
     
@@ -74,17 +118,17 @@ public:
             try {
                 if constexpr (std::is_void_v<ReturnType>) {
                     onFulfilled(value);
-                    nextPromise->resolve();
+                    nextPromise->resolveWith();
                 } else {
-                    nextPromise->resolve(onFulfilled(value));
+                    nextPromise->resolveWith(onFulfilled(value));
                 }
             } catch (...) {
-                nextPromise->reject(std::current_exception());
+                nextPromise->rejectWith(std::current_exception());
             }
         });
         
         addErrorCallback([nextPromise](std::exception_ptr error) {
-            nextPromise->reject(error);
+            nextPromise->rejectWith(error);
         });
         
         return nextPromise;
@@ -95,7 +139,7 @@ public:
         auto nextPromise = std::make_shared<Promise<T>>();
         
         addCallback([nextPromise](const T& value) {
-            nextPromise->resolve(value);
+            nextPromise->resolveWith(value);
         });
         
         addErrorCallback([nextPromise, onRejected](std::exception_ptr error) {
@@ -104,7 +148,7 @@ public:
                 // If error handler doesn't throw, consider it handled
                 // This is simplified - real implementation would need more logic
             } catch (...) {
-                nextPromise->reject(std::current_exception());
+                nextPromise->rejectWith(std::current_exception());
             }
         });
         
@@ -142,69 +186,44 @@ public:
         std::rethrow_exception(std::get<std::exception_ptr>(result_));
     }
     
-    // Promise.all - wait for all promises to resolve
-    static std::shared_ptr<Promise<std::vector<T>>> all(const std::vector<std::shared_ptr<Promise<T>>>& promises) {
-        auto resultPromise = std::make_shared<Promise<std::vector<T>>>();
-        auto results = std::make_shared<std::vector<T>>();
-        auto completed = std::make_shared<std::atomic<size_t>>(0);
-        
-        if (promises.empty()) {
-            resultPromise->resolve(std::vector<T>{});
-            return resultPromise;
-        }
-        
-        results->resize(promises.size());
-        
-        for (size_t i = 0; i < promises.size(); ++i) {
-            promises[i]->then([resultPromise, results, completed, i, total = promises.size()](const T& value) {
-                (*results)[i] = value;
-                if (++(*completed) == total) {
-                    resultPromise->resolve(*results);
-                }
-            })->catch_([resultPromise](std::exception_ptr error) {
-                resultPromise->reject(error);
-            });
-        }
-        
-        return resultPromise;
-    }
+    // Promise.all - fulfil with every value in input order, reject on the first rejection
+    static std::shared_ptr<Promise<std::vector<T>>> all(const std::vector<std::shared_ptr<Promise<T>>>& promises);
+
+    // Promise.allSettled - wait for every input and report each outcome
+    static std::shared_ptr<Promise<std::vector<PromiseSettledResult<T>>>> allSettled(const std::vector<std::shared_ptr<Promise<T>>>& promises);
+
+    // Promise.any - fulfil with the first fulfilment, reject with an AggregateError if all reject
+    static std::shared_ptr<Promise<T>> any(const std::vector<std::shared_ptr<Promise<T>>>& promises);
 
     // Promise.race - resolve/reject with first settled promise
-    static std::shared_ptr<Promise<T>> race(const std::vector<std::shared_ptr<Promise<T>>>& promises) {
-        auto resultPromise = std::make_shared<Promise<T>>();
-        auto settled = std::make_shared<std::atomic<bool>>(false);
-        
-        for (const auto& promise : promises) {
-            promise->then([resultPromise, settled](const T& value) {
-                bool expected = false;
-                if (settled->compare_exchange_strong(expected, true)) {
-                    resultPromise->resolve(value);
-                }
-            })->catch_([resultPromise, settled](std::exception_ptr error) {
-                bool expected = false;
-                if (settled->compare_exchange_strong(expected, true)) {
-                    resultPromise->reject(error);
-                }
-            });
+    static std::shared_ptr<Promise<T>> race(const std::vector<std::shared_ptr<Promise<T>>>& promises);
+    
+    // Register a continuation without allocating an intermediate promise;
+    // runs immediately if the promise has already settled
+    void subscribe(std::shared_ptr<detail::Continuation<T>> continuation, size_t index = 0) {
+        if (state_ == PromiseState::Fulfilled) {
+            continuation->fulfilled(index, std::get<T>(result_));
+        } else if (state_ == PromiseState::Rejected) {
+            continuation->rejected(index, std::get<std::exception_ptr>(result_));
+        } else {
+            continuations_.emplace_back(std::move(continuation), index);
         }
-        
-        return resultPromise;
     }
     
-private:
-    void resolve(const T& value) {
+    // Settle the promise (no-op once settled)
+    void resolveWith(const T& value) {
         if (state_ != PromiseState::Pending) return;
-        
-        state_ = PromiseState::Fulfilled;
         result_ = value;
-        
-        for (auto& callback : callbacks_) {
-            callback(value);
-        }
-        callbacks_.clear();
+        fulfil();
+    }
+    
+    void resolveWith(T&& value) {
+        if (state_ != PromiseState::Pending) return;
+        result_ = std::move(value);
+        fulfil();
     }
     
-    void reject(std::exception_ptr error) {
+    void rejectWith(std::exception_ptr error) {
         if (state_ != PromiseState::Pending) return;
         
         state_ = PromiseState::Rejected;
@@ -214,6 +233,27 @@ private:
             callback(error);
         }
         errorCallbacks_.clear();
+        
+        for (auto& [continuation, index] : std::exchange(continuations_, {})) {
+            continuation->rejected(index, error);
+        }
+        callbacks_.clear();
+    }
+    
+private:
+    void fulfil() {
+        state_ = PromiseState::Fulfilled;
+        const T& value = std::get<T>(result_);
+        
+        for (auto& callback : callbacks_) {
+            callback(value);
+        }
+        callbacks_.clear();
+        
+        for (auto& [continuation, index] : std::exchange(continuations_, {})) {
+            continuation->fulfilled(index, value);
+        }
+        errorCallbacks_.clear();
     }
     
     void addCallback(callback_type callback) {
@@ -233,15 +273,18 @@ private:
     }
     
     PromiseState state_;
+    JS_TRACK_INSTANCES(Promise)
     PromiseResult<T> result_;
     std::vector<callback_type> callbacks_;
     std::vector<error_callback_type> errorCallbacks_;
+    detail::ContinuationList<T> continuations_;
 };
 
 // Specialization for void
 template<>
 class Promise<void> : public std::enable_shared_from_this<Promise<void>> {
 public:
+    using value_type = void;
     using callback_type = std::function<void()>;
     using error_callback_type = std::function<void(std::exception_ptr)>;
     
@@ -249,26 +292,35 @@ public:
     
     static std::shared_ptr<Promise<void>> resolve() {
         auto promise = std::make_shared<Promise<void>>();
-        promise->resolve();
+        promise->resolveWith();
         return promise;
     }
     
     static std::shared_ptr<Promise<void>> reject(std::exception_ptr error) {
         auto promise = std::make_shared<Promise<void>>();
-        promise->reject(error);
+        promise->rejectWith(error);
         return promise;
     }
     
-    void resolve() {
+    static std::shared_ptr<Promise<void>> all(const std::vector<std::shared_ptr<Promise<void>>>& promises);
+    static std::shared_ptr<Promise<std::vector<PromiseSettledResult<void>>>> allSettled(const std::vector<std::shared_ptr<Promise<void>>>& promises);
+    static std::shared_ptr<Promise<void>> any(const std::vector<std::shared_ptr<Promise<void>>>& promises);
+    static std::shared_ptr<Promise<void>> race(const std::vector<std::shared_ptr<Promise<void>>>& promises);
+    
+    void resolveWith() {
         if (state_ != PromiseState::Pending) return;
         state_ = PromiseState::Fulfilled;
         for (auto& callback : callbacks_) {
             callback();
         }
         callbacks_.clear();
+        for (auto& [continuation, index] : std::exchange(continuations_, {})) {
+            continuation->fulfilled(index, std::monostate{});
+        }
+        errorCallbacks_.clear();
     }
     
-    void reject(std::exception_ptr error) {
+    void rejectWith(std::exception_ptr error) {
         if (state_ != PromiseState::Pending) return;
         state_ = PromiseState::Rejected;
         error_ = error;
@@ -276,6 +328,10 @@ public:
             callback(error);
         }
         errorCallbacks_.clear();
+        for (auto& [continuation, index] : std::exchange(continuations_, {})) {
+            continuation->rejected(index, error);
+        }
+        callbacks_.clear();
     }
     
     bool await_ready() const noexcept {
@@ -289,22 +345,285 @@ public:
     
     void await_resume() {
         if (state_ == PromiseState::Rejected && error_) {
-            std::rethrow_exception(error_);
+            std::rethrow_exception(*error_);
+        }
+    }
+    
+    void subscribe(std::shared_ptr<detail::Continuation<void>> continuation, size_t index = 0) {
+        if (state_ == PromiseState::Fulfilled) {
+            continuation->fulfilled(index, std::monostate{});
+        } else if (state_ == PromiseState::Rejected) {
+            continuation->rejected(index, *error_);
+        } else {
+            continuations_.emplace_back(std::move(continuation), index);
         }
     }
     
 private:
     PromiseState state_;
+    JS_TRACK_INSTANCES(Promise)
     std::optional<std::exception_ptr> error_;
     std::vector<callback_type> callbacks_;
     std::vector<error_callback_type> errorCallbacks_;
+    detail::ContinuationList<void> continuations_;
+};
+
+namespace detail {
+
+// Rejection reason as a JavaScript value (generated code throws js::any)
+inline js::any reasonOf(std::exception_ptr error) {
+    try {
+        std::rethrow_exception(error);
+    } catch (const js::any& reason) {
+        return reason;
+    } catch (const Error& reason) {
+        return js::any(reason);
+    } catch (const std::exception& reason) {
+        return js::any(Error(string(reason.what())));
+    } catch (...) {
+        return js::any(Error("Unknown error"));
+    }
+}
+
+inline std::exception_ptr aggregateRejection(std::vector<js::any> errors) {
+    object reason;
+    reason.set("_type", string("AggregateError"));
+    reason.set("message", string("All promises were rejected"));
+    reason.set("errors", array<js::any>(std::move(errors)));
+    return std::make_exception_ptr(js::any(reason));
+}
+
+template<typename T>
+using all_result_t = std::conditional_t<std::is_void_v<T>, void, std::vector<T>>;
+
+// Shared state of Promise.all: one slot per input, moved out once complete
+template<typename T>
+class AllState : public Continuation<T> {
+public:
+    AllState(std::shared_ptr<Promise<all_result_t<T>>> result, size_t count)
+        : result_(std::move(result)), remaining_(count) {
+        if constexpr (!std::is_void_v<T>) {
+            values_.resize(count);
+        }
+    }
+
+    void fulfilled(size_t index, const settled_value_t<T>& value) override {
+        if constexpr (std::is_void_v<T>) {
+            if (--remaining_ == 0) result_->resolveWith();
+        } else {
+            values_[index].emplace(value);
+            if (--remaining_ == 0) {
+                std::vector<T> values;
+                values.reserve(values_.size());
+                for (auto& slot : values_) {
+                    values.push_back(std::move(*slot));
+                }
+                values_.clear();
+                result_->resolveWith(std::move(values));
+            }
+        }
+    }
+
+    void rejected(size_t, std::exception_ptr error) override {
+        result_->rejectWith(error);
+    }
+
+private:
+    std::shared_ptr<Promise<all_result_t<T>>> result_;
+    std::conditional_t<std::is_void_v<T>, std::monostate, std::vector<std::optional<settled_value_t<T>>>> values_;
+    size_t remaining_;
+};
+
+// Shared state of Promise.allSettled
+template<typename T>
+class AllSettledState : public Continuation<T> {
+public:
+    AllSettledState(std::shared_ptr<Promise<std::vector<PromiseSettledResult<T>>>> result, size_t count)
+        : result_(std::move(result)), results_(count), remaining_(count) {}
+
+    void fulfilled(size_t index, const settled_value_t<T>& value) override {
+        results_[index].status = string("fulfilled");
+        if constexpr (!std::is_void_v<T>) {
+            results_[index].value.emplace(value);
+        }
+        settle();
+    }
+
+    void rejected(size_t index, std::exception_ptr error) override {
+        results_[index].status = string("rejected");
+        results_[index].reason = reasonOf(error);
+        settle();
+    }
+
+private:
+    void settle() {
+        if (--remaining_ == 0) {
+            result_->resolveWith(std::move(results_));
+        }
+    }
+
+    std::shared_ptr<Promise<std::vector<PromiseSettledResult<T>>>> result_;
+    std::vector<PromiseSettledResult<T>> results_;
+    size_t remaining_;
+};
+
+// Shared state of Promise.any: rejection reasons kept for the AggregateError
+template<typename T>
+class AnyState : public Continuation<T> {
+public:
+    AnyState(std::shared_ptr<Promise<T>> result, size_t count)
+        : result_(std::move(result)), errors_(count), remaining_(count) {}
+
+    void fulfilled(size_t, const settled_value_t<T>& value) override {
+        if constexpr (std::is_void_v<T>) {
+            result_->resolveWith();
+        } else {
+            result_->resolveWith(value);
+        }
+    }
+
+    void rejected(size_t index, std::exception_ptr error) override {
+        errors_[index] = reasonOf(error);
+        if (--remaining_ == 0) {
+            result_->rejectWith(aggregateRejection(std::move(errors_)));
+        }
+    }
+
+private:
+    std::shared_ptr<Promise<T>> result_;
+    std::vector<js::any> errors_;
+    size_t remaining_;
 };
 
+// Shared state of Promise.race: the first settlement wins, later ones are no-ops
+template<typename T>
+class RaceState : public Continuation<T> {
+public:
+    explicit RaceState(std::shared_ptr<Promise<T>> result) : result_(std::move(result)) {}
+
+    void fulfilled(size_t, const settled_value_t<T>& value) override {
+        if constexpr (std::is_void_v<T>) {
+            result_->resolveWith();
+        } else {
+            result_->resolveWith(value);
+        }
+    }
+
+    void rejected(size_t, std::exception_ptr error) override {
+        result_->rejectWith(error);
+    }
+
+private:
+    std::shared_ptr<Promise<T>> result_;
+};
+
+} // namespace detail
+
+template<typename T>
+std::shared_ptr<Promise<std::vector<T>>> Promise<T>::all(const std::vector<std::shared_ptr<Promise<T>>>& promises) {
+    auto result = std::make_shared<Promise<std::vector<T>>>();
+    if (promises.empty()) {
+        result->resolveWith(std::vector<T>{});
+        return result;
+    }
+    auto state = std::make_shared<detail::AllState<T>>(result, promises.size());
+    for (size_t i = 0; i < promises.size(); ++i) {
+        promises[i]->subscribe(state, i);
+    }
+    return result;
+}
+
+template<typename T>
+std::shared_ptr<Promise<std::vector<PromiseSettledResult<T>>>> Promise<T>::allSettled(const std::vector<std::shared_ptr<Promise<T>>>& promises) {
+    auto result = std::make_shared<Promise<std::vector<PromiseSettledResult<T>>>>();
+    if (promises.empty()) {
+        result->resolveWith(std::vector<PromiseSettledResult<T>>{});
+        return result;
+    }
+    auto state = std::make_shared<detail::AllSettledState<T>>(result, promises.size());
+    for (size_t i = 0; i < promises.size(); ++i) {
+        promises[i]->subscribe(state, i);
+    }
+    return result;
+}
+
+template<typename T>
+std::shared_ptr<Promise<T>> Promise<T>::any(const std::vector<std::shared_ptr<Promise<T>>>& promises) {
+    auto result = std::make_shared<Promise<T>>();
+    if (promises.empty()) {
+        result->rejectWith(detail::aggregateRejection({}));
+        return result;
+    }
+    auto state = std::make_shared<detail::AnyState<T>>(result, promises.size());
+    for (size_t i = 0; i < promises.size(); ++i) {
+        promises[i]->subscribe(state, i);
+    }
+    return result;
+}
+
+template<typename T>
+std::shared_ptr<Promise<T>> Promise<T>::race(const std::vector<std::shared_ptr<Promise<T>>>& promises) {
+    auto result = std::make_shared<Promise<T>>();
+    auto state = std::make_shared<detail::RaceState<T>>(result);
+    for (size_t i = 0; i < promises.size(); ++i) {
+        promises[i]->subscribe(state, i);
+    }
+    return result;
+}
+
+inline std::shared_ptr<Promise<void>> Promise<void>::all(const std::vector<std::shared_ptr<Promise<void>>>& promises) {
+    auto result = std::make_shared<Promise<void>>();
+    if (promises.empty()) {
+        result->resolveWith();
+        return result;
+    }
+    auto state = std::make_shared<detail::AllState<void>>(result, promises.size());
+    for (size_t i = 0; i < promises.size(); ++i) {
+        promises[i]->subscribe(state, i);
+    }
+    return result;
+}
+
+inline std::shared_ptr<Promise<std::vector<PromiseSettledResult<void>>>> Promise<void>::allSettled(const std::vector<std::shared_ptr<Promise<void>>>& promises) {
+    auto result = std::make_shared<Promise<std::vector<PromiseSettledResult<void>>>>();
+    if (promises.empty()) {
+        result->resolveWith(std::vector<PromiseSettledResult<void>>{});
+        return result;
+    }
+    auto state = std::make_shared<detail::AllSettledState<void>>(result, promises.size());
+    for (size_t i = 0; i < promises.size(); ++i) {
+        promises[i]->subscribe(state, i);
+    }
+    return result;
+}
+
+inline std::shared_ptr<Promise<void>> Promise<void>::any(const std::vector<std::shared_ptr<Promise<void>>>& promises) {
+    auto result = std::make_shared<Promise<void>>();
+    if (promises.empty()) {
+        result->rejectWith(detail::aggregateRejection({}));
+        return result;
+    }
+    auto state = std::make_shared<detail::AnyState<void>>(result, promises.size());
+    for (size_t i = 0; i < promises.size(); ++i) {
+        promises[i]->subscribe(state, i);
+    }
+    return result;
+}
+
+inline std::shared_ptr<Promise<void>> Promise<void>::race(const std::vector<std::shared_ptr<Promise<void>>>& promises) {
+    auto result = std::make_shared<Promise<void>>();
+    auto state = std::make_shared<detail::RaceState<void>>(result);
+    for (size_t i = 0; i < promises.size(); ++i) {
+        promises[i]->subscribe(state, i);
+    }
+    return result;
+}
+
 // Task - coroutine return type
 template<typename T = void>
 class Task {
 public:
-    struct promise_type {
+    struct promise_type : detail::PooledFrame {
         std::shared_ptr<Promise<T>> promise = std::make_shared<Promise<T>>();
         
         Task get_return_object() {
@@ -316,11 +635,11 @@ public:
         
         template<typename U>
         void return_value(U&& value) {
-            promise->resolve(std::forward<U>(value));
+            promise->resolveWith(std::forward<U>(value));
         }
         
         void unhandled_exception() {
-            promise->reject(std::current_exception());
+            promise->rejectWith(std::current_exception());
         }
     };
     
@@ -356,7 +675,7 @@ private:
 template<>
 class Task<void> {
 public:
-    struct promise_type {
+    struct promise_type : detail::PooledFrame {
         std::shared_ptr<Promise<void>> promise = std::make_shared<Promise<void>>();
         
         Task get_return_object() {
@@ -367,11 +686,11 @@ public:
         std::suspend_never final_suspend() noexcept { return {}; }
         
         void return_void() {
-            promise->resolve();
+            promise->resolveWith();
         }
         
         void unhandled_exception() {
-            promise->reject(std::current_exception());
+            promise->rejectWith(std::current_exception());
         }
     };
     
@@ -401,6 +720,400 @@ private:
     std::shared_ptr<Promise<void>> promise_;
 };
 
+// AsyncGenerator - coroutine return type for `async function*`
+//
+// The body starts suspended and only runs when the consumer awaits next();
+// each co_yield hands the value straight back to the awaiting consumer.
+template<typename T>
+class AsyncGenerator {
+public:
+    struct promise_type;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    // Resume whoever is waiting in next() (symmetric transfer)
+    struct YieldAwaiter {
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(handle_type handle) noexcept {
+            auto consumer = handle.promise().consumer;
+            return consumer ? consumer : std::noop_coroutine();
+        }
+        void await_resume() const noexcept {}
+    };
+
+    struct promise_type : detail::PooledFrame {
+        std::optional<T> current;
+        std::exception_ptr error;
+        std::coroutine_handle<> consumer;
+
+        AsyncGenerator get_return_object() {
+            return AsyncGenerator{handle_type::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        YieldAwaiter final_suspend() noexcept { return {}; }
+
+        template<typename U>
+        YieldAwaiter yield_value(U&& value) {
+            current.emplace(std::forward<U>(value));
+            return {};
+        }
+
+        void return_void() {}
+
+        void unhandled_exception() {
+            error = std::current_exception();
+        }
+    };
+
+    struct NextAwaiter {
+        handle_type handle;
+
+        bool await_ready() const noexcept { return !handle || handle.done(); }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> consumer) {
+            handle.promise().consumer = consumer;
+            handle.promise().current.reset();
+            return handle;
+        }
+
+        IteratorResult<T> await_resume() {
+            if (!handle || handle.done()) {
+                if (handle && handle.promise().error) {
+                    std::rethrow_exception(std::exchange(handle.promise().error, nullptr));
+                }
+                return {};
+            }
+            return {std::move(*handle.promise().current), false};
+        }
+    };
+
+    AsyncGenerator() = default;
+    explicit AsyncGenerator(handle_type handle) : handle_(handle) {}
+    AsyncGenerator(AsyncGenerator&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    AsyncGenerator& operator=(AsyncGenerator&& other) noexcept {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    AsyncGenerator(const AsyncGenerator&) = delete;
+    AsyncGenerator& operator=(const AsyncGenerator&) = delete;
+
+    ~AsyncGenerator() {
+        if (handle_) handle_.destroy();
+    }
+
+    // Resume the body until it yields or finishes
+    NextAwaiter next() { return NextAwaiter{handle_}; }
+
+private:
+    handle_type handle_;
+};
+
+// Bounded async channel
+//
+// send() completes immediately while the buffer has room and suspends the
+// producer once `capacity` values are queued, so a fast producer cannot run
+// ahead of a slow consumer. Copies share the same channel. Waiters are resumed
+// through the event loop; a channel must only be used from the loop thread.
+template<typename T>
+class Channel {
+    struct ReceiveAwaiter;
+    struct SendAwaiter;
+
+    struct State {
+        size_t capacity;
+        bool closed = false;
+        std::deque<T> buffer;
+        std::deque<SendAwaiter*> senders;
+        std::deque<ReceiveAwaiter*> receivers;
+    };
+
+    static void schedule(std::coroutine_handle<> handle) {
+        EventLoop::instance().post([handle] { handle.resume(); });
+    }
+
+    struct SendAwaiter {
+        std::shared_ptr<State> state;
+        T value;
+        std::coroutine_handle<> handle;
+        bool rejected = false;
+
+        bool await_ready() {
+            if (state->closed) {
+                rejected = true;
+                return true;
+            }
+            if (!state->receivers.empty()) {
+                ReceiveAwaiter* receiver = state->receivers.front();
+                state->receivers.pop_front();
+                receiver->result = {std::move(value), false};
+                schedule(receiver->handle);
+                return true;
+            }
+            if (state->buffer.size() < state->capacity) {
+                state->buffer.push_back(std::move(value));
+                return true;
+            }
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> waiting) {
+            handle = waiting;
+            state->senders.push_back(this);
+        }
+
+        void await_resume() {
+            if (rejected) {
+                throw any(Error(string("Cannot send on a closed channel")));
+            }
+        }
+    };
+
+    struct ReceiveAwaiter {
+        std::shared_ptr<State> state;
+        IteratorResult<T> result;
+        std::coroutine_handle<> handle;
+
+        bool await_ready() {
+            if (!state->buffer.empty()) {
+                result = {std::move(state->buffer.front()), false};
+                state->buffer.pop_front();
+                // A slot opened up: admit the longest-waiting producer
+                if (!state->senders.empty()) {
+                    SendAwaiter* sender = state->senders.front();
+                    state->senders.pop_front();
+                    state->buffer.push_back(std::move(sender->value));
+                    schedule(sender->handle);
+                }
+                return true;
+            }
+            if (!state->senders.empty()) {
+                SendAwaiter* sender = state->senders.front();
+                state->senders.pop_front();
+                result = {std::move(sender->value), false};
+                schedule(sender->handle);
+                return true;
+            }
+            return state->closed;
+        }
+
+        void await_suspend(std::coroutine_handle<> waiting) {
+            handle = waiting;
+            state->receivers.push_back(this);
+        }
+
+        IteratorResult<T> await_resume() { return std::move(result); }
+    };
+
+public:
+    explicit Channel(size_t capacity = 16) : state_(std::make_shared<State>()) {
+        state_->capacity = capacity;
+    }
+
+    // Suspends while the buffer is full; throws once the channel is closed
+    SendAwaiter send(T value) { return SendAwaiter{state_, std::move(value), {}}; }
+
+    // Resolves to {value, done: false}, or {done: true} once closed and drained
+    ReceiveAwaiter next() { return ReceiveAwaiter{state_, {}, {}}; }
+    ReceiveAwaiter receive() { return next(); }
+
+    // Stop accepting values; buffered values can still be received
+    void close() {
+        if (state_->closed) return;
+        state_->closed = true;
+        for (ReceiveAwaiter* receiver : state_->receivers) {
+            schedule(receiver->handle);
+        }
+        state_->receivers.clear();
+        for (SendAwaiter* sender : state_->senders) {
+            sender->rejected = true;
+            schedule(sender->handle);
+        }
+        state_->senders.clear();
+    }
+
+    bool closed() const { return state_->closed; }
+    size_t size() const { return state_->buffer.size(); }
+    size_t capacity() const { return state_->capacity; }
+
+private:
+    std::shared_ptr<State> state_;
+};
+
+namespace detail {
+
+template<typename T>
+struct is_shared_promise : std::false_type {};
+
+template<typename T>
+struct is_shared_promise<std::shared_ptr<Promise<T>>> : std::true_type {};
+
+template<typename T>
+struct is_task : std::false_type {};
+
+template<typename T>
+struct is_task<Task<T>> : std::true_type {};
+
+template<typename Source>
+concept AsyncIterator = requires(Source& source) { source.next(); };
+
+// Async iteration over an ordinary range: promise elements are awaited
+template<typename Range>
+class AsyncRangeIterator {
+    using element_type = std::remove_cvref_t<decltype(*std::begin(std::declval<Range&>()))>;
+
+    template<typename E>
+    static auto settledType() {
+        if constexpr (is_shared_promise<E>::value) {
+            return std::type_identity<typename E::element_type::value_type>{};
+        } else {
+            return std::type_identity<E>{};
+        }
+    }
+
+public:
+    using value_type = typename decltype(settledType<element_type>())::type;
+
+    explicit AsyncRangeIterator(Range range)
+        : range_(std::forward<Range>(range)), it_(std::begin(range_)) {}
+
+    Task<IteratorResult<value_type>> next() {
+        if (it_ == std::end(range_)) {
+            co_return IteratorResult<value_type>{};
+        }
+        auto& element = *it_;
+        ++it_;
+        if constexpr (is_shared_promise<element_type>::value) {
+            co_return IteratorResult<value_type>{co_await element, false};
+        } else {
+            co_return IteratorResult<value_type>{element, false};
+        }
+    }
+
+private:
+    Range range_;
+    decltype(std::begin(std::declval<Range&>())) it_;
+};
+
+} // namespace detail
+
+// Adapt the operand of `for await` into something with an awaitable next()
+template<typename Source>
+decltype(auto) async_iter(Source&& source) {
+    if constexpr (detail::AsyncIterator<std::remove_reference_t<Source>>) {
+        if constexpr (std::is_lvalue_reference_v<Source>) {
+            return (source);
+        } else {
+            return std::remove_reference_t<Source>(std::move(source));
+        }
+    } else {
+        return detail::AsyncRangeIterator<Source>(std::forward<Source>(source));
+    }
+}
+
+// Allow `co_await promise` on the shared promises returned by runtime APIs
+template<typename T>
+auto operator co_await(std::shared_ptr<Promise<T>> promise) {
+    struct Awaiter {
+        std::shared_ptr<Promise<T>> promise;
+        bool await_ready() const noexcept { return promise->await_ready(); }
+        void await_suspend(std::coroutine_handle<> handle) { promise->await_suspend(handle); }
+        T await_resume() { return promise->await_resume(); }
+    };
+    return Awaiter{std::move(promise)};
+}
+
+namespace detail {
+
+// Input of a combinator as a shared promise: tasks hand over their promise,
+// plain values become fulfilled promises
+template<typename Input>
+auto asPromise(Input&& input) {
+    using Value = std::remove_cvref_t<Input>;
+    if constexpr (is_shared_promise<Value>::value) {
+        return Value(std::forward<Input>(input));
+    } else if constexpr (is_task<Value>::value) {
+        return input.promise();
+    } else {
+        return Promise<Value>::resolve(std::forward<Input>(input));
+    }
+}
+
+template<typename Input>
+using promise_of_t = decltype(asPromise(std::declval<Input>()));
+
+template<typename Input>
+concept PromiseRange = !is_shared_promise<std::remove_cvref_t<Input>>::value &&
+    !is_task<std::remove_cvref_t<Input>>::value &&
+    requires(Input& input) { std::begin(input); std::end(input); };
+
+// No inputs (`Promise.all([])`): nothing to take the value type from
+inline std::vector<std::shared_ptr<Promise<js::any>>> collectPromises() {
+    return {};
+}
+
+// One array of inputs
+template<PromiseRange Range>
+auto collectPromises(Range&& range) {
+    std::vector<promise_of_t<decltype(*std::begin(range))>> promises;
+    for (auto&& input : range) {
+        promises.push_back(asPromise(input));
+    }
+    return promises;
+}
+
+// The elements of an array literal, passed one by one
+template<typename First, typename... Rest>
+    requires (sizeof...(Rest) > 0 || !PromiseRange<First>)
+auto collectPromises(First&& first, Rest&&... rest) {
+    return std::vector<promise_of_t<First>>{
+        asPromise(std::forward<First>(first)), asPromise(std::forward<Rest>(rest))...};
+}
+
+template<typename Promises>
+using combined_t = typename Promises::value_type::element_type::value_type;
+
+} // namespace detail
+
+// Promise.all / allSettled / any / race for generated code. The inputs are
+// one array of tasks, promises or values, or the elements of an array
+// literal; arrays of results are handed back as js::array.
+template<typename... Inputs>
+auto promise_all(Inputs&&... inputs) {
+    auto promises = detail::collectPromises(std::forward<Inputs>(inputs)...);
+    using T = detail::combined_t<decltype(promises)>;
+    if constexpr (std::is_void_v<T>) {
+        return Promise<void>::all(promises);
+    } else {
+        return Promise<T>::all(promises)->then(
+            [](const std::vector<T>& values) { return array<T>(values); });
+    }
+}
+
+template<typename... Inputs>
+auto promise_all_settled(Inputs&&... inputs) {
+    auto promises = detail::collectPromises(std::forward<Inputs>(inputs)...);
+    using T = detail::combined_t<decltype(promises)>;
+    return Promise<T>::allSettled(promises)->then(
+        [](const std::vector<PromiseSettledResult<T>>& results) {
+            return array<PromiseSettledResult<T>>(results);
+        });
+}
+
+template<typename... Inputs>
+auto promise_any(Inputs&&... inputs) {
+    auto promises = detail::collectPromises(std::forward<Inputs>(inputs)...);
+    return Promise<detail::combined_t<decltype(promises)>>::any(promises);
+}
+
+template<typename... Inputs>
+auto promise_race(Inputs&&... inputs) {
+    auto promises = detail::collectPromises(std::forward<Inputs>(inputs)...);
+    return Promise<detail::combined_t<decltype(promises)>>::race(promises);
+}
+
 } // namespace js
 
 #endif // JS_ASYNC_H
\ No newline at end of file
@@ -1,9 +1,27 @@
 // Runtime implementation file
-// Most functionality is header-only (defined inline in core.h)
-// This file exists for any non-inline implementations if needed in the future
+// Header-only builds need nothing from here. Built with JS_RUNTIME_LIBRARY
+// (the jsruntime target of the generated CMake) this is libjsruntime: the
+// out-of-line parts of runtime/core and the common js::array instantiations,
+// compiled once instead of in every translation unit.
 
 #include "core.h"
 
+#ifdef JS_RUNTIME_LIBRARY
+#include "core/string-inl.h"
+#include "core/any-inl.h"
+#include "core/error-inl.h"
+#include "core/operators-inl.h"
+#include "core/date-inl.h"
+#include "core/global-inl.h"
+#include "core/math-inl.h"
+#include "core/symbol-inl.h"
+#include "core/bigint-inl.h"
+#include "core/object_static-inl.h"
+
+// Instantiations declared extern in core/any.h
 namespace js {
-    // Currently all implementations are inline in the header
-}
\ No newline at end of file
+template class array<any>;
+template class array<number>;
+template class array<string>;
+} // namespace js
+#endif
@@ -0,0 +1,275 @@
+#ifndef JS_CORE_ANY_INL_H
+#define JS_CORE_ANY_INL_H
+
+#include <algorithm>
+#include <any>
+#include <cmath>
+#include <string>
+#include <type_traits>
+#include <variant>
+
+#include "any.h"
+
+namespace js {
+
+JS_RUNTIME_INLINE string any::toString() const {
+    if (is<string>()) return get<string>();
+    if (is<number>()) return get<number>().toString(); // Use number's toString method
+    if (is<bool>()) return string(get<bool>() ? "true" : "false");
+    if (is<null_t>()) return string("null");
+    if (is<undefined_t>()) return string("undefined");
+    return string("[object]");
+}
+
+JS_RUNTIME_INLINE any::operator bool() const {
+    if (is<bool>()) return get<bool>();
+    if (is<number>()) return get<number>().value() != 0.0;
+    if (is<string>()) return !get<string>().empty();
+    if (is<undefined_t>() || is<null_t>()) return false;
+    return true;
+}
+
+JS_RUNTIME_INLINE any any::operator[](const string& key) const {
+    if (is<object>()) {
+        const auto& obj = get<object>();
+        const std::string keyStr = key.value();
+        if (obj.has(keyStr)) {
+            return obj.get_as_js_any(keyStr);
+        }
+    }
+    return undefined;
+}
+
+JS_RUNTIME_INLINE any any::operator[](const number& key) const {
+    if (is<object>()) {
+        const auto& obj = get<object>();
+        // Convert number to JavaScript-style string (integers without decimals)
+        double val = key.value();
+        std::string keyStr;
+        if (val == std::floor(val) && std::isfinite(val)) {
+            // Integer value - convert without decimal
+            keyStr = std::to_string(static_cast<long long>(val));
+        } else {
+            // Floating point value - use standard conversion
+            keyStr = std::to_string(val);
+        }
+        if (obj.has(keyStr)) {
+            return obj.get_as_js_any(keyStr);
+        }
+    }
+    return undefined;
+}
+
+JS_RUNTIME_INLINE any any::slice(int start) const {
+    // If this contains an array, delegate to its slice method
+    if (is<array<any>>()) {
+        return any(get<array<any>>().slice(static_cast<size_t>(std::max(0, start))));
+    }
+    // Return empty array for non-arrays
+    return any(array<any>());
+}
+
+JS_RUNTIME_INLINE any any::slice(int start, int end) const {
+    // If this contains an array, delegate to its slice method
+    if (is<array<any>>()) {
+        return any(get<array<any>>().slice(
+            static_cast<size_t>(std::max(0, start)),
+            static_cast<size_t>(std::max(0, end))
+        ));
+    }
+    // Return empty array for non-arrays
+    return any(array<any>());
+}
+
+JS_RUNTIME_INLINE any any::operator+(const any& other) const {
+    // Number + Number -> Number
+    if (is<number>() && other.is<number>()) {
+        return any(number(get<number>().value() + other.get<number>().value()));
+    }
+    // String + any -> String (concatenation)
+    if (is<string>()) {
+        return any(get<string>() + other.toString());
+    }
+    // any + String -> String (concatenation)
+    if (other.is<string>()) {
+        return any(toString() + other.get<string>());
+    }
+    // Convert both to numbers and add
+    if (is<number>() || other.is<number>()) {
+        double leftVal = is<number>() ? get<number>().value() : 0.0;
+        double rightVal = other.is<number>() ? other.get<number>().value() : 0.0;
+        return any(number(leftVal + rightVal));
+    }
+    return undefined;
+}
+
+JS_RUNTIME_INLINE any any::operator+(const number& other) const {
+    if (is<number>()) {
+        return any(number(get<number>().value() + other.value()));
+    }
+    if (is<string>()) {
+        return any(get<string>() + string(std::to_string(other.value())));
+    }
+    return undefined;
+}
+
+JS_RUNTIME_INLINE any any::operator+(const string& other) const {
+    return any(toString() + other);
+}
+
+JS_RUNTIME_INLINE any any::operator*(const number& other) const {
+    if (is<number>()) {
+        return any(number(get<number>().value() * other.value()));
+    }
+    return undefined;
+}
+
+JS_RUNTIME_INLINE any any::operator/(const number& other) const {
+    if (is<number>()) {
+        return any(number(get<number>().value() / other.value()));
+    }
+    return undefined;
+}
+
+JS_RUNTIME_INLINE any any::operator-(const number& other) const {
+    if (is<number>()) {
+        return any(number(get<number>().value() - other.value()));
+    }
+    return undefined;
+}
+
+JS_RUNTIME_INLINE any any::operator%(const number& other) const {
+    if (is<number>()) {
+        return any(number(std::fmod(get<number>().value(), other.value())));
+    }
+    return undefined;
+}
+
+JS_RUNTIME_INLINE bool any::operator>(const number& other) const {
+    if (is<number>()) {
+        return get<number>().value() > other.value();
+    }
+    return false;
+}
+
+JS_RUNTIME_INLINE bool any::operator<(const number& other) const {
+    if (is<number>()) {
+        return get<number>().value() < other.value();
+    }
+    return false;
+}
+
+JS_RUNTIME_INLINE bool any::operator>=(const number& other) const {
+    if (is<number>()) {
+        return get<number>().value() >= other.value();
+    }
+    return false;
+}
+
+JS_RUNTIME_INLINE bool any::operator<=(const number& other) const {
+    if (is<number>()) {
+        return get<number>().value() <= other.value();
+    }
+    return false;
+}
+
+JS_RUNTIME_INLINE bool any::operator==(const number& other) const {
+    if (is<number>()) {
+        return get<number>().value() == other.value();
+    }
+    return false;
+}
+
+JS_RUNTIME_INLINE bool any::operator!=(const number& other) const {
+    if (is<number>()) {
+        return get<number>().value() != other.value();
+    }
+    return true;
+}
+
+JS_RUNTIME_INLINE bool any::operator==(const any& other) const {
+    // Handle the same type comparisons
+    if (value_.index() == other.value_.index()) {
+        return std::visit([&other](const auto& val) -> bool {
+            using T = std::decay_t<decltype(val)>;
+            if constexpr (std::is_same_v<T, undefined_t> || std::is_same_v<T, null_t> || std::is_same_v<T, bool>) {
+                return val == std::get<T>(other.value_);
+            } else if constexpr (std::is_same_v<T, number>) {
+                return val.value() == std::get<T>(other.value_).value();
+            } else if constexpr (std::is_same_v<T, string>) {
+                return val.value() == std::get<T>(other.value_).value();
+            } else {
+                // For complex types (array, object), just check if they're the same reference
+                // In JavaScript, objects are compared by reference
+                return &val == &std::get<T>(other.value_);
+            }
+        }, value_);
+    }
+    return false; // Different types are not equal
+}
+
+JS_RUNTIME_INLINE bool any::includes(const any& value) const {
+    if (is<array<any>>()) {
+        return get<array<any>>().includes(value);
+    }
+    return false; // Return false for non-arrays
+}
+
+JS_RUNTIME_INLINE string any::join(const string& separator) const {
+    if (is<array<any>>()) {
+        return get<array<any>>().join(separator);
+    }
+    return string(""); // Return empty string for non-arrays
+}
+
+JS_RUNTIME_INLINE object any::as_object() const {
+    if (is<object>()) {
+        return get<object>();
+    }
+    return object(); // Return empty object for non-objects
+}
+
+JS_RUNTIME_INLINE string string::operator+(const any& other) const {
+    return string(value_ + other.toString().value());
+}
+
+JS_RUNTIME_INLINE any object::get_as_js_any(const std::string& key) const {
+    auto it = properties_.find(key);
+    if (it != properties_.end()) {
+        const std::any& stored_value = it->second;
+
+        // Try to cast to various js types and convert to js::any
+        try {
+            if (const auto* val = std::any_cast<string>(&stored_value)) {
+                return any(*val);
+            }
+            if (const auto* val = std::any_cast<number>(&stored_value)) {
+                return any(*val);
+            }
+            if (const auto* val = std::any_cast<bool>(&stored_value)) {
+                return any(*val);
+            }
+            if (const auto* val = std::any_cast<any>(&stored_value)) {
+                return *val;
+            }
+            if (const auto* val = std::any_cast<object>(&stored_value)) {
+                return any(*val);
+            }
+            if (const auto* val = std::any_cast<undefined_t>(&stored_value)) {
+                return any(*val);
+            }
+            if (const auto* val = std::any_cast<null_t>(&stored_value)) {
+                return any(*val);
+            }
+            // Add more type conversions as needed
+            return undefined;
+        } catch (...) {
+            return undefined;
+        }
+    }
+    return undefined;
+}
+
+} // namespace js
+
+#endif // JS_CORE_ANY_INL_H
@@ -0,0 +1,286 @@
+#ifndef JS_CORE_ANY_H
+#define JS_CORE_ANY_H
+
+// js::any, the dynamically typed JavaScript value.
+//
+// This is the base of generated code: it pulls in number, string, array,
+// object and the Error family. Everything else in runtime/core is included
+// on demand.
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "array.h"
+#include "library.h"
+#include "number.h"
+#include "object.h"
+#include "string.h"
+
+namespace js {
+
+class Date;
+class Error;
+
+// Now define the any type after all other types are complete
+class any {
+private:
+    std::variant<
+        undefined_t,
+        null_t,
+        bool,
+        number,
+        string,
+        array<any>,          // Now array<any> is complete
+        object
+    > value_;
+
+public:
+    // Constructors
+    any() : value_(undefined) {}
+    any(const undefined_t& val) : value_(val) {}
+    any(const null_t& val) : value_(val) {}
+    any(bool val) : value_(val) {}
+    any(const number& val) : value_(val) {}
+    any(double val) : value_(number(val)) {}
+    any(int val) : value_(number(val)) {}
+    any(const string& val) : value_(val) {}
+    any(const char* val) : value_(string(val)) {}
+    // Date and Error constructors are defined in date-inl.h and error-inl.h
+    any(const Date& val);
+    any(const Error& val);
+    any(const array<any>& val) : value_(val) {}
+    any(const object& val) : value_(val) {}
+
+    // Support for typed arrays (converts array<T> to array<any>)
+    template<typename T>
+    any(const array<T>& val) {
+        array<any> converted;
+        for (size_t i = 0; i < val.length(); i++) {
+            converted.push(any(val[i]));
+        }
+        value_ = converted;
+    }
+
+    // Copy and move constructors
+    any(const any& other) = default;
+    any(any&& other) = default;
+    any& operator=(const any& other) = default;
+    any& operator=(any&& other) = default;
+
+    // Type checking
+    template<typename T>
+    bool is() const {
+        return std::holds_alternative<T>(value_);
+    }
+
+    // Helper methods for null and undefined checks
+    bool is_null() const {
+        return std::holds_alternative<null_t>(value_);
+    }
+
+    bool is_undefined() const {
+        return std::holds_alternative<undefined_t>(value_);
+    }
+
+    // Value access
+    template<typename T>
+    T get() const {
+        return std::get<T>(value_);
+    }
+
+    template<typename T>
+    T as() const {
+        return get<T>();
+    }
+
+    // Convert to string for concatenation
+    string toString() const;
+
+    // Conversion operators
+    explicit operator bool() const;
+
+    // Get variant for direct access when needed
+    const auto& variant() const { return value_; }
+    auto& variant() { return value_; }
+
+    // Property access for objects
+    any operator[](const string& key) const;
+
+    // Property access for objects with numeric keys
+    any operator[](const number& key) const;
+
+    // Property access for objects with integer keys (common case)
+    any operator[](int key) const {
+        return (*this)[number(key)];
+    }
+
+    // Slice method for array destructuring rest elements
+    any slice(int start = 0) const;
+    any slice(int start, int end) const;
+
+    // Arithmetic operators for JavaScript-like operations
+    any operator+(const any& other) const;
+    any operator+(const number& other) const;
+    any operator+(const string& other) const;
+
+    // Arithmetic operators with numbers
+    any operator*(const number& other) const;
+    any operator/(const number& other) const;
+    any operator-(const number& other) const;
+    any operator%(const number& other) const;
+
+    // Comparison operators
+    bool operator>(const number& other) const;
+    bool operator<(const number& other) const;
+    bool operator>=(const number& other) const;
+    bool operator<=(const number& other) const;
+    bool operator==(const number& other) const;
+    bool operator!=(const number& other) const;
+
+    // Equality operators for any-to-any comparison
+    bool operator==(const any& other) const;
+
+    bool operator!=(const any& other) const {
+        return !(*this == other);
+    }
+
+    // Property assignment for objects - this method should not be used directly
+    // Use explicit assignment through the object reference instead
+
+    // Array methods - delegate to underlying array if this contains an array
+    template<typename Func>
+    auto map(Func&& func) const {
+        if (is<array<any>>()) {
+            return get<array<any>>().map(std::forward<Func>(func));
+        }
+        return array<any>(); // Return empty array for non-arrays
+    }
+
+    template<typename Func>
+    auto filter(Func&& func) const {
+        if (is<array<any>>()) {
+            return get<array<any>>().filter(std::forward<Func>(func));
+        }
+        return array<any>(); // Return empty array for non-arrays
+    }
+
+    template<typename Func, typename Init>
+    auto reduce(Func&& func, Init&& init) const {
+        if (is<array<any>>()) {
+            return get<array<any>>().reduce(std::forward<Func>(func), std::forward<Init>(init));
+        }
+        return init; // Return initial value for non-arrays
+    }
+
+    template<typename Func>
+    void forEach(Func&& func) const {
+        if (is<array<any>>()) {
+            get<array<any>>().forEach(std::forward<Func>(func));
+        }
+    }
+
+    template<typename Func>
+    any find(Func&& func) const {
+        if (is<array<any>>()) {
+            return get<array<any>>().find(std::forward<Func>(func));
+        }
+        return undefined; // Return undefined for non-arrays
+    }
+
+    template<typename Func>
+    number findIndex(Func&& func) const {
+        if (is<array<any>>()) {
+            return number(get<array<any>>().findIndex(std::forward<Func>(func)));
+        }
+        return number(-1); // Return -1 for non-arrays
+    }
+
+    template<typename Func>
+    bool some(Func&& func) const {
+        if (is<array<any>>()) {
+            return get<array<any>>().some(std::forward<Func>(func));
+        }
+        return false; // Return false for non-arrays
+    }
+
+    template<typename Func>
+    bool every(Func&& func) const {
+        if (is<array<any>>()) {
+            return get<array<any>>().every(std::forward<Func>(func));
+        }
+        return true; // Return true for non-arrays (vacuous truth)
+    }
+
+    bool includes(const any& value) const;
+
+    string join(const string& separator = string(",")) const;
+
+    // As object for iteration
+    object as_object() const;
+};
+
+// Typedef for array<any>
+using array_any = array<any>;
+
+inline string toString(const any& a) { return a.toString(); }
+
+// Stream operator for console.log support with js::any
+inline std::ostream& operator<<(std::ostream& os, const js::any& value) {
+    return os << value.toString();
+}
+
+// Non-const version that allows assignment
+class object_property_proxy {
+private:
+    object& obj_;
+    std::string key_;
+public:
+    object_property_proxy(object& obj, const std::string& key) : obj_(obj), key_(key) {}
+
+    operator any() const {
+        return obj_.get_as_js_any(key_);
+    }
+
+    template<typename T>
+    object_property_proxy& operator=(const T& value) {
+        obj_.set(key_, value);
+        return *this;
+    }
+
+    template<typename T>
+    T as() const {
+        return obj_.get_as_js_any(key_).as<T>();
+    }
+};
+
+// Subscript operators for js::string that return js::any (for typed_wrappers.h)
+inline any object::operator[](const string& key) const {
+    return get_as_js_any(key.value());
+}
+
+inline object_property_proxy object::operator[](const string& key) {
+    return object_property_proxy(*this, key.value());
+}
+
+#if defined(JS_RUNTIME_LIBRARY) && !defined(JS_RUNTIME_MODULE)
+// The arrays generated code uses most are instantiated once, in core.cpp
+// (js.runtime.cppm cannot export explicit instantiations)
+extern template class array<any>;
+extern template class array<number>;
+extern template class array<string>;
+#endif
+
+} // namespace js
+
+#ifndef JS_RUNTIME_LIBRARY
+#include "any-inl.h"
+#endif
+
+// Errors are values generated code throws and stores in js::any
+#include "error.h"
+
+#endif // JS_CORE_ANY_H
@@ -0,0 +1,211 @@
+#ifndef JS_CORE_ARRAY_H
+#define JS_CORE_ARRAY_H
+
+// js::array<T>, backed by a std::pmr::vector from js::current_resource()
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory_resource>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../memory_resource.h"
+#include "string.h"
+
+namespace js {
+
+// Simple array class (will be specialized for any later)
+template<typename T>
+class array {
+private:
+    // Element buffer comes from js::current_resource() at construction
+    using storage_type = std::pmr::vector<T>;
+    storage_type elements_;
+    JS_TRACK_INSTANCES(array)
+
+public:
+    array() : elements_(current_resource()) {}
+    array(const std::vector<T>& elements)
+        : elements_(elements.begin(), elements.end(), current_resource()) {}
+    array(std::initializer_list<T> init) : elements_(init, current_resource()) {}
+    array(const array& other) : elements_(other.elements_, current_resource()) {}
+    array(array&&) = default;
+    array& operator=(const array&) = default;
+    array& operator=(array&&) = default;
+
+    // Basic array operations
+    size_t length() const { return elements_.size(); }
+    size_t size() const { return elements_.size(); }
+    bool empty() const { return elements_.empty(); }
+
+    // JavaScript array methods
+    string join(const string& separator = string(",")) const {
+        if (elements_.empty()) return string("");
+
+        std::ostringstream result;
+        for (size_t i = 0; i < elements_.size(); ++i) {
+            if (i > 0) result << separator.value();
+            if constexpr (std::is_same_v<T, string>) {
+                result << elements_[i].value();
+            } else if constexpr (std::is_same_v<T, number>) {
+                result << elements_[i].value();
+            } else {
+                result << toString(elements_[i]).value();
+            }
+        }
+        return string(result.str());
+    }
+
+    T& operator[](size_t index) { return elements_[index]; }
+    const T& operator[](size_t index) const { return elements_[index]; }
+
+    void push(const T& value) { elements_.push_back(value); }
+    T pop() {
+        T result = elements_.back();
+        elements_.pop_back();
+        return result;
+    }
+
+    // Concat method for spread operations
+    array<T> concat(const array<T>& other) const {
+        array<T> result = *this;
+        for (const auto& elem : other.elements_) {
+            result.push(elem);
+        }
+        return result;
+    }
+
+    // Concat with single element (for [1, ...arr, 2] patterns)
+    array<T> concat(const T& elem) const {
+        array<T> result = *this;
+        result.push(elem);
+        return result;
+    }
+
+    // Iterators
+    typename storage_type::iterator begin() { return elements_.begin(); }
+    typename storage_type::iterator end() { return elements_.end(); }
+    typename storage_type::const_iterator begin() const { return elements_.begin(); }
+    typename storage_type::const_iterator end() const { return elements_.end(); }
+
+    // Higher-order functions
+    template<typename Func>
+    auto map(Func&& func) const -> array<decltype(func(std::declval<T>()))> {
+        using ResultType = decltype(func(std::declval<T>()));
+        array<ResultType> result;
+        for (const auto& elem : elements_) {
+            result.push(func(elem));
+        }
+        return result;
+    }
+
+    template<typename Func>
+    array<T> filter(Func&& func) const {
+        array<T> result;
+        for (const auto& elem : elements_) {
+            if (func(elem)) {
+                result.push(elem);
+            }
+        }
+        return result;
+    }
+
+    template<typename Func, typename Init>
+    auto reduce(Func&& func, Init&& init) const -> decltype(func(std::declval<Init>(), std::declval<T>())) {
+        auto result = init;
+        for (const auto& elem : elements_) {
+            result = func(result, elem);
+        }
+        return result;
+    }
+
+    // Slice method for array destructuring rest elements
+    array<T> slice(size_t start = 0) const {
+        if (start >= elements_.size()) {
+            return array<T>();
+        }
+        std::vector<T> sliced(elements_.begin() + start, elements_.end());
+        return array<T>(sliced);
+    }
+
+    array<T> slice(size_t start, size_t end) const {
+        if (start >= elements_.size()) {
+            return array<T>();
+        }
+        size_t actualEnd = std::min(end, elements_.size());
+        if (start >= actualEnd) {
+            return array<T>();
+        }
+        std::vector<T> sliced(elements_.begin() + start, elements_.begin() + actualEnd);
+        return array<T>(sliced);
+    }
+
+    // forEach method - executes a function for each element
+    template<typename Func>
+    void forEach(Func&& func) const {
+        for (const auto& elem : elements_) {
+            func(elem);
+        }
+    }
+
+    // find method - returns first element that satisfies the predicate
+    template<typename Func>
+    T find(Func&& func) const {
+        for (const auto& elem : elements_) {
+            if (func(elem)) {
+                return elem;
+            }
+        }
+        return T(); // Return default value if not found
+    }
+
+    // findIndex method - returns index of first element that satisfies the predicate
+    template<typename Func>
+    int findIndex(Func&& func) const {
+        for (size_t i = 0; i < elements_.size(); ++i) {
+            if (func(elements_[i])) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1; // Return -1 if not found
+    }
+
+    // some method - tests whether at least one element passes the test
+    template<typename Func>
+    bool some(Func&& func) const {
+        for (const auto& elem : elements_) {
+            if (func(elem)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // every method - tests whether all elements pass the test
+    template<typename Func>
+    bool every(Func&& func) const {
+        for (const auto& elem : elements_) {
+            if (!func(elem)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // includes method - checks if array includes a certain value
+    bool includes(const T& value) const {
+        for (const auto& elem : elements_) {
+            if (elem == value) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+} // namespace js
+
+#endif // JS_CORE_ARRAY_H
@@ -0,0 +1,103 @@
+#ifndef JS_CORE_BIGINT_H
+#define JS_CORE_BIGINT_H
+
+// BigInt (decimal digits plus sign)
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include "library.h"
+#include "string.h"
+
+namespace js {
+
+// BigInt class for JavaScript BigInt support
+class bigint {
+private:
+    std::string value;
+    bool negative;
+
+    void normalize();
+
+public:
+    // Constructors
+    bigint() : value("0"), negative(false) {}
+
+    bigint(int64_t n) {
+        negative = n < 0;
+        value = std::to_string(negative ? -n : n);
+    }
+
+    bigint(const string& str) : bigint(str.value()) {}
+
+    bigint(const std::string& str);
+
+    bigint(const char* str) : bigint(std::string(str)) {}
+
+    // String conversion
+    string toString() const {
+        return string(toStdString());
+    }
+
+    std::string toStdString() const {
+        return (negative && value != "0") ? "-" + value : value;
+    }
+
+    // Basic arithmetic operators (simplified implementation for demonstration)
+    // Note: A production implementation would need proper arbitrary precision arithmetic
+    bigint operator+(const bigint& other) const;
+    bigint operator-(const bigint& other) const;
+    bigint operator*(const bigint& other) const;
+    bigint operator/(const bigint& other) const;
+    bigint operator%(const bigint& other) const;
+
+    // Comparison operators
+    bool operator==(const bigint& other) const {
+        return negative == other.negative && value == other.value;
+    }
+
+    bool operator!=(const bigint& other) const {
+        return !(*this == other);
+    }
+
+    bool operator<(const bigint& other) const;
+
+    bool operator>(const bigint& other) const {
+        return other < *this;
+    }
+
+    bool operator<=(const bigint& other) const {
+        return !(*this > other);
+    }
+
+    bool operator>=(const bigint& other) const {
+        return !(*this < other);
+    }
+
+    // Static methods
+    static bigint asIntN(size_t /*bits*/, const bigint& value) {
+        // Simplified implementation - would need proper bit manipulation
+        return value;
+    }
+
+    static bigint asUintN(size_t /*bits*/, const bigint& value) {
+        // Simplified implementation - would need proper bit manipulation
+        return value;
+    }
+
+    // Output stream operator
+    friend std::ostream& operator<<(std::ostream& os, const bigint& bi) {
+        os << bi.toStdString();
+        return os;
+    }
+};
+
+} // namespace js
+
+#ifndef JS_RUNTIME_LIBRARY
+#include "bigint-inl.h"
+#endif
+
+#endif // JS_CORE_BIGINT_H
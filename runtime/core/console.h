@@ -0,0 +1,35 @@
+#ifndef JS_CORE_CONSOLE_H
+#define JS_CORE_CONSOLE_H
+
+// console.log / console.error
+
+#include <iostream>
+
+namespace js {
+
+// Console class
+class Console {
+public:
+    template<typename... Args>
+    void log(Args&&... args) {
+        if constexpr (sizeof...(args) == 1) {
+            ((std::cout << args), ...);
+        } else {
+            ((std::cout << args << " "), ...);
+        }
+        std::cout << std::endl;
+    }
+
+    template<typename... Args>
+    void error(Args&&... args) {
+        ((std::cerr << args << " "), ...);
+        std::cerr << std::endl;
+    }
+};
+
+// Global console instance
+inline Console console;
+
+} // namespace js
+
+#endif // JS_CORE_CONSOLE_H
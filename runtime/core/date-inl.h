@@ -0,0 +1,116 @@
+#ifndef JS_CORE_DATE_INL_H
+#define JS_CORE_DATE_INL_H
+
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+#include "date.h"
+
+namespace js {
+
+JS_RUNTIME_INLINE Date::Date(number milliseconds) {
+    auto duration = std::chrono::milliseconds(static_cast<long long>(milliseconds.value()));
+    timePoint = std::chrono::system_clock::time_point(duration);
+}
+
+JS_RUNTIME_INLINE Date::Date(number year, number month, number day, number hours,
+                             number minutes, number seconds, number milliseconds) {
+    std::tm tm = {};
+    tm.tm_year = static_cast<int>(year.value()) - 1900;
+    tm.tm_mon = static_cast<int>(month.value()); // JavaScript month is 0-based
+    tm.tm_mday = static_cast<int>(day.value());
+    tm.tm_hour = static_cast<int>(hours.value());
+    tm.tm_min = static_cast<int>(minutes.value());
+    tm.tm_sec = static_cast<int>(seconds.value());
+
+    auto time_t_val = std::mktime(&tm);
+    timePoint = std::chrono::system_clock::from_time_t(time_t_val);
+
+    // Add milliseconds
+    timePoint += std::chrono::milliseconds(static_cast<int>(milliseconds.value()));
+}
+
+JS_RUNTIME_INLINE Date::Date(const string& dateString) {
+    // Simple ISO 8601 parsing - could be enhanced
+    std::istringstream ss(dateString.value());
+    std::tm tm = {};
+
+    // Try to parse ISO format: YYYY-MM-DDTHH:MM:SS
+    if (!(ss >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%S"))) {
+        // Fallback to simpler format: YYYY-MM-DD
+        ss.clear();
+        ss.str(dateString.value());
+        if (!(ss >> std::get_time(&tm, "%Y-%m-%d"))) {
+            // If parsing fails, use current time
+            timePoint = std::chrono::system_clock::now();
+            return;
+        }
+    }
+
+    auto time_t_val = std::mktime(&tm);
+    timePoint = std::chrono::system_clock::from_time_t(time_t_val);
+}
+
+JS_RUNTIME_INLINE number Date::getFullYear() const {
+    auto time_t_val = std::chrono::system_clock::to_time_t(timePoint);
+    auto tm = *std::localtime(&time_t_val);
+    return number(tm.tm_year + 1900);
+}
+
+JS_RUNTIME_INLINE number Date::getMonth() const {
+    auto time_t_val = std::chrono::system_clock::to_time_t(timePoint);
+    auto tm = *std::localtime(&time_t_val);
+    return number(tm.tm_mon); // JavaScript months are 0-based
+}
+
+JS_RUNTIME_INLINE number Date::getDate() const {
+    auto time_t_val = std::chrono::system_clock::to_time_t(timePoint);
+    auto tm = *std::localtime(&time_t_val);
+    return number(tm.tm_mday);
+}
+
+JS_RUNTIME_INLINE number Date::getHours() const {
+    auto time_t_val = std::chrono::system_clock::to_time_t(timePoint);
+    auto tm = *std::localtime(&time_t_val);
+    return number(tm.tm_hour);
+}
+
+JS_RUNTIME_INLINE number Date::getMinutes() const {
+    auto time_t_val = std::chrono::system_clock::to_time_t(timePoint);
+    auto tm = *std::localtime(&time_t_val);
+    return number(tm.tm_min);
+}
+
+JS_RUNTIME_INLINE number Date::getSeconds() const {
+    auto time_t_val = std::chrono::system_clock::to_time_t(timePoint);
+    auto tm = *std::localtime(&time_t_val);
+    return number(tm.tm_sec);
+}
+
+JS_RUNTIME_INLINE string Date::toString() const {
+    auto time_t_val = std::chrono::system_clock::to_time_t(timePoint);
+    auto tm = *std::localtime(&time_t_val);
+
+    char buffer[100];
+    std::strftime(buffer, sizeof(buffer), "%a %b %d %Y %H:%M:%S", &tm);
+    return string(buffer);
+}
+
+JS_RUNTIME_INLINE number Date::getTime() const {
+    auto duration = timePoint.time_since_epoch();
+    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+    return number(static_cast<double>(millis.count()));
+}
+
+JS_RUNTIME_INLINE any::any(const Date& val) {
+    object obj;
+    obj.set("_type", string("Date"));
+    obj.set("_value", number(static_cast<double>(val.getTime())));
+    value_ = obj;
+}
+
+} // namespace js
+
+#endif // JS_CORE_DATE_INL_H
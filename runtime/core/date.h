@@ -0,0 +1,55 @@
+#ifndef JS_CORE_DATE_H
+#define JS_CORE_DATE_H
+
+// Date, on top of std::chrono::system_clock
+
+#include <chrono>
+
+#include "any.h"
+#include "library.h"
+#include "number.h"
+#include "string.h"
+
+namespace js {
+
+// Date class for JavaScript Date support
+class Date {
+private:
+    std::chrono::system_clock::time_point timePoint;
+
+public:
+    // Default constructor - current time
+    Date() : timePoint(std::chrono::system_clock::now()) {}
+
+    // Constructor from milliseconds since epoch
+    Date(number milliseconds);
+
+    // Constructor from year, month, day, etc.
+    Date(number year, number month, number day = number(1), number hours = number(0),
+         number minutes = number(0), number seconds = number(0), number milliseconds = number(0));
+
+    // Constructor from string (basic parsing)
+    Date(const string& dateString);
+
+    // Get components
+    number getFullYear() const;
+    number getMonth() const;
+    number getDate() const;
+    number getHours() const;
+    number getMinutes() const;
+    number getSeconds() const;
+
+    // toString method
+    string toString() const;
+
+    // getTime method - returns milliseconds since epoch
+    number getTime() const;
+};
+
+} // namespace js
+
+#ifndef JS_RUNTIME_LIBRARY
+#include "date-inl.h"
+#endif
+
+#endif // JS_CORE_DATE_H
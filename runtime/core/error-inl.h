@@ -0,0 +1,24 @@
+#ifndef JS_CORE_ERROR_INL_H
+#define JS_CORE_ERROR_INL_H
+
+#include "error.h"
+
+namespace js {
+
+JS_RUNTIME_INLINE string Error::toString() const {
+    if (message_.empty()) {
+        return name_;
+    }
+    return name_ + string(": ") + message_;
+}
+
+JS_RUNTIME_INLINE any::any(const Error& val) {
+    object obj;
+    obj.set("_type", string("Error"));
+    obj.set("message", val.getMessage());
+    value_ = obj;
+}
+
+} // namespace js
+
+#endif // JS_CORE_ERROR_INL_H
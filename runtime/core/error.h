@@ -0,0 +1,63 @@
+#ifndef JS_CORE_ERROR_H
+#define JS_CORE_ERROR_H
+
+// Error, EvalError, URIError and AggregateError
+
+#include <vector>
+
+#include "any.h"
+#include "library.h"
+#include "string.h"
+
+namespace js {
+
+// Error class for JavaScript Error support
+class Error {
+private:
+    string message_;
+    string name_;
+
+public:
+    Error() : message_(""), name_("Error") {}
+    Error(const string& message) : message_(message), name_("Error") {}
+    Error(const string& message, const string& name) : message_(message), name_(name) {}
+
+    const string& getMessage() const { return message_; }
+    const string& getName() const { return name_; }
+
+    string toString() const;
+};
+
+// EvalError class for JavaScript EvalError support
+class EvalError : public Error {
+public:
+    EvalError() : Error("", "EvalError") {}
+    EvalError(const string& message) : Error(message, "EvalError") {}
+};
+
+// URIError class for JavaScript URIError support
+class URIError : public Error {
+public:
+    URIError() : Error("", "URIError") {}
+    URIError(const string& message) : Error(message, "URIError") {}
+};
+
+// AggregateError class for JavaScript AggregateError support
+class AggregateError : public Error {
+private:
+    std::vector<any> errors_;
+public:
+    AggregateError() : Error("", "AggregateError") {}
+    AggregateError(const std::vector<any>& errors, const string& message = "")
+        : Error(message, "AggregateError"), errors_(errors) {}
+
+    const std::vector<any>& getErrors() const { return errors_; }
+};
+
+} // namespace js
+
+#ifndef JS_RUNTIME_LIBRARY
+#include "error-inl.h"
+#endif
+
+#endif // JS_CORE_ERROR_H
@@ -0,0 +1,133 @@
+#ifndef JS_CORE_FUNCTION_H
+#define JS_CORE_FUNCTION_H
+
+// js::function, a type-erased callable over js::any arguments
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "any.h"
+
+namespace js {
+
+// Function wrapper for JavaScript function callbacks
+class function {
+public:
+    virtual ~function() = default;
+
+    // Virtual methods for different call patterns
+    virtual any invoke(std::initializer_list<any> args) = 0;
+    virtual any invoke(const std::vector<any>& args) = 0;
+
+    // Template operator() for direct calls
+    template <typename... Args>
+    any operator()(Args&&... args) {
+        std::vector<any> arg_vec;
+        arg_vec.reserve(sizeof...(args));
+        (arg_vec.emplace_back(std::forward<Args>(args)), ...);
+        return invoke(arg_vec);
+    }
+
+    // Call method (JavaScript function.call equivalent)
+    template <typename ThisType, typename... Args>
+    any call(ThisType&& /*thisArg*/, Args&&... args) {
+        // For now, ignore thisArg in simplified implementation
+        return operator()(std::forward<Args>(args)...);
+    }
+
+    // Apply method (JavaScript function.apply equivalent)
+    any apply(const any& /*thisArg*/, const std::vector<any>& args) {
+        // For now, ignore thisArg in simplified implementation
+        return invoke(args);
+    }
+};
+
+// Template implementation for specific function types
+template <typename F>
+class function_impl : public function {
+private:
+    F func;
+
+    // Helper to detect function signature
+    template<typename T>
+    struct function_traits;
+
+    template<typename R, typename... Args>
+    struct function_traits<R(Args...)> {
+        using return_type = R;
+        using args_tuple = std::tuple<Args...>;
+        static constexpr size_t arity = sizeof...(Args);
+    };
+
+    template<typename R, typename... Args>
+    struct function_traits<R(*)(Args...)> : function_traits<R(Args...)> {};
+
+    template<typename R, typename C, typename... Args>
+    struct function_traits<R(C::*)(Args...)> : function_traits<R(Args...)> {};
+
+    template<typename R, typename C, typename... Args>
+    struct function_traits<R(C::*)(Args...) const> : function_traits<R(Args...)> {};
+
+public:
+    explicit function_impl(F f) : func(std::move(f)) {}
+
+    any invoke(std::initializer_list<any> args) override {
+        std::vector<any> arg_vec(args);
+        return invoke(arg_vec);
+    }
+
+    any invoke(const std::vector<any>& args) override {
+        return invoke_helper(args, std::make_index_sequence<function_traits<F>::arity>{});
+    }
+
+private:
+    template<size_t... Is>
+    any invoke_helper(const std::vector<any>& args, std::index_sequence<Is...>) {
+        // Simplified argument conversion - in practice would need proper type conversion
+        if constexpr (std::is_void_v<typename function_traits<F>::return_type>) {
+            if constexpr (function_traits<F>::arity == 0) {
+                func();
+            } else {
+                func(get_arg<Is>(args)...);
+            }
+            return any(); // undefined for void functions
+        } else {
+            if constexpr (function_traits<F>::arity == 0) {
+                return any(func());
+            } else {
+                return any(func(get_arg<Is>(args)...));
+            }
+        }
+    }
+
+    template<size_t I>
+    auto get_arg(const std::vector<any>& args) {
+        if (I < args.size()) {
+            // Simplified - would need proper type conversion based on target type
+            return args[I];
+        } else {
+            return any(); // undefined for missing arguments
+        }
+    }
+};
+
+// Factory function to create function wrappers
+template<typename F>
+std::shared_ptr<function> make_function(F&& f) {
+    return std::make_shared<function_impl<std::decay_t<F>>>(std::forward<F>(f));
+}
+
+// Lambda wrapper for convenience
+template<typename F>
+std::shared_ptr<function> lambda(F&& f) {
+    return make_function(std::forward<F>(f));
+}
+
+} // namespace js
+
+#endif // JS_CORE_FUNCTION_H
@@ -0,0 +1,120 @@
+#ifndef JS_CORE_GLOBAL_INL_H
+#define JS_CORE_GLOBAL_INL_H
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string>
+
+#include "global.h"
+
+namespace js {
+
+JS_RUNTIME_INLINE number parseInt(const string& str) {
+    try {
+        double result = std::stod(str.value());
+        return number(std::trunc(result)); // parseInt truncates to integer
+    } catch (...) {
+        return number(std::numeric_limits<double>::quiet_NaN());
+    }
+}
+
+JS_RUNTIME_INLINE number parseFloat(const string& str) {
+    try {
+        return number(std::stod(str.value()));
+    } catch (...) {
+        return number(std::numeric_limits<double>::quiet_NaN());
+    }
+}
+
+JS_RUNTIME_INLINE string encodeURI(const string& uri) {
+    std::string result;
+    std::string str = uri.std();
+    for (size_t i = 0; i < str.length(); ++i) {
+        unsigned char c = str[i];
+        // Characters that don't need encoding (RFC 3986 unreserved + reserved)
+        if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+            (c >= '0' && c <= '9') || c == '-' || c == '_' || c == '.' || c == '~' ||
+            c == '!' || c == '#' || c == '$' || c == '&' || c == '\'' || c == '(' ||
+            c == ')' || c == '*' || c == '+' || c == ',' || c == '/' || c == ':' ||
+            c == ';' || c == '=' || c == '?' || c == '@' || c == '[' || c == ']') {
+            result += c;
+        } else {
+            // Encode as %XX
+            char hex[4];
+            snprintf(hex, sizeof(hex), "%%%02X", c);
+            result += hex;
+        }
+    }
+    return string(result);
+}
+
+JS_RUNTIME_INLINE string decodeURI(const string& uri) {
+    std::string result;
+    std::string str = uri.std();
+    for (size_t i = 0; i < str.length(); ++i) {
+        if (str[i] == '%' && i + 2 < str.length()) {
+            // Decode %XX
+            char hex[3] = { str[i + 1], str[i + 2], '\0' };
+            char* end;
+            long val = strtol(hex, &end, 16);
+            if (end == hex + 2) {
+                result += static_cast<char>(val);
+                i += 2;
+            } else {
+                // Invalid hex sequence, keep as-is
+                result += str[i];
+            }
+        } else {
+            result += str[i];
+        }
+    }
+    return string(result);
+}
+
+JS_RUNTIME_INLINE string encodeURIComponent(const string& component) {
+    std::string result;
+    std::string str = component.std();
+    for (size_t i = 0; i < str.length(); ++i) {
+        unsigned char c = str[i];
+        // Characters that don't need encoding (RFC 3986 unreserved only)
+        if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+            (c >= '0' && c <= '9') || c == '-' || c == '_' || c == '.' || c == '~') {
+            result += c;
+        } else {
+            // Encode as %XX
+            char hex[4];
+            snprintf(hex, sizeof(hex), "%%%02X", c);
+            result += hex;
+        }
+    }
+    return string(result);
+}
+
+JS_RUNTIME_INLINE string decodeURIComponent(const string& component) {
+    std::string result;
+    std::string str = component.std();
+    for (size_t i = 0; i < str.length(); ++i) {
+        if (str[i] == '%' && i + 2 < str.length()) {
+            // Decode %XX
+            char hex[3] = { str[i + 1], str[i + 2], '\0' };
+            char* end;
+            long val = strtol(hex, &end, 16);
+            if (end == hex + 2) {
+                result += static_cast<char>(val);
+                i += 2;
+            } else {
+                // Invalid hex sequence, keep as-is
+                result += str[i];
+            }
+        } else {
+            result += str[i];
+        }
+    }
+    return string(result);
+}
+
+} // namespace js
+
+#endif // JS_CORE_GLOBAL_INL_H
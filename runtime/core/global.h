@@ -0,0 +1,28 @@
+#ifndef JS_CORE_GLOBAL_H
+#define JS_CORE_GLOBAL_H
+
+// Global functions: parseInt, parseFloat and the URI encoders
+
+#include "library.h"
+#include "number.h"
+#include "string.h"
+
+namespace js {
+
+// Global JavaScript functions
+number parseInt(const string& str);
+number parseFloat(const string& str);
+
+// URL encoding/decoding global functions
+string encodeURI(const string& uri);
+string decodeURI(const string& uri);
+string encodeURIComponent(const string& component);
+string decodeURIComponent(const string& component);
+
+} // namespace js
+
+#ifndef JS_RUNTIME_LIBRARY
+#include "global-inl.h"
+#endif
+
+#endif // JS_CORE_GLOBAL_H
@@ -0,0 +1,22 @@
+#ifndef JS_CORE_LIBRARY_H
+#define JS_CORE_LIBRARY_H
+
+// Header-only or prebuilt runtime.
+//
+// The non-template parts of runtime/core (Date, Math, symbol, bigint, the
+// bodies of js::any and friends) live in the *-inl.h files next to their
+// headers. By default each header pulls its -inl.h in and the definitions
+// are inline, so including a header is all a program needs.
+//
+// Built with JS_RUNTIME_LIBRARY, the headers only declare those functions and
+// runtime/core.cpp compiles the -inl.h files once into libjsruntime. Every
+// translation unit of a program has to agree on the macro; the generated
+// CMake sets it on the jsruntime target as a public definition.
+
+#ifdef JS_RUNTIME_LIBRARY
+#define JS_RUNTIME_INLINE
+#else
+#define JS_RUNTIME_INLINE inline
+#endif
+
+#endif // JS_CORE_LIBRARY_H
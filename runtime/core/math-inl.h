@@ -0,0 +1,43 @@
+#ifndef JS_CORE_MATH_INL_H
+#define JS_CORE_MATH_INL_H
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+#include "math.h"
+
+namespace js {
+
+JS_RUNTIME_INLINE double Math::random() {
+    static std::random_device rd;
+    static std::mt19937 gen(rd());
+    static std::uniform_real_distribution<> dis(0.0, 1.0);
+    return dis(gen);
+}
+
+JS_RUNTIME_INLINE number Math::max(const array<number>& values) {
+    if (values.length() == 0) {
+        return number(-std::numeric_limits<double>::infinity());
+    }
+    double maxVal = values[0].value();
+    for (size_t i = 1; i < values.length(); i++) {
+        maxVal = std::max(maxVal, values[i].value());
+    }
+    return number(maxVal);
+}
+
+JS_RUNTIME_INLINE number Math::min(const array<number>& values) {
+    if (values.length() == 0) {
+        return number(std::numeric_limits<double>::infinity());
+    }
+    double minVal = values[0].value();
+    for (size_t i = 1; i < values.length(); i++) {
+        minVal = std::min(minVal, values[i].value());
+    }
+    return number(minVal);
+}
+
+} // namespace js
+
+#endif // JS_CORE_MATH_INL_H
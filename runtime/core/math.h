@@ -0,0 +1,56 @@
+#ifndef JS_CORE_MATH_H
+#define JS_CORE_MATH_H
+
+// The Math namespace object
+
+#include <cmath>
+
+#include "array.h"
+#include "library.h"
+#include "number.h"
+
+namespace js {
+
+// Math static class for mathematical operations
+class Math {
+public:
+    static constexpr double PI = 3.141592653589793;
+    static constexpr double E = 2.718281828459045;
+
+    static double random();
+
+    static number abs(const number& x) {
+        return number(std::abs(x.value()));
+    }
+
+    static number max(const array<number>& values);
+    static number min(const array<number>& values);
+
+    static number sqrt(const number& x) {
+        return number(std::sqrt(x.value()));
+    }
+
+    static number pow(const number& base, const number& exponent) {
+        return number(std::pow(base.value(), exponent.value()));
+    }
+
+    static number floor(const number& x) {
+        return number(std::floor(x.value()));
+    }
+
+    static number ceil(const number& x) {
+        return number(std::ceil(x.value()));
+    }
+
+    static number round(const number& x) {
+        return number(std::round(x.value()));
+    }
+};
+
+} // namespace js
+
+#ifndef JS_RUNTIME_LIBRARY
+#include "math-inl.h"
+#endif
+
+#endif // JS_CORE_MATH_H
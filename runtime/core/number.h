@@ -0,0 +1,100 @@
+#ifndef JS_CORE_NUMBER_H
+#define JS_CORE_NUMBER_H
+
+// undefined, null and js::number
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <string>
+
+namespace js {
+
+class string;
+
+// Undefined and null types
+struct undefined_t {
+    bool operator==(const undefined_t&) const { return true; }
+    bool operator!=(const undefined_t&) const { return false; }
+};
+inline undefined_t undefined;
+
+struct null_t {
+    bool operator==(const null_t&) const { return true; }
+    bool operator!=(const null_t&) const { return false; }
+    bool operator==(std::nullptr_t) const { return true; }
+    bool operator!=(std::nullptr_t) const { return false; }
+};
+inline null_t null;
+
+// Number type with comprehensive JavaScript semantics
+class number {
+public:
+    double value_;
+
+public:
+    number() : value_(0.0) {}
+    number(double v) : value_(v) {}
+    number(int v) : value_(static_cast<double>(v)) {}
+    number(const std::string& str) : value_(std::stod(str)) {}
+
+    double value() const { return value_; }
+    operator double() const { return value_; }
+
+    // JavaScript number semantics
+    bool isNaN() const { return std::isnan(value_); }
+    bool isFinite() const { return std::isfinite(value_); }
+    bool isInteger() const { return std::floor(value_) == value_; }
+
+    // Convert to string (implementation in string-inl.h)
+    string toString() const;
+
+    // Arithmetic operators
+    number operator+(const number& other) const { return number(value_ + other.value_); }
+    number operator-(const number& other) const { return number(value_ - other.value_); }
+    number operator*(const number& other) const { return number(value_ * other.value_); }
+    number operator/(const number& other) const { return number(value_ / other.value_); }
+
+    // Compound assignment operators
+    number& operator+=(const number& other) { value_ += other.value_; return *this; }
+    number& operator-=(const number& other) { value_ -= other.value_; return *this; }
+    number& operator*=(const number& other) { value_ *= other.value_; return *this; }
+    number& operator/=(const number& other) { value_ /= other.value_; return *this; }
+
+    // Increment/decrement operators
+    number& operator++() { ++value_; return *this; }     // prefix ++
+    number operator++(int) { number temp(*this); ++value_; return temp; }  // postfix ++
+    number& operator--() { --value_; return *this; }     // prefix --
+    number operator--(int) { number temp(*this); --value_; return temp; }  // postfix --
+
+    // Comparison operators
+    bool operator==(const number& other) const { return value_ == other.value_; }
+    bool operator!=(const number& other) const { return value_ != other.value_; }
+    bool operator<(const number& other) const { return value_ < other.value_; }
+    bool operator>(const number& other) const { return value_ > other.value_; }
+    bool operator<=(const number& other) const { return value_ <= other.value_; }
+    bool operator>=(const number& other) const { return value_ >= other.value_; }
+
+    // Comparison with size_t (for array.length() comparisons)
+    bool operator<(size_t other) const { return value_ < static_cast<double>(other); }
+    bool operator>(size_t other) const { return value_ > static_cast<double>(other); }
+    bool operator<=(size_t other) const { return value_ <= static_cast<double>(other); }
+    bool operator>=(size_t other) const { return value_ >= static_cast<double>(other); }
+    bool operator==(size_t other) const { return value_ == static_cast<double>(other); }
+    bool operator!=(size_t other) const { return value_ != static_cast<double>(other); }
+
+    // Special JavaScript values
+    static number NaN() { return number(std::numeric_limits<double>::quiet_NaN()); }
+    static number Infinity() { return number(std::numeric_limits<double>::infinity()); }
+    static number NegativeInfinity() { return number(-std::numeric_limits<double>::infinity()); }
+};
+
+// Stream operator for js::number
+inline std::ostream& operator<<(std::ostream& os, const number& num) {
+    return os << num.value();
+}
+
+} // namespace js
+
+#endif // JS_CORE_NUMBER_H
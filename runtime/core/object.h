@@ -0,0 +1,107 @@
+#ifndef JS_CORE_OBJECT_H
+#define JS_CORE_OBJECT_H
+
+// js::object, a property map with an optional prototype
+
+#include <any>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "../memory_resource.h"
+#include "string.h"
+
+namespace js {
+
+class any;
+class object_property_proxy;
+
+// Object class for JavaScript objects
+class object {
+private:
+    // Use std::any to store any type of value; nodes come from js::current_resource()
+    using property_map = std::pmr::unordered_map<std::string, std::any>;
+    property_map properties_;
+    std::shared_ptr<object> prototype_;
+    JS_TRACK_INSTANCES(object)
+
+public:
+    object() : properties_(current_resource()) {}
+    object(const object& other)
+        : properties_(other.properties_, current_resource()), prototype_(other.prototype_) {}
+    object(object&&) = default;
+    object& operator=(const object&) = default;
+    object& operator=(object&&) = default;
+
+    // Property access
+    template<typename T>
+    void set(const std::string& key, const T& value) {
+        properties_[key] = value;
+    }
+
+    template<typename T>
+    T get(const std::string& key) const {
+        auto it = properties_.find(key);
+        if (it != properties_.end()) {
+            return std::any_cast<T>(it->second);
+        }
+        throw std::runtime_error("Property not found: " + key);
+    }
+
+    // Declaration only - implemented in any-inl.h
+    any get_as_js_any(const std::string& key) const;
+
+    // Subscript operators for js::string (implemented in any.h)
+    any operator[](const string& key) const;
+    object_property_proxy operator[](const string& key);
+
+    // Prototype access
+    std::shared_ptr<object> get_prototype() const { return prototype_; }
+    void set_prototype(std::shared_ptr<object> prototype) { prototype_ = std::move(prototype); }
+
+    bool has(const std::string& key) const {
+        return properties_.find(key) != properties_.end();
+    }
+
+    // Alias for has() to match typed_wrappers.h expectations
+    bool has_property(const std::string& key) const {
+        return has(key);
+    }
+
+    // Alias for has() taking js::string
+    bool has_property(const string& key) const {
+        return has(key.value());
+    }
+
+    // Subscript operator for property access
+    // Note: This returns a reference to std::any, not js::any
+    std::any& operator[](const std::string& key) {
+        return properties_[key];
+    }
+
+    const std::any& operator[](const std::string& key) const {
+        auto it = properties_.find(key);
+        if (it != properties_.end()) {
+            return it->second;
+        }
+        static const std::any empty;
+        return empty;
+    }
+
+    // Remove a property from the object (for delete operator)
+    bool remove(const std::string& key) {
+        return properties_.erase(key) > 0;
+    }
+
+    // Get all entries as a range for iteration
+    const property_map& entries() const {
+        return properties_;
+    }
+};
+
+} // namespace js
+
+#endif // JS_CORE_OBJECT_H
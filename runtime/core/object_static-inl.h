@@ -0,0 +1,64 @@
+#ifndef JS_CORE_OBJECT_STATIC_INL_H
+#define JS_CORE_OBJECT_STATIC_INL_H
+
+#include <memory>
+
+#include "object_static.h"
+
+namespace js {
+
+namespace Object {
+    JS_RUNTIME_INLINE array<string> keys(const object& obj) {
+        array<string> result;
+        for (const auto& [key, value] : obj.entries()) {
+            (void)value; // Suppress unused warning
+            result.push(string(key));
+        }
+        return result;
+    }
+
+    JS_RUNTIME_INLINE array<any> values(const object& obj) {
+        array<any> result;
+        for (const auto& [key, value] : obj.entries()) {
+            (void)key; // Suppress unused warning
+            result.push(obj.get_as_js_any(key));
+        }
+        return result;
+    }
+
+    JS_RUNTIME_INLINE array<array<any>> entries(const object& obj) {
+        array<array<any>> result;
+        for (const auto& [key, value] : obj.entries()) {
+            (void)value; // Suppress unused warning
+            array<any> entry;
+            entry.push(any(string(key)));
+            entry.push(obj.get_as_js_any(key));
+            result.push(entry);
+        }
+        return result;
+    }
+
+    JS_RUNTIME_INLINE object fromEntries(const array<array<any>>& entries) {
+        object result;
+        for (size_t i = 0; i < entries.length(); i++) {
+            const auto& entry = entries[i];
+            if (entry.length() >= 2) {
+                string key = entry[0].as<string>();
+                result.set(key.value(), entry[1]);
+            }
+        }
+        return result;
+    }
+
+    JS_RUNTIME_INLINE object create(const object* prototype) {
+        object result;
+        if (prototype) {
+            result.set_prototype(std::make_shared<object>(*prototype));
+        }
+        return result;
+    }
+}
+
+} // namespace js
+
+#endif // JS_CORE_OBJECT_STATIC_INL_H
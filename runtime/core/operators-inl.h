@@ -0,0 +1,40 @@
+#ifndef JS_CORE_OPERATORS_INL_H
+#define JS_CORE_OPERATORS_INL_H
+
+#include <string>
+
+#include "operators.h"
+
+namespace js {
+
+JS_RUNTIME_INLINE bool instanceof_op(const any& obj, const std::string& typeName) {
+    if (typeName == "Array") {
+        return obj.template is<array<any>>();
+    } else if (typeName == "Object") {
+        return obj.template is<object>();
+    } else if (typeName == "String") {
+        return obj.template is<string>();
+    } else if (typeName == "Number") {
+        return obj.template is<number>();
+    } else if (typeName == "Boolean") {
+        return obj.template is<bool>();
+    }
+    return false;
+}
+
+JS_RUNTIME_INLINE bool delete_property(any& obj, const std::string& property) {
+    if (obj.template is<object>()) {
+        // We need to extract the object, modify it, and put it back
+        // because get<>() returns a copy, not a reference
+        object jsObj = obj.template get<object>();
+        bool result = jsObj.remove(property);
+        obj = any(jsObj);
+        return result;
+    }
+    // For non-objects, delete always returns true but doesn't do anything
+    return true;
+}
+
+} // namespace js
+
+#endif // JS_CORE_OPERATORS_INL_H
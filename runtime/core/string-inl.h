@@ -0,0 +1,49 @@
+#ifndef JS_CORE_STRING_INL_H
+#define JS_CORE_STRING_INL_H
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <string>
+
+#include "string.h"
+
+namespace js {
+
+JS_RUNTIME_INLINE string string::trim() const {
+    std::string result = value_;
+    result.erase(result.begin(), std::find_if(result.begin(), result.end(), [](unsigned char ch) {
+        return !std::isspace(ch);
+    }));
+    result.erase(std::find_if(result.rbegin(), result.rend(), [](unsigned char ch) {
+        return !std::isspace(ch);
+    }).base(), result.end());
+    return string(result);
+}
+
+JS_RUNTIME_INLINE string string::toUpperCase() const {
+    std::string result = value_;
+    std::transform(result.begin(), result.end(), result.begin(), ::toupper);
+    return string(result);
+}
+
+JS_RUNTIME_INLINE string string::toLowerCase() const {
+    std::string result = value_;
+    std::transform(result.begin(), result.end(), result.begin(), ::tolower);
+    return string(result);
+}
+
+JS_RUNTIME_INLINE string number::toString() const {
+    double val = value_;
+    if (val == std::floor(val) && std::isfinite(val)) {
+        // Integer value - convert without decimal
+        return string(std::to_string(static_cast<long long>(val)));
+    } else {
+        // Floating point value - use standard conversion
+        return string(std::to_string(val));
+    }
+}
+
+} // namespace js
+
+#endif // JS_CORE_STRING_INL_H
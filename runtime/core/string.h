@@ -0,0 +1,85 @@
+#ifndef JS_CORE_STRING_H
+#define JS_CORE_STRING_H
+
+// js::string and the toString() conversions used by template literals
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+#include "../memory_stats.h"
+#include "library.h"
+#include "number.h"
+
+namespace js {
+
+class any;
+
+// String class with JavaScript semantics
+class string {
+private:
+    std::string value_;
+    JS_TRACK_INSTANCES(string)
+
+public:
+    string() = default;
+    string(const std::string& str) : value_(str) {}
+    string(const char* str) : value_(str) {}
+    string(char ch) : value_(1, ch) {}
+
+    const std::string& value() const { return value_; }
+    const std::string& std() const { return value_; }  // Alias for value() for compatibility
+    operator std::string() const { return value_; }
+
+    // JavaScript string methods
+    size_t length() const { return value_.length(); }
+    bool empty() const { return value_.empty(); }
+    char charAt(size_t index) const { return index < value_.length() ? value_[index] : '\0'; }
+
+    // String utility methods
+    string trim() const;
+    string toUpperCase() const;
+    string toLowerCase() const;
+
+    bool includes(const string& searchStr) const {
+        return value_.find(searchStr.value_) != std::string::npos;
+    }
+
+    // String operators
+    string operator+(const string& other) const { return string(value_ + other.value_); }
+    string operator+(const number& other) const { return string(value_ + std::to_string(other.value_)); }
+    string operator+(const any& other) const;
+    string& operator+=(const string& other) { value_ += other.value_; return *this; }
+    bool operator==(const string& other) const { return value_ == other.value_; }
+    bool operator!=(const string& other) const { return value_ != other.value_; }
+
+};
+
+// String literal operator (must be in global namespace or js namespace)
+inline string operator""_S(const char* str, size_t len) {
+    return string(std::string(str, len));
+}
+
+// Stream operator for js::string
+inline std::ostream& operator<<(std::ostream& os, const string& str) {
+    return os << str.value();
+}
+
+// Global toString function for template literals
+inline string toString(const string& s) { return s; }
+inline string toString(const number& n) { return n.toString(); }
+inline string toString(bool b) { return string(b ? "true" : "false"); }
+inline string toString(const char* s) { return string(s); }
+template<typename T>
+inline string toString(const T& /*value*/) {
+    // Fallback for other types
+    return string("[object]");
+}
+
+} // namespace js
+
+#ifndef JS_RUNTIME_LIBRARY
+#include "string-inl.h"
+#endif
+
+#endif // JS_CORE_STRING_H
@@ -0,0 +1,61 @@
+#ifndef JS_CORE_SYMBOL_INL_H
+#define JS_CORE_SYMBOL_INL_H
+
+#include <memory>
+#include <string>
+
+#include "symbol.h"
+
+namespace js {
+
+JS_RUNTIME_INLINE string symbol::toString() const {
+    if (description.empty()) {
+        return string("Symbol()");
+    }
+    return string("Symbol(" + description + ")");
+}
+
+JS_RUNTIME_INLINE std::shared_ptr<symbol> symbol::for_(const std::string& key) {
+    auto it = global_registry.find(key);
+    if (it != global_registry.end()) {
+        return it->second;
+    }
+    auto sym = std::make_shared<symbol>(key, true);
+    global_registry[key] = sym;
+    return sym;
+}
+
+JS_RUNTIME_INLINE string symbol::keyFor(const std::shared_ptr<symbol>& sym) {
+    if (!sym || !sym->is_global) {
+        return string(""); // undefined in JavaScript
+    }
+
+    for (const auto& pair : global_registry) {
+        if (pair.second.get() == sym.get()) {
+            return string(pair.first);
+        }
+    }
+    return string(""); // undefined
+}
+
+// Static member definitions
+JS_RUNTIME_INLINE std::unordered_map<std::string, std::shared_ptr<symbol>> symbol::global_registry;
+JS_RUNTIME_INLINE std::atomic<uint64_t> symbol::symbol_counter{0};
+
+// Well-known symbols initialization
+JS_RUNTIME_INLINE std::shared_ptr<symbol> symbol::iterator = std::make_shared<symbol>("Symbol.iterator", true);
+JS_RUNTIME_INLINE std::shared_ptr<symbol> symbol::asyncIterator = std::make_shared<symbol>("Symbol.asyncIterator", true);
+JS_RUNTIME_INLINE std::shared_ptr<symbol> symbol::match = std::make_shared<symbol>("Symbol.match", true);
+JS_RUNTIME_INLINE std::shared_ptr<symbol> symbol::replace = std::make_shared<symbol>("Symbol.replace", true);
+JS_RUNTIME_INLINE std::shared_ptr<symbol> symbol::search = std::make_shared<symbol>("Symbol.search", true);
+JS_RUNTIME_INLINE std::shared_ptr<symbol> symbol::split = std::make_shared<symbol>("Symbol.split", true);
+JS_RUNTIME_INLINE std::shared_ptr<symbol> symbol::hasInstance = std::make_shared<symbol>("Symbol.hasInstance", true);
+JS_RUNTIME_INLINE std::shared_ptr<symbol> symbol::isConcatSpreadable = std::make_shared<symbol>("Symbol.isConcatSpreadable", true);
+JS_RUNTIME_INLINE std::shared_ptr<symbol> symbol::species = std::make_shared<symbol>("Symbol.species", true);
+JS_RUNTIME_INLINE std::shared_ptr<symbol> symbol::toPrimitive = std::make_shared<symbol>("Symbol.toPrimitive", true);
+JS_RUNTIME_INLINE std::shared_ptr<symbol> symbol::toStringTag = std::make_shared<symbol>("Symbol.toStringTag", true);
+JS_RUNTIME_INLINE std::shared_ptr<symbol> symbol::metadata = std::make_shared<symbol>("Symbol.metadata", true);
+
+} // namespace js
+
+#endif // JS_CORE_SYMBOL_INL_H
@@ -0,0 +1,93 @@
+#ifndef JS_CORE_SYMBOL_H
+#define JS_CORE_SYMBOL_H
+
+// Symbol, with the global registry and the well-known symbols
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "library.h"
+#include "string.h"
+
+namespace js {
+
+// Symbol class for JavaScript Symbol support
+class symbol {
+private:
+    std::string description;
+    static std::unordered_map<std::string, std::shared_ptr<symbol>> global_registry;
+    static std::atomic<uint64_t> symbol_counter;
+    uint64_t id;
+    bool is_global;
+
+public:
+    // Default constructor - anonymous symbol
+    symbol() : description(""), id(symbol_counter++), is_global(false) {}
+
+    // Constructor with description
+    explicit symbol(const string& desc) : description(desc.value()), id(symbol_counter++), is_global(false) {}
+    explicit symbol(const std::string& desc) : description(desc), id(symbol_counter++), is_global(false) {}
+
+    // Private constructor for global symbols
+    symbol(const std::string& desc, bool global) : description(desc), id(symbol_counter++), is_global(global) {}
+
+    // Get symbol description
+    string toString() const;
+
+    std::string getDescription() const { return description; }
+
+    // Unique identifier for this symbol
+    uint64_t getId() const { return id; }
+
+    // Global symbol registry methods
+    static std::shared_ptr<symbol> for_(const string& key) {
+        return for_(key.value());
+    }
+
+    static std::shared_ptr<symbol> for_(const std::string& key);
+
+    static string keyFor(const std::shared_ptr<symbol>& sym);
+
+    // Comparison operators (symbols are only equal to themselves)
+    bool operator==(const symbol& other) const {
+        return id == other.id;
+    }
+
+    bool operator!=(const symbol& other) const {
+        return !(*this == other);
+    }
+
+    // Hash function for use in containers
+    struct hash {
+        std::size_t operator()(const symbol& s) const {
+            return std::hash<uint64_t>{}(s.id);
+        }
+    };
+
+    // Well-known symbols (static constants)
+    static std::shared_ptr<symbol> iterator;
+    static std::shared_ptr<symbol> asyncIterator;
+    static std::shared_ptr<symbol> match;
+    static std::shared_ptr<symbol> replace;
+    static std::shared_ptr<symbol> search;
+    static std::shared_ptr<symbol> split;
+    static std::shared_ptr<symbol> hasInstance;
+    static std::shared_ptr<symbol> isConcatSpreadable;
+    static std::shared_ptr<symbol> species;
+    static std::shared_ptr<symbol> toPrimitive;
+    static std::shared_ptr<symbol> toStringTag;
+    static std::shared_ptr<symbol> metadata; // TypeScript 5.2+ decorator metadata
+};
+
+} // namespace js
+
+#ifndef JS_RUNTIME_LIBRARY
+#include "symbol-inl.h"
+#endif
+
+#endif // JS_CORE_SYMBOL_H
@@ -0,0 +1,110 @@
+#ifndef JS_COROUTINE_H
+#define JS_COROUTINE_H
+
+#include <coroutine>
+#include <cstddef>
+#include <new>
+
+namespace js {
+
+// Result of one iteration step (JavaScript IteratorResult)
+template<typename T>
+struct IteratorResult {
+    T value{};
+    bool done = true;
+};
+
+namespace detail {
+
+// Per-thread free lists for coroutine frames.
+//
+// Tasks and generators are created and destroyed at a high rate with a
+// handful of distinct frame sizes, so frames are recycled through size-class
+// free lists instead of going back to the global allocator each time.
+class FramePool {
+public:
+    static constexpr size_t granularity = 64;
+    static constexpr size_t classCount = 16;   // frames up to 1 KiB are pooled
+    static constexpr size_t maxCached = 128;   // per size class and thread
+
+    static void* allocate(size_t size) {
+        size_t index = sizeClass(size);
+        if (index < classCount && alive()) {
+            Lists& cache = lists();
+            if (Node* node = cache.heads[index]) {
+                cache.heads[index] = node->next;
+                --cache.counts[index];
+                return node;
+            }
+            return ::operator new((index + 1) * granularity);
+        }
+        return ::operator new(size);
+    }
+
+    static void deallocate(void* pointer, size_t size) noexcept {
+        size_t index = sizeClass(size);
+        if (index < classCount && alive()) {
+            Lists& cache = lists();
+            if (cache.counts[index] < maxCached) {
+                auto* node = static_cast<Node*>(pointer);
+                node->next = cache.heads[index];
+                cache.heads[index] = node;
+                ++cache.counts[index];
+                return;
+            }
+        }
+        ::operator delete(pointer);
+    }
+
+private:
+    struct Node {
+        Node* next;
+    };
+
+    struct Lists {
+        Node* heads[classCount] = {};
+        size_t counts[classCount] = {};
+
+        ~Lists() {
+            alive() = false;
+            for (Node* head : heads) {
+                while (head) {
+                    Node* next = head->next;
+                    ::operator delete(head);
+                    head = next;
+                }
+            }
+        }
+    };
+
+    static size_t sizeClass(size_t size) {
+        return size == 0 ? 0 : (size - 1) / granularity;
+    }
+
+    // Frames freed during thread teardown bypass the (destroyed) lists
+    static bool& alive() {
+        thread_local bool value = true;
+        return value;
+    }
+
+    static Lists& lists() {
+        thread_local Lists cache;
+        return cache;
+    }
+};
+
+// Base for promise types whose frames come from the FramePool
+struct PooledFrame {
+    static void* operator new(size_t size) {
+        return FramePool::allocate(size);
+    }
+
+    static void operator delete(void* pointer, size_t size) noexcept {
+        FramePool::deallocate(pointer, size);
+    }
+};
+
+} // namespace detail
+} // namespace js
+
+#endif // JS_COROUTINE_H
@@ -0,0 +1,159 @@
+#ifndef JS_EVENT_LOOP_H
+#define JS_EVENT_LOOP_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+namespace js {
+
+// Single-threaded event loop driving promise continuations.
+//
+// Background work (I/O completions, worker threads) never resumes coroutines
+// directly; it posts a callback here and the loop runs it on the thread that
+// called run(). Pending operations are counted so run() knows when the
+// program has no more work in flight. Timers are kept in a deadline heap;
+// cleared timers are dropped lazily when they reach the top.
+class EventLoop {
+public:
+    using callback_type = std::function<void()>;
+    using clock = std::chrono::steady_clock;
+    using timer_id = uint64_t;
+
+    static EventLoop& instance() {
+        static EventLoop loop;
+        return loop;
+    }
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    // Queue a callback to run on the loop thread (thread-safe)
+    void post(callback_type callback) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(std::move(callback));
+        }
+        ready_.notify_one();
+    }
+
+    // Track an operation whose completion will be posted later
+    void addPending() { pending_.fetch_add(1, std::memory_order_relaxed); }
+
+    // Post the completion of an operation registered with addPending()
+    void complete(callback_type callback) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(std::move(callback));
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        ready_.notify_one();
+    }
+
+    size_t pending() const { return pending_.load(std::memory_order_relaxed); }
+
+    // Run a callback once the delay has elapsed (thread-safe)
+    timer_id setTimer(std::chrono::milliseconds delay, callback_type callback) {
+        timer_id id;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            id = nextTimer_++;
+            timers_.emplace(id, std::move(callback));
+            deadlines_.push({clock::now() + delay, id});
+        }
+        ready_.notify_one();
+        return id;
+    }
+
+    // Cancel a timer that has not fired yet; returns false if it already ran
+    bool clearTimer(timer_id id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return timers_.erase(id) > 0;
+    }
+
+    // Run callbacks and timers until nothing is queued, scheduled or in flight
+    void run() {
+        for (;;) {
+            std::deque<callback_type> batch;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                for (;;) {
+                    batch.swap(queue_);
+                    collectDueTimers(batch);
+                    if (!batch.empty()) break;
+                    if (timers_.empty()) {
+                        if (pending_.load(std::memory_order_relaxed) == 0) return;
+                        ready_.wait(lock);
+                    } else {
+                        ready_.wait_until(lock, deadlines_.top().deadline);
+                    }
+                }
+            }
+            for (auto& callback : batch) {
+                callback();
+            }
+        }
+    }
+
+    // Run only the callbacks and timers that are ready right now
+    void runOnce() {
+        std::deque<callback_type> batch;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            batch.swap(queue_);
+            collectDueTimers(batch);
+        }
+        for (auto& callback : batch) {
+            callback();
+        }
+    }
+
+private:
+    struct Deadline {
+        clock::time_point deadline;
+        timer_id id;
+
+        bool operator>(const Deadline& other) const {
+            return deadline != other.deadline ? deadline > other.deadline : id > other.id;
+        }
+    };
+
+    EventLoop() = default;
+
+    // Move expired timers into the batch (caller holds the lock)
+    void collectDueTimers(std::deque<callback_type>& batch) {
+        auto now = clock::now();
+        while (!deadlines_.empty()) {
+            const Deadline& next = deadlines_.top();
+            auto timer = timers_.find(next.id);
+            if (timer == timers_.end()) {
+                deadlines_.pop();
+                continue;
+            }
+            if (next.deadline > now) break;
+            batch.push_back(std::move(timer->second));
+            timers_.erase(timer);
+            deadlines_.pop();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<callback_type> queue_;
+    std::atomic<size_t> pending_{0};
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> deadlines_;
+    std::unordered_map<timer_id, callback_type> timers_;
+    timer_id nextTimer_ = 1;
+};
+
+} // namespace js
+
+#endif // JS_EVENT_LOOP_H
@@ -0,0 +1,910 @@
+#ifndef JS_FS_H
+#define JS_FS_H
+
+// Non-blocking file system API (Deno.readTextFile / fs.promises style).
+//
+// Every operation returns a js::Promise that settles on the event loop thread.
+// On Linux the requests are submitted to an io_uring instance; everywhere else,
+// or when the kernel refuses io_uring, they run on a small worker pool. Define
+// JS_FS_NO_IO_URING to force the worker pool. Whole-file operations accept an
+// AbortSignal; aborting cancels the in-flight request and rejects with the
+// abort reason once the kernel has let go of the buffer.
+
+#include "core/any.h"
+#include "core/typed_array.h"
+#include "async.h"
+#include "abort.h"
+#include "event_loop.h"
+
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+#if !defined(JS_FS_NO_IO_URING) && defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define JS_FS_HAS_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#ifndef JS_FS_THREAD_POOL_SIZE
+#define JS_FS_THREAD_POOL_SIZE 4
+#endif
+
+namespace js {
+namespace fs {
+
+// Result of stat() (mirrors Deno.FileInfo)
+struct FileInfo {
+    number size;
+    number mode;
+    number mtimeMs;
+    bool isFile = false;
+    bool isDirectory = false;
+    bool isSymlink = false;
+};
+
+namespace detail {
+
+// One file system request, kept alive until its completion has run
+struct Request {
+    enum class Op { Open, Read, Write, Close, Stat, Fstat };
+
+    Op op;
+    std::string path;
+    int fd = -1;
+    int flags = 0;
+    unsigned mode = 0;
+    void* buffer = nullptr;
+    size_t length = 0;
+    int64_t offset = -1;
+    FileInfo info;
+    std::atomic<bool> cancelled{false};
+    uint64_t ticket = 0;      // io_uring user_data while in flight
+#ifdef JS_FS_HAS_IO_URING
+    struct statx statxBuffer;
+#endif
+};
+
+using Completion = std::function<void(long)>;
+
+inline void fillInfo(FileInfo& info, const struct stat& st) {
+    info.size = number(static_cast<double>(st.st_size));
+    info.mode = number(static_cast<double>(st.st_mode & 07777));
+    info.mtimeMs = number(static_cast<double>(st.st_mtim.tv_sec) * 1000.0 +
+                          static_cast<double>(st.st_mtim.tv_nsec) / 1e6);
+    info.isFile = S_ISREG(st.st_mode);
+    info.isDirectory = S_ISDIR(st.st_mode);
+    info.isSymlink = S_ISLNK(st.st_mode);
+}
+
+// Run a request with ordinary blocking syscalls; returns -errno on failure
+inline long execute(Request& request) {
+    long result = 0;
+    struct stat st;
+    switch (request.op) {
+        case Request::Op::Open:
+            result = ::open(request.path.c_str(), request.flags, request.mode);
+            break;
+        case Request::Op::Read:
+            result = request.offset < 0
+                ? ::read(request.fd, request.buffer, request.length)
+                : ::pread(request.fd, request.buffer, request.length, request.offset);
+            break;
+        case Request::Op::Write:
+            result = request.offset < 0
+                ? ::write(request.fd, request.buffer, request.length)
+                : ::pwrite(request.fd, request.buffer, request.length, request.offset);
+            break;
+        case Request::Op::Close:
+            result = ::close(request.fd);
+            break;
+        case Request::Op::Stat:
+            result = ::stat(request.path.c_str(), &st);
+            if (result == 0) fillInfo(request.info, st);
+            break;
+        case Request::Op::Fstat:
+            result = ::fstat(request.fd, &st);
+            if (result == 0) fillInfo(request.info, st);
+            break;
+    }
+    return result < 0 ? -errno : result;
+}
+
+// Backend interface shared by io_uring and the worker pool
+class Backend {
+public:
+    virtual ~Backend() = default;
+    virtual void submit(std::shared_ptr<Request> request, Completion done) = 0;
+
+    // Best-effort cancellation; the completion still runs, usually with -ECANCELED
+    virtual void cancel(Request& request) = 0;
+};
+
+// Worker pool fallback: blocking syscalls on background threads
+class ThreadPoolBackend : public Backend {
+public:
+    explicit ThreadPoolBackend(unsigned threads) {
+        for (unsigned i = 0; i < threads; ++i) {
+            workers_.emplace_back([this] { work(); });
+        }
+    }
+
+    ~ThreadPoolBackend() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        ready_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    void submit(std::shared_ptr<Request> request, Completion done) override {
+        EventLoop::instance().addPending();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            jobs_.push_back({std::move(request), std::move(done)});
+        }
+        ready_.notify_one();
+    }
+
+    // Queued jobs are skipped; one already running finishes normally
+    void cancel(Request& request) override {
+        request.cancelled.store(true, std::memory_order_relaxed);
+    }
+
+private:
+    struct Job {
+        std::shared_ptr<Request> request;
+        Completion done;
+    };
+
+    void work() {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                ready_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+                if (jobs_.empty()) return;
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+            long result = job.request->cancelled.load(std::memory_order_relaxed)
+                ? -ECANCELED
+                : execute(*job.request);
+            EventLoop::instance().complete(
+                [done = std::move(job.done), request = std::move(job.request), result] {
+                    done(result);
+                });
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<Job> jobs_;
+    std::vector<std::thread> workers_;
+    bool stopping_ = false;
+};
+
+#ifdef JS_FS_HAS_IO_URING
+
+// io_uring backend using the raw syscalls (no liburing dependency).
+// Submissions happen on the loop thread; a reaper thread waits for
+// completions and posts them back to the event loop.
+class IoUringBackend : public Backend {
+public:
+    static std::unique_ptr<IoUringBackend> create(unsigned entries = 256) {
+        std::unique_ptr<IoUringBackend> ring(new IoUringBackend());
+        if (!ring->setup(entries)) return nullptr;
+        ring->reaper_ = std::thread([raw = ring.get()] { raw->reap(); });
+        return ring;
+    }
+
+    ~IoUringBackend() override {
+        if (reaper_.joinable()) {
+            // A NOP with user_data 0 tells the reaper to stop
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                io_uring_sqe* sqe = nextSqe();
+                if (sqe) {
+                    sqe->opcode = IORING_OP_NOP;
+                    sqe->user_data = stopTicket;
+                    flush();
+                }
+            }
+            reaper_.join();
+        }
+        if (sqes_) munmap(sqes_, sqesSize_);
+        if (cqRing_ && cqRing_ != sqRing_) munmap(cqRing_, cqRingSize_);
+        if (sqRing_) munmap(sqRing_, sqRingSize_);
+        if (ringFd_ >= 0) ::close(ringFd_);
+    }
+
+    void submit(std::shared_ptr<Request> request, Completion done) override {
+        EventLoop::instance().addPending();
+        auto* op = new InFlight{std::move(request), std::move(done)};
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        io_uring_sqe* sqe = nextSqe();
+        if (!sqe) {
+            finish(op, -EBUSY);
+            return;
+        }
+        prepare(sqe, *op->request);
+        // Tickets instead of pointers, so a late cancel can never hit a
+        // request that reused the address of a finished one
+        uint64_t ticket = nextTicket_++;
+        op->request->ticket = ticket;
+        sqe->user_data = ticket;
+        long submitted = flush();
+        if (submitted < 0) {
+            // The kernel never saw the entry; roll it back and fail the request
+            *sqTail_ -= 1;
+            finish(op, submitted);
+            return;
+        }
+        inFlight_.emplace(ticket, op);
+    }
+
+    void cancel(Request& request) override {
+        request.cancelled.store(true, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!inFlight_.count(request.ticket)) return;
+        io_uring_sqe* sqe = nextSqe();
+        if (!sqe) return;
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->addr = request.ticket;
+        sqe->user_data = cancelTicket;
+        if (flush() < 0) *sqTail_ -= 1;
+    }
+
+private:
+    struct InFlight {
+        std::shared_ptr<Request> request;
+        Completion done;
+    };
+
+    // Reserved user_data values: 0 stops the reaper, 1 marks cancel requests
+    static constexpr uint64_t stopTicket = 0;
+    static constexpr uint64_t cancelTicket = 1;
+
+    IoUringBackend() = default;
+
+    static int enter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+        return static_cast<int>(
+            syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+    }
+
+    bool setup(unsigned entries) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        ringFd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (ringFd_ < 0) return false;
+        if (!supportsRequiredOps()) return false;
+
+        sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (singleMmap) {
+            sqRingSize_ = cqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+        }
+
+        sqRing_ = mmap(nullptr, sqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       ringFd_, IORING_OFF_SQ_RING);
+        if (sqRing_ == MAP_FAILED) {
+            sqRing_ = nullptr;
+            return false;
+        }
+        if (singleMmap) {
+            cqRing_ = sqRing_;
+        } else {
+            cqRing_ = mmap(nullptr, cqRingSize_, PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_CQ_RING);
+            if (cqRing_ == MAP_FAILED) {
+                cqRing_ = nullptr;
+                return false;
+            }
+        }
+        sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          ringFd_, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) return false;
+        sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+        auto* sq = static_cast<char*>(sqRing_);
+        sqHead_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqEntries_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_entries);
+        sqArray_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+        auto* cq = static_cast<char*>(cqRing_);
+        cqHead_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    // Older kernels lack some opcodes; fall back to the pool in that case
+    bool supportsRequiredOps() {
+        constexpr unsigned opsCount = 64;
+        std::vector<char> storage(sizeof(io_uring_probe) + opsCount * sizeof(io_uring_probe_op));
+        auto* probe = reinterpret_cast<io_uring_probe*>(storage.data());
+        if (syscall(__NR_io_uring_register, ringFd_, IORING_REGISTER_PROBE, probe, opsCount) < 0) {
+            return false;
+        }
+        for (unsigned op : {IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_WRITE, IORING_OP_CLOSE,
+                            IORING_OP_STATX}) {
+            if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    io_uring_sqe* nextSqe() {
+        unsigned tail = *sqTail_;
+        unsigned head = __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE);
+        if (tail - head >= sqEntries_) return nullptr;
+        unsigned index = tail & sqMask_;
+        io_uring_sqe* sqe = &sqes_[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqArray_[index] = index;
+        __atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+        return sqe;
+    }
+
+    long flush() {
+        for (;;) {
+            int submitted = enter(ringFd_, 1, 0, 0);
+            if (submitted >= 0) return submitted;
+            if (errno != EINTR) return -errno;
+        }
+    }
+
+    static void prepare(io_uring_sqe* sqe, Request& request) {
+        switch (request.op) {
+            case Request::Op::Open:
+                sqe->opcode = IORING_OP_OPENAT;
+                sqe->fd = AT_FDCWD;
+                sqe->addr = reinterpret_cast<uint64_t>(request.path.c_str());
+                sqe->len = request.mode;
+                sqe->open_flags = static_cast<uint32_t>(request.flags);
+                break;
+            case Request::Op::Read:
+            case Request::Op::Write:
+                sqe->opcode = request.op == Request::Op::Read ? IORING_OP_READ : IORING_OP_WRITE;
+                sqe->fd = request.fd;
+                sqe->addr = reinterpret_cast<uint64_t>(request.buffer);
+                sqe->len = static_cast<uint32_t>(request.length);
+                sqe->off = static_cast<uint64_t>(request.offset);
+                break;
+            case Request::Op::Close:
+                sqe->opcode = IORING_OP_CLOSE;
+                sqe->fd = request.fd;
+                break;
+            case Request::Op::Stat:
+            case Request::Op::Fstat:
+                sqe->opcode = IORING_OP_STATX;
+                if (request.op == Request::Op::Stat) {
+                    sqe->fd = AT_FDCWD;
+                    sqe->addr = reinterpret_cast<uint64_t>(request.path.c_str());
+                } else {
+                    sqe->fd = request.fd;
+                    sqe->addr = reinterpret_cast<uint64_t>("");
+                    sqe->statx_flags = AT_EMPTY_PATH;
+                }
+                sqe->len = STATX_BASIC_STATS;
+                sqe->off = reinterpret_cast<uint64_t>(&request.statxBuffer);
+                break;
+        }
+    }
+
+    static void convertStatx(Request& request) {
+        const struct statx& sx = request.statxBuffer;
+        request.info.size = number(static_cast<double>(sx.stx_size));
+        request.info.mode = number(static_cast<double>(sx.stx_mode & 07777));
+        request.info.mtimeMs = number(static_cast<double>(sx.stx_mtime.tv_sec) * 1000.0 +
+                                      static_cast<double>(sx.stx_mtime.tv_nsec) / 1e6);
+        request.info.isFile = S_ISREG(sx.stx_mode);
+        request.info.isDirectory = S_ISDIR(sx.stx_mode);
+        request.info.isSymlink = S_ISLNK(sx.stx_mode);
+    }
+
+    static void finish(InFlight* op, long result) {
+        if (result >= 0 && (op->request->op == Request::Op::Stat ||
+                            op->request->op == Request::Op::Fstat)) {
+            convertStatx(*op->request);
+        }
+        EventLoop::instance().complete([op, result] {
+            std::unique_ptr<InFlight> owned(op);
+            owned->done(result);
+        });
+    }
+
+    InFlight* take(uint64_t ticket) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = inFlight_.find(ticket);
+        if (it == inFlight_.end()) return nullptr;
+        InFlight* op = it->second;
+        inFlight_.erase(it);
+        return op;
+    }
+
+    void reap() {
+        bool stopping = false;
+        while (!stopping) {
+            if (enter(ringFd_, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+                return;
+            }
+            unsigned head = *cqHead_;
+            unsigned tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+            while (head != tail) {
+                const io_uring_cqe& cqe = cqes_[head & cqMask_];
+                if (cqe.user_data == stopTicket) {
+                    stopping = true;
+                } else if (cqe.user_data != cancelTicket) {
+                    if (InFlight* op = take(cqe.user_data)) {
+                        finish(op, cqe.res);
+                    }
+                }
+                ++head;
+            }
+            __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+        }
+    }
+
+    int ringFd_ = -1;
+    void* sqRing_ = nullptr;
+    void* cqRing_ = nullptr;
+    size_t sqRingSize_ = 0;
+    size_t cqRingSize_ = 0;
+    size_t sqesSize_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    unsigned* sqHead_ = nullptr;
+    unsigned* sqTail_ = nullptr;
+    unsigned* sqArray_ = nullptr;
+    unsigned sqMask_ = 0;
+    unsigned sqEntries_ = 0;
+    unsigned* cqHead_ = nullptr;
+    unsigned* cqTail_ = nullptr;
+    io_uring_cqe* cqes_ = nullptr;
+    unsigned cqMask_ = 0;
+    std::unordered_map<uint64_t, InFlight*> inFlight_;
+    uint64_t nextTicket_ = 2;
+    std::mutex mutex_;
+    std::thread reaper_;
+};
+
+#endif // JS_FS_HAS_IO_URING
+
+inline Backend& backend() {
+    // Touch the loop first so it outlives the backend's threads
+    EventLoop::instance();
+    static std::unique_ptr<Backend> instance = []() -> std::unique_ptr<Backend> {
+#ifdef JS_FS_HAS_IO_URING
+        if (auto ring = IoUringBackend::create()) {
+            return ring;
+        }
+#endif
+        return std::make_unique<ThreadPoolBackend>(JS_FS_THREAD_POOL_SIZE);
+    }();
+    return *instance;
+}
+
+inline const char* syscallName(Request::Op op) {
+    switch (op) {
+        case Request::Op::Open: return "open";
+        case Request::Op::Read: return "read";
+        case Request::Op::Write: return "write";
+        case Request::Op::Close: return "close";
+        case Request::Op::Stat:
+        case Request::Op::Fstat: return "stat";
+    }
+    return "io";
+}
+
+// Describe a failed request the way Deno does, e.g.
+// "No such file or directory (os error 2), open 'missing.txt'"
+inline std::exception_ptr makeError(const Request& request, long result) {
+    std::string target = request.path.empty() ? std::to_string(request.fd) : request.path;
+    std::string message = std::string(std::strerror(static_cast<int>(-result))) +
+        " (os error " + std::to_string(-result) + "), " + syscallName(request.op) + " '" +
+        target + "'";
+    return std::make_exception_ptr(any(Error(string(message))));
+}
+
+// Submit a request; the promise rejects with a JavaScript error on failure,
+// or with the abort reason if the signal fired while it was in flight
+inline std::shared_ptr<Promise<long>> submit(std::shared_ptr<Request> request,
+                                             const AbortSignal& signal = AbortSignal()) {
+    auto promise = std::make_shared<Promise<long>>();
+    if (signal.aborted()) {
+        promise->rejectWith(std::make_exception_ptr(signal.reason()));
+        return promise;
+    }
+    auto listener = signal.onAbort([request](const any&) { backend().cancel(*request); });
+    backend().submit(request, [promise, request, signal, listener](long result) {
+        signal.removeListener(listener);
+        if (signal.aborted()) {
+            promise->rejectWith(std::make_exception_ptr(signal.reason()));
+        } else if (result < 0) {
+            promise->rejectWith(makeError(*request, result));
+        } else {
+            promise->resolveWith(result);
+        }
+    });
+    return promise;
+}
+
+inline int parseFlags(const std::string& flags) {
+    if (flags == "r") return O_RDONLY;
+    if (flags == "r+") return O_RDWR;
+    if (flags == "w") return O_WRONLY | O_CREAT | O_TRUNC;
+    if (flags == "wx") return O_WRONLY | O_CREAT | O_TRUNC | O_EXCL;
+    if (flags == "w+") return O_RDWR | O_CREAT | O_TRUNC;
+    if (flags == "a") return O_WRONLY | O_CREAT | O_APPEND;
+    if (flags == "ax") return O_WRONLY | O_CREAT | O_APPEND | O_EXCL;
+    if (flags == "a+") return O_RDWR | O_CREAT | O_APPEND;
+    throw any(Error(string("Invalid file open flags: " + flags)));
+}
+
+inline std::shared_ptr<Request> makeRequest(Request::Op op) {
+    auto request = std::make_shared<Request>();
+    request->op = op;
+    return request;
+}
+
+inline Task<number> openImpl(std::string path, int flags, unsigned mode) {
+    auto request = makeRequest(Request::Op::Open);
+    request->path = path;
+    request->flags = flags | O_CLOEXEC;
+    request->mode = mode;
+    long fd = co_await submit(request);
+    co_return number(static_cast<double>(fd));
+}
+
+inline Task<void> closeImpl(int fd) {
+    auto request = makeRequest(Request::Op::Close);
+    request->fd = fd;
+    co_await submit(request);
+}
+
+// Read until EOF into a byte buffer, sized by fstat when possible
+inline Task<std::string> readAllImpl(std::string path, AbortSignal signal) {
+    auto request = makeRequest(Request::Op::Open);
+    request->path = path;
+    request->flags = O_RDONLY | O_CLOEXEC;
+    int fd = static_cast<int>(co_await submit(request, signal));
+
+    std::string contents;
+    std::exception_ptr failure;
+    try {
+        auto statRequest = makeRequest(Request::Op::Fstat);
+        statRequest->fd = fd;
+        co_await submit(statRequest, signal);
+        size_t capacity = static_cast<size_t>(statRequest->info.size.value());
+
+        size_t used = 0;
+        contents.resize(capacity > 0 ? capacity : 4096);
+        for (;;) {
+            if (used == contents.size()) contents.resize(contents.size() * 2);
+            auto readRequest = makeRequest(Request::Op::Read);
+            readRequest->fd = fd;
+            readRequest->buffer = contents.data() + used;
+            readRequest->length = contents.size() - used;
+            readRequest->offset = static_cast<int64_t>(used);
+            long count = co_await submit(readRequest, signal);
+            if (count == 0) break;
+            used += static_cast<size_t>(count);
+        }
+        contents.resize(used);
+    } catch (...) {
+        failure = std::current_exception();
+    }
+    co_await closeImpl(fd);
+    if (failure) std::rethrow_exception(failure);
+    co_return contents;
+}
+
+inline Task<void> writeAllImpl(std::string path, std::string data, int flags,
+                               AbortSignal signal, unsigned mode = 0666) {
+    auto request = makeRequest(Request::Op::Open);
+    request->path = path;
+    request->flags = flags | O_CLOEXEC;
+    request->mode = mode;
+    int fd = static_cast<int>(co_await submit(request, signal));
+
+    std::exception_ptr failure;
+    try {
+        size_t written = 0;
+        while (written < data.size()) {
+            auto writeRequest = makeRequest(Request::Op::Write);
+            writeRequest->fd = fd;
+            writeRequest->buffer = data.data() + written;
+            writeRequest->length = data.size() - written;
+            writeRequest->offset = (flags & O_APPEND) ? -1 : static_cast<int64_t>(written);
+            long count = co_await submit(writeRequest, signal);
+            // A write that makes no progress would otherwise loop forever
+            if (count == 0) std::rethrow_exception(makeError(*writeRequest, -ENOSPC));
+            written += static_cast<size_t>(count);
+        }
+    } catch (...) {
+        failure = std::current_exception();
+    }
+    co_await closeImpl(fd);
+    if (failure) std::rethrow_exception(failure);
+}
+
+inline Task<Uint8Array> readBytesImpl(std::string path, AbortSignal signal) {
+    std::string contents = co_await readAllImpl(path, signal);
+    co_return Uint8Array(std::vector<uint8_t>(contents.begin(), contents.end()));
+}
+
+inline Task<string> readTextImpl(std::string path, AbortSignal signal) {
+    co_return string(co_await readAllImpl(path, signal));
+}
+
+inline Task<Uint8Array> readImpl(int fd, size_t length, int64_t position) {
+    std::string buffer(length, '\0');
+    auto request = makeRequest(Request::Op::Read);
+    request->fd = fd;
+    request->buffer = buffer.data();
+    request->length = length;
+    request->offset = position;
+    long count = co_await submit(request);
+    co_return Uint8Array(std::vector<uint8_t>(buffer.begin(), buffer.begin() + count));
+}
+
+inline Task<number> writeImpl(int fd, std::string data, int64_t position) {
+    auto request = makeRequest(Request::Op::Write);
+    request->fd = fd;
+    request->buffer = data.data();
+    request->length = data.size();
+    request->offset = position;
+    long count = co_await submit(request);
+    co_return number(static_cast<double>(count));
+}
+
+inline Task<FileInfo> statImpl(std::string path, int fd) {
+    auto request = makeRequest(fd < 0 ? Request::Op::Stat : Request::Op::Fstat);
+    request->path = path;
+    request->fd = fd;
+    co_await submit(request);
+    co_return request->info;
+}
+
+inline std::string toBytes(const Uint8Array& data) {
+    std::string bytes;
+    bytes.reserve(data.length());
+    for (size_t i = 0; i < data.length(); ++i) {
+        bytes.push_back(static_cast<char>(data[i]));
+    }
+    return bytes;
+}
+
+} // namespace detail
+
+// Deno.WriteFileOptions; generated code fills it from an object literal
+struct WriteFileOptions {
+    bool append = false;
+    bool create = true;
+    bool createNew = false;
+    unsigned mode = 0666;
+    AbortSignal signal;
+};
+
+namespace detail {
+
+inline int writeFlags(const WriteFileOptions& options) {
+    int flags = O_WRONLY | (options.append ? O_APPEND : O_TRUNC);
+    if (options.createNew) return flags | O_CREAT | O_EXCL;
+    return options.create ? flags | O_CREAT : flags;
+}
+
+} // namespace detail
+
+// Read a whole file as bytes
+inline std::shared_ptr<Promise<Uint8Array>> readFile(const string& path,
+                                                     const AbortSignal& signal = AbortSignal()) {
+    return detail::readBytesImpl(path.value(), signal).promise();
+}
+
+// Read a whole file as UTF-8 text
+inline std::shared_ptr<Promise<string>> readTextFile(const string& path,
+                                                     const AbortSignal& signal = AbortSignal()) {
+    return detail::readTextImpl(path.value(), signal).promise();
+}
+
+// Node-style readFile(path, "utf8"): read a whole file as text
+inline std::shared_ptr<Promise<string>> readFile(const string& path, const string& encoding) {
+    if (encoding.value() != "utf8" && encoding.value() != "utf-8") {
+        throw any(Error(string("Unsupported encoding: " + encoding.value())));
+    }
+    return detail::readTextImpl(path.value(), AbortSignal()).promise();
+}
+
+// Replace (or create) a file with the given bytes
+inline std::shared_ptr<Promise<void>> writeFile(const string& path, const Uint8Array& data,
+                                                const AbortSignal& signal = AbortSignal()) {
+    return detail::writeAllImpl(path.value(), detail::toBytes(data),
+                                O_WRONLY | O_CREAT | O_TRUNC, signal).promise();
+}
+
+// Node-style writeFile(path, text)
+inline std::shared_ptr<Promise<void>> writeFile(const string& path, const string& data,
+                                                const AbortSignal& signal = AbortSignal()) {
+    return detail::writeAllImpl(path.value(), data.value(), O_WRONLY | O_CREAT | O_TRUNC,
+                                signal).promise();
+}
+
+// Replace (or create) a file with the given text
+inline std::shared_ptr<Promise<void>> writeTextFile(const string& path, const string& data,
+                                                    const AbortSignal& signal = AbortSignal()) {
+    return detail::writeAllImpl(path.value(), data.value(), O_WRONLY | O_CREAT | O_TRUNC,
+                                signal).promise();
+}
+
+// Deno.writeFile(path, data, { append, create, createNew, mode, signal })
+inline std::shared_ptr<Promise<void>> writeFile(const string& path, const Uint8Array& data,
+                                                const WriteFileOptions& options) {
+    return detail::writeAllImpl(path.value(), detail::toBytes(data), detail::writeFlags(options),
+                                options.signal, options.mode).promise();
+}
+
+// Deno.writeTextFile(path, text, { append, create, createNew, mode, signal })
+inline std::shared_ptr<Promise<void>> writeTextFile(const string& path, const string& data,
+                                                    const WriteFileOptions& options) {
+    return detail::writeAllImpl(path.value(), data.value(), detail::writeFlags(options),
+                                options.signal, options.mode).promise();
+}
+
+// Append text to a file, creating it if needed
+inline std::shared_ptr<Promise<void>> appendFile(const string& path, const string& data,
+                                                 const AbortSignal& signal = AbortSignal()) {
+    return detail::writeAllImpl(path.value(), data.value(), O_WRONLY | O_CREAT | O_APPEND,
+                                signal).promise();
+}
+
+// Open a file descriptor using Node-style flags ("r", "w", "a", "r+", ...)
+inline std::shared_ptr<Promise<number>> open(const string& path, const string& flags = string("r"),
+                                             number mode = number(0666)) {
+    return detail::openImpl(path.value(), detail::parseFlags(flags.value()),
+                            static_cast<unsigned>(mode.value())).promise();
+}
+
+// Read up to `length` bytes; a negative position reads from the current offset
+inline std::shared_ptr<Promise<Uint8Array>> read(number fd, number length,
+                                                 number position = number(-1)) {
+    return detail::readImpl(static_cast<int>(fd.value()), static_cast<size_t>(length.value()),
+                            static_cast<int64_t>(position.value())).promise();
+}
+
+// Write bytes; resolves with the number of bytes written
+inline std::shared_ptr<Promise<number>> write(number fd, const Uint8Array& data,
+                                              number position = number(-1)) {
+    return detail::writeImpl(static_cast<int>(fd.value()), detail::toBytes(data),
+                             static_cast<int64_t>(position.value())).promise();
+}
+
+inline std::shared_ptr<Promise<number>> write(number fd, const string& data,
+                                              number position = number(-1)) {
+    return detail::writeImpl(static_cast<int>(fd.value()), data.value(),
+                             static_cast<int64_t>(position.value())).promise();
+}
+
+inline std::shared_ptr<Promise<void>> close(number fd) {
+    return detail::closeImpl(static_cast<int>(fd.value())).promise();
+}
+
+inline std::shared_ptr<Promise<FileInfo>> stat(const string& path) {
+    return detail::statImpl(path.value(), -1).promise();
+}
+
+inline std::shared_ptr<Promise<FileInfo>> fstat(number fd) {
+    return detail::statImpl(std::string(), static_cast<int>(fd.value())).promise();
+}
+
+// Open file handle (Deno.FsFile / fs.promises.FileHandle)
+class FileHandle {
+public:
+    FileHandle() = default;
+    explicit FileHandle(number fd) : fd_(fd) {}
+
+    number fd() const { return fd_; }
+
+    std::shared_ptr<Promise<Uint8Array>> read(number length, number position = number(-1)) const {
+        return fs::read(fd_, length, position);
+    }
+
+    std::shared_ptr<Promise<number>> write(const Uint8Array& data,
+                                           number position = number(-1)) const {
+        return fs::write(fd_, data, position);
+    }
+
+    std::shared_ptr<Promise<number>> write(const string& data, number position = number(-1)) const {
+        return fs::write(fd_, data, position);
+    }
+
+    std::shared_ptr<Promise<FileInfo>> stat() const { return fs::fstat(fd_); }
+
+    std::shared_ptr<Promise<void>> close() const { return fs::close(fd_); }
+
+private:
+    number fd_{-1};
+};
+
+// Deno.OpenOptions; generated code fills it from an object literal
+struct OpenOptions {
+    bool read = false;
+    bool write = false;
+    bool append = false;
+    bool truncate = false;
+    bool create = false;
+    bool createNew = false;
+    unsigned mode = 0666;
+};
+
+namespace detail {
+
+inline Task<FileHandle> openHandleImpl(std::string path, int flags, unsigned mode) {
+    co_return FileHandle(co_await openImpl(std::move(path), flags, mode));
+}
+
+// Same rules as Deno: creating or truncating needs write access, and
+// truncate and append exclude each other
+inline int openFlags(const OpenOptions& options) {
+    bool write = options.write || options.append;
+    if (!options.read && !write) {
+        throw any(Error(string("Invalid open options: read, write or append is required")));
+    }
+    if (!write && (options.create || options.createNew || options.truncate)) {
+        throw any(Error(string("Invalid open options: create and truncate require write access")));
+    }
+    if (options.truncate && options.append) {
+        throw any(Error(string("Invalid open options: truncate and append exclude each other")));
+    }
+    int flags = options.read ? (write ? O_RDWR : O_RDONLY) : O_WRONLY;
+    if (options.append) flags |= O_APPEND;
+    if (options.truncate) flags |= O_TRUNC;
+    if (options.createNew) {
+        flags |= O_CREAT | O_EXCL;
+    } else if (options.create) {
+        flags |= O_CREAT;
+    }
+    return flags;
+}
+
+} // namespace detail
+
+// Open a file and wrap the descriptor in a FileHandle
+inline std::shared_ptr<Promise<FileHandle>> openFile(const string& path,
+                                                     const string& flags = string("r")) {
+    return detail::openHandleImpl(path.value(), detail::parseFlags(flags.value()), 0666).promise();
+}
+
+// Deno.open(path, { read, write, append, truncate, create, createNew, mode })
+inline std::shared_ptr<Promise<FileHandle>> openFile(const string& path,
+                                                     const OpenOptions& options) {
+    return detail::openHandleImpl(path.value(), detail::openFlags(options), options.mode).promise();
+}
+
+} // namespace fs
+} // namespace js
+
+#endif // JS_FS_H
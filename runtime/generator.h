@@ -0,0 +1,139 @@
+#ifndef JS_GENERATOR_H
+#define JS_GENERATOR_H
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <utility>
+
+#include "coroutine.h"
+
+namespace js {
+
+// Generator - coroutine return type for `function*`
+//
+// The body runs lazily: nothing executes until the first next() or begin(),
+// and each co_yield suspends until the consumer asks for the next value.
+// Generator is also a C++ input range, so `for (auto& x : gen())` walks it
+// without materializing the sequence.
+template<typename T>
+class Generator {
+public:
+    struct promise_type : detail::PooledFrame {
+        std::optional<T> current;
+        std::exception_ptr error;
+
+        Generator get_return_object() {
+            return Generator{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        template<typename U>
+        std::suspend_always yield_value(U&& value) {
+            current.emplace(std::forward<U>(value));
+            return {};
+        }
+
+        void return_void() {}
+
+        void unhandled_exception() {
+            error = std::current_exception();
+        }
+
+        // Generators cannot await; use AsyncGenerator for that
+        template<typename U>
+        std::suspend_never await_transform(U&&) = delete;
+    };
+
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() = default;
+        explicit iterator(handle_type handle) : handle_(handle) {}
+
+        reference operator*() const { return *handle_.promise().current; }
+        pointer operator->() const { return &*handle_.promise().current; }
+
+        iterator& operator++() {
+            advance(handle_);
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const iterator& it, std::default_sentinel_t) {
+            return !it.handle_ || it.handle_.done();
+        }
+
+    private:
+        handle_type handle_;
+    };
+
+    Generator() = default;
+    explicit Generator(handle_type handle) : handle_(handle) {}
+    Generator(Generator&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    Generator& operator=(Generator&& other) noexcept {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+
+    ~Generator() {
+        if (handle_) handle_.destroy();
+    }
+
+    iterator begin() {
+        advance(handle_);
+        return iterator{handle_};
+    }
+
+    std::default_sentinel_t end() const noexcept { return {}; }
+
+    // Run the body to the next yield (JavaScript gen.next())
+    IteratorResult<T> next() {
+        advance(handle_);
+        if (!handle_ || handle_.done()) {
+            return {};
+        }
+        return {std::move(*handle_.promise().current), false};
+    }
+
+    // Finish early, running destructors of live locals (JavaScript gen.return())
+    IteratorResult<T> return_(T value = T{}) {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = {};
+        }
+        return {std::move(value), true};
+    }
+
+private:
+    static void advance(handle_type handle) {
+        if (!handle || handle.done()) return;
+        handle.promise().current.reset();
+        handle.resume();
+        if (handle.promise().error) {
+            std::rethrow_exception(std::exchange(handle.promise().error, nullptr));
+        }
+    }
+
+    handle_type handle_;
+};
+
+} // namespace js
+
+#endif // JS_GENERATOR_H
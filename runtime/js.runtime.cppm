@@ -0,0 +1,94 @@
+// The runtime as a C++20 named module.
+//
+// Generated code built with useModules (experimental.modules in the config)
+// replaces its "runtime/..." includes with `import js.runtime;`, so the
+// runtime is parsed once per build instead of once per translation unit.
+// The generated CMake compiles this file into the jsruntime library next to
+// core.cpp; JS_RUNTIME_LIBRARY applies here as well.
+//
+// The runtime headers are attached to the global module (extern "C++"), so
+// the entities they declare are the ones core.cpp defines. Every system
+// header is included in the global module fragment first; their include
+// guards keep them out of the module purview. Macros do not cross a module
+// boundary: memory_stats.h stays in the fragment and importers include it
+// themselves for JS_TRACK_INSTANCES.
+
+module;
+
+#include <algorithm>
+#include <any>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <ostream>
+#include <queue>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <csignal>
+#include <pthread.h>
+#endif
+
+#if !defined(JS_FS_NO_IO_URING) && defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#include "memory_stats.h"
+
+#define JS_RUNTIME_MODULE 1
+
+export module js.runtime;
+
+export extern "C++" {
+#include "core.h"
+#include "async.h"
+#include "generator.h"
+#include "abort.h"
+#include "timers.h"
+#include "fs.h"
+#include "pool.h"
+#include "soa.h"
+}
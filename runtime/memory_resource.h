@@ -0,0 +1,94 @@
+#ifndef JS_MEMORY_RESOURCE_H
+#define JS_MEMORY_RESOURCE_H
+
+// Allocation policy for runtime containers.
+//
+// js::array and js::object keep their storage in std::pmr containers built on
+// js::current_resource(): the innermost resource installed with
+// js::ResourceScope on this thread (arena scopes use this), otherwise the
+// process-wide resource. The process-wide resource defaults to
+// std::pmr::new_delete_resource() and can be swapped at startup to plug in a
+// monotonic buffer, a pool or any other std::pmr::memory_resource:
+//
+//     static std::pmr::synchronized_pool_resource pool;
+//     js::set_memory_resource(&pool);
+//
+// Containers keep the resource they were created with, so swap it before any
+// runtime containers exist and keep it alive until they are gone.
+//
+// With JS_MEMORY_STATS the process-wide resource is wrapped in a counting
+// resource (see memory_stats.h); get_memory_resource() returns the wrapper.
+
+#include <atomic>
+#include <memory_resource>
+
+#include "memory_stats.h"
+
+namespace js {
+
+// Allocator used by runtime containers
+template<typename T>
+using allocator = std::pmr::polymorphic_allocator<T>;
+
+namespace detail {
+
+inline std::atomic<std::pmr::memory_resource*>& globalResource() {
+#ifdef JS_MEMORY_STATS
+    static std::atomic<std::pmr::memory_resource*> resource{
+        count_allocations(std::pmr::new_delete_resource())};
+#else
+    static std::atomic<std::pmr::memory_resource*> resource{std::pmr::new_delete_resource()};
+#endif
+    return resource;
+}
+
+inline std::pmr::memory_resource*& scopedResource() {
+    thread_local std::pmr::memory_resource* resource = nullptr;
+    return resource;
+}
+
+} // namespace detail
+
+// Process-wide resource for runtime containers
+inline std::pmr::memory_resource* get_memory_resource() noexcept {
+    return detail::globalResource().load(std::memory_order_acquire);
+}
+
+// Replace the process-wide resource (nullptr restores new/delete); returns the previous one
+inline std::pmr::memory_resource* set_memory_resource(std::pmr::memory_resource* resource) noexcept {
+    if (!resource) resource = std::pmr::new_delete_resource();
+#ifdef JS_MEMORY_STATS
+    std::pmr::memory_resource* previous = detail::globalResource().exchange(
+        detail::count_allocations(resource), std::memory_order_acq_rel);
+    return detail::uncounted(previous);
+#else
+    return detail::globalResource().exchange(resource, std::memory_order_acq_rel);
+#endif
+}
+
+// Resource new containers allocate from on this thread
+inline std::pmr::memory_resource* current_resource() noexcept {
+    std::pmr::memory_resource* scoped = detail::scopedResource();
+    return scoped ? scoped : get_memory_resource();
+}
+
+// Makes a resource current on this thread until the end of the enclosing block
+class ResourceScope {
+public:
+    explicit ResourceScope(std::pmr::memory_resource* resource)
+        : previous_(detail::scopedResource()) {
+        detail::scopedResource() = resource;
+    }
+
+    ~ResourceScope() { detail::scopedResource() = previous_; }
+
+    ResourceScope(const ResourceScope&) = delete;
+    ResourceScope& operator=(const ResourceScope&) = delete;
+
+private:
+    std::pmr::memory_resource* previous_;
+};
+
+} // namespace js
+
+#endif // JS_MEMORY_RESOURCE_H
@@ -0,0 +1,264 @@
+#ifndef JS_MEMORY_STATS_H
+#define JS_MEMORY_STATS_H
+
+// Opt-in allocation counters for the runtime (build with -DJS_MEMORY_STATS).
+//
+// Instrumented builds count, per type, how many instances were created, how
+// many are alive, and their footprint. The types counted are js::string,
+// each js::array<T>, js::object, each Promise<T> and every generated class
+// (through JS_TRACK_INSTANCES). Container storage from the std::pmr resource
+// (element buffers, object nodes, arena blocks) is counted as one extra row.
+//
+// Once js::install_memory_report() has run (the generated main() calls it),
+// the report goes to stderr at exit and, on POSIX, whenever the process
+// receives SIGUSR1. js::memory_usage() returns the same rows for programs
+// that want to log or assert on them:
+//
+//     for (const js::MemoryUsage& row : js::memory_usage()) {
+//         std::cout << row.type << ": " << row.liveObjects << " live\n";
+//     }
+//
+// Without JS_MEMORY_STATS, JS_TRACK_INSTANCES expands to nothing,
+// install_memory_report() does nothing and none of this is compiled in.
+
+#ifdef JS_MEMORY_STATS
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <csignal>
+#include <pthread.h>
+#include <thread>
+#endif
+
+namespace js {
+
+// One row of the memory report
+struct MemoryUsage {
+    std::string type;
+    uint64_t allocations = 0;     // instances created (or resource allocations)
+    uint64_t bytesAllocated = 0;  // total bytes of those allocations
+    uint64_t liveObjects = 0;
+    uint64_t liveBytes = 0;
+    uint64_t peakLiveBytes = 0;
+};
+
+namespace detail {
+
+// Counters of one type; never destroyed, so the exit report can still read them
+struct TypeStats {
+    explicit TypeStats(std::string_view typeName) : name(typeName) {}
+
+    void allocate(uint64_t bytes) noexcept {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        bytesAllocated.fetch_add(bytes, std::memory_order_relaxed);
+        liveObjects.fetch_add(1, std::memory_order_relaxed);
+        uint64_t live = liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        uint64_t peak = peakLiveBytes.load(std::memory_order_relaxed);
+        while (live > peak &&
+               !peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+    }
+
+    void release(uint64_t bytes) noexcept {
+        liveObjects.fetch_sub(1, std::memory_order_relaxed);
+        liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    std::string_view name;
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> bytesAllocated{0};
+    std::atomic<uint64_t> liveObjects{0};
+    std::atomic<uint64_t> liveBytes{0};
+    std::atomic<uint64_t> peakLiveBytes{0};
+    TypeStats* next = nullptr;
+};
+
+inline std::atomic<TypeStats*>& statsRegistry() {
+    static std::atomic<TypeStats*> head{nullptr};
+    return head;
+}
+
+inline TypeStats& registerStats(TypeStats& stats) {
+    TypeStats* head = statsRegistry().load(std::memory_order_relaxed);
+    do {
+        stats.next = head;
+    } while (!statsRegistry().compare_exchange_weak(head, &stats, std::memory_order_release,
+                                                    std::memory_order_relaxed));
+    return stats;
+}
+
+// Readable name of T, taken from the compiler's function signature
+template<typename T>
+constexpr std::string_view type_name() {
+#if defined(__clang__) || defined(__GNUC__)
+    std::string_view name = __PRETTY_FUNCTION__;
+    size_t start = name.find("T = ") + 4;
+    size_t end = name.find_first_of(";]", start);
+#elif defined(_MSC_VER)
+    std::string_view name = __FUNCSIG__;
+    size_t start = name.find("type_name<") + 10;
+    size_t end = name.rfind(">(");
+    for (std::string_view keyword : {"class ", "struct "}) {
+        if (name.substr(start, keyword.size()) == keyword) start += keyword.size();
+    }
+#else
+    std::string_view name = "unknown";
+    size_t start = 0;
+    size_t end = name.size();
+#endif
+    return name.substr(start, end - start);
+}
+
+template<typename T>
+TypeStats& statsFor() {
+    // Leaked on purpose: counted objects may outlive static destruction
+    static TypeStats& stats = registerStats(*new TypeStats(type_name<T>()));
+    return stats;
+}
+
+// Member that counts the instances of the class it is declared in
+template<typename T>
+struct instance_counter {
+    instance_counter() noexcept { statsFor<T>().allocate(sizeof(T)); }
+    instance_counter(const instance_counter&) noexcept : instance_counter() {}
+    instance_counter(instance_counter&&) noexcept : instance_counter() {}
+    instance_counter& operator=(const instance_counter&) noexcept { return *this; }
+    instance_counter& operator=(instance_counter&&) noexcept { return *this; }
+    ~instance_counter() { statsFor<T>().release(sizeof(T)); }
+};
+
+// Wraps a memory resource and counts what goes through it
+class counting_resource : public std::pmr::memory_resource {
+public:
+    explicit counting_resource(std::pmr::memory_resource* upstream) : upstream_(upstream) {}
+
+    std::pmr::memory_resource* upstream() const noexcept { return upstream_; }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* pointer = upstream_->allocate(bytes, alignment);
+        storage().allocate(bytes);
+        return pointer;
+    }
+
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override {
+        upstream_->deallocate(pointer, bytes, alignment);
+        storage().release(bytes);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    static TypeStats& storage() {
+        static TypeStats& stats = registerStats(*new TypeStats("storage (std::pmr)"));
+        return stats;
+    }
+
+    std::pmr::memory_resource* upstream_;
+};
+
+// Resource handed to containers for `resource`; wrappers are never freed,
+// since containers keep using them for as long as they live
+inline std::pmr::memory_resource* count_allocations(std::pmr::memory_resource* resource) noexcept {
+    auto* counted = new (std::nothrow) counting_resource(resource);
+    return counted ? counted : resource;
+}
+
+inline std::pmr::memory_resource* uncounted(std::pmr::memory_resource* resource) noexcept {
+    auto* counted = dynamic_cast<counting_resource*>(resource);
+    return counted ? counted->upstream() : resource;
+}
+
+} // namespace detail
+
+// Every counted type, largest total allocation first
+inline std::vector<MemoryUsage> memory_usage() {
+    std::vector<MemoryUsage> rows;
+    for (detail::TypeStats* stats = detail::statsRegistry().load(std::memory_order_acquire); stats;
+         stats = stats->next) {
+        rows.push_back({
+            std::string(stats->name),
+            stats->allocations.load(std::memory_order_relaxed),
+            stats->bytesAllocated.load(std::memory_order_relaxed),
+            stats->liveObjects.load(std::memory_order_relaxed),
+            stats->liveBytes.load(std::memory_order_relaxed),
+            stats->peakLiveBytes.load(std::memory_order_relaxed),
+        });
+    }
+    std::sort(rows.begin(), rows.end(), [](const MemoryUsage& a, const MemoryUsage& b) {
+        return a.bytesAllocated > b.bytesAllocated;
+    });
+    return rows;
+}
+
+// Writes the report as a table; stdio so it also works during exit
+inline void print_memory_report(std::FILE* out = stderr) {
+    std::fprintf(out, "%-40s %12s %14s %10s %12s %12s\n", "type", "allocations", "bytes", "live",
+                 "live bytes", "peak bytes");
+    for (const MemoryUsage& row : memory_usage()) {
+        std::fprintf(out, "%-40s %12llu %14llu %10llu %12llu %12llu\n", row.type.c_str(),
+                     static_cast<unsigned long long>(row.allocations),
+                     static_cast<unsigned long long>(row.bytesAllocated),
+                     static_cast<unsigned long long>(row.liveObjects),
+                     static_cast<unsigned long long>(row.liveBytes),
+                     static_cast<unsigned long long>(row.peakLiveBytes));
+    }
+    std::fflush(out);
+}
+
+// Report at exit and, on POSIX, on SIGUSR1. Called by the generated main()
+// before anything else runs; programs with their own main() call it first
+// thing. The signal is blocked for the calling thread (and the threads it
+// starts later) and taken with sigwait() on a watcher thread, so the report
+// is never printed from inside a signal handler. Only the first call counts.
+inline void install_memory_report() {
+    static const bool installed = [] {
+        std::atexit([] { print_memory_report(); });
+#if defined(__unix__) || defined(__APPLE__)
+        sigset_t signals;
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGUSR1);
+        if (pthread_sigmask(SIG_BLOCK, &signals, nullptr) == 0) {
+            std::thread([signals] {
+                int received = 0;
+                while (sigwait(&signals, &received) == 0) {
+                    print_memory_report();
+                }
+            }).detach();
+        }
+#endif
+        return true;
+    }();
+    static_cast<void>(installed);
+}
+
+} // namespace js
+
+#define JS_TRACK_INSTANCES(Type) \
+    [[no_unique_address]] ::js::detail::instance_counter<Type> js_instance_counter_;
+
+#else
+
+namespace js {
+
+inline void install_memory_report() {}
+
+} // namespace js
+
+#define JS_TRACK_INSTANCES(Type)
+
+#endif // JS_MEMORY_STATS
+
+#endif // JS_MEMORY_STATS_H
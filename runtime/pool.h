@@ -0,0 +1,130 @@
+#ifndef JS_POOL_H
+#define JS_POOL_H
+
+// Per-type object pools for classes annotated with /** @pooled */.
+//
+// js::pooled_new<T>() allocates the object together with its shared_ptr
+// control block from a per-thread free list for that type. When the last
+// reference goes away the slot goes back on the list of the releasing thread
+// and is handed out to the next construction instead of being returned to
+// the global allocator.
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace js {
+
+namespace detail {
+
+template<typename T>
+class ObjectPool {
+public:
+    static constexpr size_t maxCached = 1024;  // free slots kept per thread
+
+    static void* allocate() {
+        if (alive()) {
+            List& list = freeList();
+            if (Node* node = list.head) {
+                list.head = node->next;
+                --list.count;
+                return node;
+            }
+        }
+        return ::operator new(slotSize, std::align_val_t(slotAlign));
+    }
+
+    static void deallocate(void* pointer) noexcept {
+        if (alive()) {
+            List& list = freeList();
+            if (list.count < maxCached) {
+                auto* node = static_cast<Node*>(pointer);
+                node->next = list.head;
+                list.head = node;
+                ++list.count;
+                return;
+            }
+        }
+        ::operator delete(pointer, std::align_val_t(slotAlign));
+    }
+
+private:
+    struct Node {
+        Node* next;
+    };
+
+    static constexpr size_t slotSize = sizeof(T) < sizeof(Node) ? sizeof(Node) : sizeof(T);
+    static constexpr size_t slotAlign = alignof(T) < alignof(Node) ? alignof(Node) : alignof(T);
+
+    struct List {
+        Node* head = nullptr;
+        size_t count = 0;
+
+        ~List() {
+            alive() = false;
+            while (head) {
+                Node* next = head->next;
+                ::operator delete(head, std::align_val_t(slotAlign));
+                head = next;
+            }
+        }
+    };
+
+    // Slots freed during thread teardown bypass the (destroyed) list
+    static bool& alive() {
+        thread_local bool value = true;
+        return value;
+    }
+
+    static List& freeList() {
+        thread_local List list;
+        return list;
+    }
+};
+
+} // namespace detail
+
+// Allocator that recycles single-object allocations through ObjectPool<T>
+template<typename T>
+class pool_allocator {
+public:
+    using value_type = T;
+
+    pool_allocator() noexcept = default;
+
+    template<typename U>
+    pool_allocator(const pool_allocator<U>&) noexcept {}
+
+    T* allocate(size_t count) {
+        if (count == 1) {
+            return static_cast<T*>(detail::ObjectPool<T>::allocate());
+        }
+        return std::allocator<T>().allocate(count);
+    }
+
+    void deallocate(T* pointer, size_t count) noexcept {
+        if (count == 1) {
+            detail::ObjectPool<T>::deallocate(pointer);
+        } else {
+            std::allocator<T>().deallocate(pointer, count);
+        }
+    }
+
+    template<typename U>
+    bool operator==(const pool_allocator<U>&) const noexcept { return true; }
+
+    template<typename U>
+    bool operator!=(const pool_allocator<U>&) const noexcept { return false; }
+};
+
+// Construction of @pooled classes; the pool is keyed on the combined
+// object/control-block type that allocate_shared requests
+template<typename T, typename... Args>
+std::shared_ptr<T> pooled_new(Args&&... args) {
+    return std::allocate_shared<T>(pool_allocator<T>(), std::forward<Args>(args)...);
+}
+
+} // namespace js
+
+#endif // JS_POOL_H
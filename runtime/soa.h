@@ -0,0 +1,199 @@
+#ifndef JS_SOA_H
+#define JS_SOA_H
+
+// Struct-of-arrays storage for interfaces annotated with /** @soa */.
+//
+// js::soa_array<T> keeps one contiguous column per field of T instead of an
+// array of T, so loops that touch one or two fields stream through exactly
+// those columns and can be vectorized. Element access returns proxy
+// references with the same field names as T, which keeps `arr[i].x` working.
+//
+// The generator describes each annotated struct with a js::soa_layout
+// specialization:
+//
+//     template<>
+//     struct js::soa_layout<Particle> {
+//         static constexpr auto members = std::make_tuple(&Particle::x, &Particle::y);
+//         struct reference { js::number& x; js::number& y; ... };
+//         struct const_reference { const js::number& x; const js::number& y; ... };
+//     };
+//
+// Both proxies are aggregates over the columns in member order and convert
+// to T; `reference` also assigns from T.
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory_resource>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "memory_resource.h"
+
+namespace js {
+
+template<typename T>
+struct soa_layout;
+
+namespace detail {
+
+template<typename MemberPointer>
+struct soa_member;
+
+template<typename Class, typename Field>
+struct soa_member<Field Class::*> {
+    using type = Field;
+};
+
+// std::vector<bool> packs bits and cannot hand out bool&, so boolean
+// columns hold one byte per element
+struct soa_bool {
+    bool value;
+};
+
+template<typename Field>
+using soa_cell_t = std::conditional_t<std::is_same_v<Field, bool>, soa_bool, Field>;
+
+template<typename Field>
+Field& soa_cell(Field& cell) { return cell; }
+template<typename Field>
+const Field& soa_cell(const Field& cell) { return cell; }
+inline bool& soa_cell(soa_bool& cell) { return cell.value; }
+inline const bool& soa_cell(const soa_bool& cell) { return cell.value; }
+
+template<typename T, typename Indices>
+struct soa_columns;
+
+template<typename T, size_t... I>
+struct soa_columns<T, std::index_sequence<I...>> {
+    using type = std::tuple<std::pmr::vector<soa_cell_t<
+        typename soa_member<std::tuple_element_t<I, std::remove_const_t<
+            decltype(soa_layout<T>::members)>>>::type>>...>;
+};
+
+} // namespace detail
+
+template<typename T>
+class soa_array {
+    static constexpr size_t fieldCount =
+        std::tuple_size_v<std::remove_const_t<decltype(soa_layout<T>::members)>>;
+    using indices = std::make_index_sequence<fieldCount>;
+    using columns_type = typename detail::soa_columns<T, indices>::type;
+
+public:
+    using value_type = T;
+    using reference = typename soa_layout<T>::reference;
+    using const_reference = typename soa_layout<T>::const_reference;
+
+    soa_array() : columns_(makeColumns(indices{})) {}
+    soa_array(std::initializer_list<T> init) : soa_array() {
+        reserve(init.size());
+        for (const T& value : init) push(value);
+    }
+    soa_array(const soa_array& other) : soa_array() { *this = other; }
+    soa_array(soa_array&&) = default;
+    soa_array& operator=(const soa_array& other) {
+        copyColumns(other, indices{});
+        return *this;
+    }
+    soa_array& operator=(soa_array&&) = default;
+
+    size_t length() const { return size(); }
+    size_t size() const { return std::get<0>(columns_).size(); }
+    bool empty() const { return size() == 0; }
+
+    reference operator[](size_t index) { return row<reference>(columns_, index, indices{}); }
+    const_reference operator[](size_t index) const {
+        return row<const_reference>(columns_, index, indices{});
+    }
+
+    void push(const T& value) { pushRow(value, indices{}); }
+    T pop() {
+        T result = (*this)[size() - 1];
+        std::apply([](auto&... column) { (column.pop_back(), ...); }, columns_);
+        return result;
+    }
+
+    void reserve(size_t capacity) {
+        std::apply([capacity](auto&... column) { (column.reserve(capacity), ...); }, columns_);
+    }
+    void clear() {
+        std::apply([](auto&... column) { (column.clear(), ...); }, columns_);
+    }
+
+    // Contiguous storage of the I-th field, in member order (booleans are
+    // stored as detail::soa_bool)
+    template<size_t I>
+    auto& column() { return std::get<I>(columns_); }
+    template<size_t I>
+    const auto& column() const { return std::get<I>(columns_); }
+
+    // Iteration yields proxy references by value
+    template<typename Array, typename Reference>
+    class basic_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using reference = Reference;
+
+        basic_iterator(Array* array, size_t index) : array_(array), index_(index) {}
+
+        Reference operator*() const { return (*array_)[index_]; }
+        basic_iterator& operator++() { ++index_; return *this; }
+        basic_iterator operator++(int) { basic_iterator previous = *this; ++index_; return previous; }
+        bool operator==(const basic_iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const basic_iterator& other) const { return index_ != other.index_; }
+
+    private:
+        Array* array_;
+        size_t index_;
+    };
+
+    using iterator = basic_iterator<soa_array, reference>;
+    using const_iterator = basic_iterator<const soa_array, const_reference>;
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    template<typename Func>
+    void forEach(Func&& func) const {
+        for (size_t i = 0; i < size(); ++i) {
+            func(T((*this)[i]));
+        }
+    }
+
+private:
+    template<size_t... I>
+    static columns_type makeColumns(std::index_sequence<I...>) {
+        return columns_type(std::tuple_element_t<I, columns_type>(current_resource())...);
+    }
+
+    template<typename Reference, typename Columns, size_t... I>
+    static Reference row(Columns& columns, size_t index, std::index_sequence<I...>) {
+        return Reference{detail::soa_cell(std::get<I>(columns)[index])...};
+    }
+
+    template<size_t... I>
+    void pushRow(const T& value, std::index_sequence<I...>) {
+        (std::get<I>(columns_).push_back(
+             typename std::tuple_element_t<I, columns_type>::value_type{
+                 value.*std::get<I>(soa_layout<T>::members)}),
+         ...);
+    }
+
+    template<size_t... I>
+    void copyColumns(const soa_array& other, std::index_sequence<I...>) {
+        ((std::get<I>(columns_) = std::get<I>(other.columns_)), ...);
+    }
+
+    columns_type columns_;
+};
+
+} // namespace js
+
+#endif // JS_SOA_H
@@ -0,0 +1,67 @@
+#ifndef JS_TIMERS_H
+#define JS_TIMERS_H
+
+// setTimeout / clearTimeout and a cancellable delay() on top of the event loop.
+
+#include <chrono>
+#include <functional>
+#include <memory>
+
+#include "core/any.h"
+#include "async.h"
+#include "abort.h"
+#include "event_loop.h"
+
+namespace js {
+
+namespace detail {
+
+inline std::chrono::milliseconds toDelay(const number& milliseconds) {
+    double value = milliseconds.value();
+    if (!(value > 0)) return std::chrono::milliseconds(0);  // NaN and negatives run next turn
+    return std::chrono::milliseconds(static_cast<long long>(value));
+}
+
+} // namespace detail
+
+// Run `callback` once after `delay` milliseconds; returns the timer id
+inline number setTimeout(std::function<void()> callback, number delay = number(0)) {
+    auto id = EventLoop::instance().setTimer(detail::toDelay(delay), std::move(callback));
+    return number(static_cast<double>(id));
+}
+
+inline void clearTimeout(number id) {
+    EventLoop::instance().clearTimer(static_cast<EventLoop::timer_id>(id.value()));
+}
+
+// Resolve after `milliseconds`; aborting the signal clears the timer and
+// rejects with the abort reason
+inline std::shared_ptr<Promise<void>> delay(number milliseconds,
+                                            const AbortSignal& signal = AbortSignal()) {
+    if (signal.aborted()) {
+        return Promise<void>::reject(std::make_exception_ptr(signal.reason()));
+    }
+
+    struct State {
+        std::shared_ptr<Promise<void>> promise = std::make_shared<Promise<void>>();
+        EventLoop::timer_id timer = 0;
+        AbortSignal::listener_id listener = 0;
+    };
+    auto state = std::make_shared<State>();
+
+    state->timer = EventLoop::instance().setTimer(detail::toDelay(milliseconds), [state, signal] {
+        signal.removeListener(state->listener);
+        state->promise->resolveWith();
+    });
+    state->listener = signal.onAbort([weak = std::weak_ptr<State>(state)](const any& reason) {
+        if (auto state = weak.lock()) {
+            EventLoop::instance().clearTimer(state->timer);
+            state->promise->rejectWith(std::make_exception_ptr(reason));
+        }
+    });
+    return state->promise;
+}
+
+} // namespace js
+
+#endif // JS_TIMERS_H
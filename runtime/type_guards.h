@@ -1,7 +1,7 @@
 #ifndef TYPESCRIPT2CXX_RUNTIME_TYPE_GUARDS_H
 #define TYPESCRIPT2CXX_RUNTIME_TYPE_GUARDS_H
 
-#include "core.h"
+#include "core/any.h"
 #include <typeinfo>
 #include <algorithm>
 
@@ -1,7 +1,7 @@
 #ifndef TYPESCRIPT2CXX_RUNTIME_TYPED_WRAPPERS_H
 #define TYPESCRIPT2CXX_RUNTIME_TYPED_WRAPPERS_H
 
-#include "core.h"
+#include "core/any.h"
 #include <functional>
 #include <optional>
 #include <sstream>
@@ -7,6 +7,7 @@ import { ParseError } from "../errors.ts";
 import type { SourceLocation } from "../types.ts";
 import { SimpleTypeChecker } from "../type-checker/simple-checker.ts";
 import type { TypeCheckResult } from "../type-checker/types.ts";
+import { defaultProgramHost, type ProgramHost } from "./program-host.ts";
 
 /**
  * Parse options
@@ -47,6 +48,9 @@ export interface ParseOptions {
     /** Custom type mappings */
     typeMappings?: Record<string, string>;
   };
+
+  /** Host to parse through; defaults to the one shared by the whole process */
+  programHost?: ProgramHost;
 }
 
 /**
@@ -62,6 +66,9 @@ export interface ParseResult {
   /** Parse time in ms */
   parseTime: number;
 
+  /** Type check time in ms (0 when the checker was reused) */
+  typeCheckTime: number;
+
   /** Detected features */
   features: DetectedFeatures;
 
@@ -158,6 +165,15 @@ function getScriptTarget(target?: string): ts.ScriptTarget {
   }
 }
 
+/**
+ * Per-source-file results, reused while the host hands out the same tree
+ */
+const analyses = new WeakMap<ts.SourceFile, {
+  features: DetectedFeatures;
+  typeChecker?: SimpleTypeChecker;
+  checkResult?: ReturnType<SimpleTypeChecker["checkSourceFile"]>;
+}>();
+
 /**
  * Parse TypeScript source code
  */
@@ -168,33 +184,18 @@ export function parseTypeScript(
   const startTime = performance.now();
 
   try {
-    // Create source file
+    // Source files and programs come from a long-lived host, so unchanged
+    // files are not parsed again
+    const filename = options.filename ?? "<anonymous>";
+    const host = options.programHost ?? defaultProgramHost;
     const scriptKind = options.tsx ? ts.ScriptKind.TSX : ts.ScriptKind.TS;
-    const sourceFile = ts.createSourceFile(
-      options.filename ?? "<anonymous>",
+    const sourceFile = host.getSourceFile(
+      filename,
       source,
       getScriptTarget(options.target),
-      true, // setParentNodes
       scriptKind,
     );
-
-    // Check for parse errors by creating a program to get diagnostics
-    const program = ts.createProgram([options.filename ?? "<anonymous>"], {
-      target: getScriptTarget(options.target),
-      allowJs: true,
-    }, {
-      getSourceFile: (fileName) =>
-        fileName === (options.filename ?? "<anonymous>") ? sourceFile : undefined,
-      writeFile: () => {},
-      getCurrentDirectory: () => "",
-      getDirectories: () => [],
-      fileExists: () => true,
-      readFile: () => "",
-      getCanonicalFileName: (fileName) => fileName,
-      useCaseSensitiveFileNames: () => true,
-      getNewLine: () => "\n",
-      getDefaultLibFileName: () => "lib.d.ts",
-    });
+    const program = host.getProgram(filename);
 
     const diagnostics = program.getSyntacticDiagnostics(sourceFile);
     if (diagnostics.length > 0) {
@@ -206,8 +207,13 @@ export function parseTypeScript(
       );
     }
 
-    // Detect features
-    const features = detectFeatures(sourceFile);
+    // Features and the type checker only depend on the source file
+    let analysis = analyses.get(sourceFile);
+    if (!analysis) {
+      analysis = { features: detectFeatures(sourceFile) };
+      analyses.set(sourceFile, analysis);
+    }
+    const features = analysis.features;
 
     const parseTime = performance.now() - startTime;
 
@@ -215,11 +221,16 @@ export function parseTypeScript(
     let typeChecker: SimpleTypeChecker | undefined;
     let typeCheckResult: TypeCheckResult | undefined;
 
+    const typeCheckStart = performance.now();
     if (options.typeCheck) {
-      typeChecker = new SimpleTypeChecker(sourceFile);
+      if (!analysis.typeChecker) {
+        analysis.typeChecker = new SimpleTypeChecker(sourceFile);
+        analysis.checkResult = analysis.typeChecker.checkSourceFile();
+      }
+      typeChecker = analysis.typeChecker;
 
       // Simple type check result
-      const checkResult = typeChecker.checkSourceFile();
+      const checkResult = analysis.checkResult!;
       typeCheckResult = {
         hasErrors: checkResult.hasErrors,
         errors: checkResult.errors.map((e) => ({
@@ -234,8 +245,9 @@ export function parseTypeScript(
 
     return {
       ast: sourceFile,
-      filename: options.filename ?? "<anonymous>",
+      filename,
       parseTime,
+      typeCheckTime: performance.now() - typeCheckStart,
       features,
       typeChecker,
       typeCheckResult,
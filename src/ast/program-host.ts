@@ -0,0 +1,149 @@
+/**
+ * Long-lived TypeScript program host
+ *
+ * Parsing used to build a fresh SourceFile and a throwaway ts.Program for
+ * every file. The host keeps both for the lifetime of the process instead,
+ * so the files of a project run and the iterations of a watch session share
+ * them: an unchanged file is neither parsed nor diagnosed again, a changed
+ * file gets a new program built from its previous one (`oldProgram`), and
+ * the default lib files are parsed at most once per process.
+ *
+ * Source files are never updated in place. A changed file gets a new
+ * SourceFile, so trees still held by an earlier transpile stay intact.
+ */
+
+import ts from "typescript";
+
+interface HostEntry {
+  text: string;
+  target: ts.ScriptTarget;
+  scriptKind: ts.ScriptKind;
+  sourceFile: ts.SourceFile;
+  program?: ts.Program;
+}
+
+/**
+ * Lib .d.ts files shared by every host and type checker in the process
+ */
+const libFiles = new Map<string, ts.SourceFile | undefined>();
+
+/**
+ * Parse a default lib file once per path and target
+ */
+export function getLibSourceFile(
+  fileName: string,
+  languageVersion: ts.ScriptTarget | ts.CreateSourceFileOptions,
+): ts.SourceFile | undefined {
+  const target = typeof languageVersion === "object"
+    ? languageVersion.languageVersion
+    : languageVersion;
+  const key = `${target}\0${fileName}`;
+  if (!libFiles.has(key)) {
+    const text = ts.sys?.readFile(fileName);
+    libFiles.set(
+      key,
+      text === undefined ? undefined : ts.createSourceFile(fileName, text, languageVersion, true),
+    );
+  }
+  return libFiles.get(key);
+}
+
+/**
+ * Source files and programs kept across parses
+ */
+export class ProgramHost {
+  private entries = new Map<string, HostEntry>();
+  private compilerOptions: ts.CompilerOptions;
+  private host: ts.CompilerHost;
+
+  constructor(compilerOptions: ts.CompilerOptions = {}) {
+    // Parsing only needs syntactic diagnostics: no lib files, no imports
+    this.compilerOptions = { allowJs: true, noLib: true, noResolve: true, ...compilerOptions };
+    this.host = this.createCompilerHost();
+  }
+
+  /**
+   * Source file for this text, parsed only when the text, target or kind changed
+   */
+  getSourceFile(
+    fileName: string,
+    text: string,
+    target: ts.ScriptTarget,
+    scriptKind: ts.ScriptKind,
+  ): ts.SourceFile {
+    const entry = this.entries.get(fileName);
+    if (
+      entry && entry.text === text && entry.target === target && entry.scriptKind === scriptKind
+    ) {
+      return entry.sourceFile;
+    }
+
+    const sourceFile = ts.createSourceFile(fileName, text, target, true, scriptKind);
+    // Keep the previous program so the next one can reuse it
+    this.entries.set(fileName, {
+      text,
+      target,
+      scriptKind,
+      sourceFile,
+      program: entry?.program,
+    });
+    return sourceFile;
+  }
+
+  /**
+   * Program rooted at a known file, rebuilt from the previous one only when
+   * the file changed
+   */
+  getProgram(fileName: string): ts.Program {
+    const entry = this.entries.get(fileName);
+    if (!entry) {
+      throw new Error(`Unknown file: ${fileName}`);
+    }
+    if (entry.program?.getSourceFile(fileName) === entry.sourceFile) {
+      return entry.program;
+    }
+
+    entry.program = ts.createProgram({
+      rootNames: [fileName],
+      options: { ...this.compilerOptions, target: entry.target },
+      host: this.host,
+      oldProgram: entry.program,
+    });
+    return entry.program;
+  }
+
+  /**
+   * Drop a file, e.g. after it was deleted
+   */
+  forget(fileName: string): void {
+    this.entries.delete(fileName);
+  }
+
+  /** Number of files held */
+  get size(): number {
+    return this.entries.size;
+  }
+
+  private createCompilerHost(): ts.CompilerHost {
+    return {
+      getSourceFile: (fileName, languageVersion) =>
+        this.entries.get(fileName)?.sourceFile ?? getLibSourceFile(fileName, languageVersion),
+      writeFile: () => {},
+      getCurrentDirectory: () => "",
+      getDirectories: () => [],
+      fileExists: (fileName) =>
+        this.entries.has(fileName) || (ts.sys?.fileExists(fileName) ?? false),
+      readFile: (fileName) => this.entries.get(fileName)?.text ?? ts.sys?.readFile(fileName),
+      getCanonicalFileName: (fileName) => fileName,
+      useCaseSensitiveFileNames: () => true,
+      getNewLine: () => "\n",
+      getDefaultLibFileName: (options) =>
+        ts.sys ? ts.getDefaultLibFilePath(options) : "lib.d.ts",
+    };
+  }
+}
+
+/**
+ * Host shared by every parse in the process
+ */
+export const defaultProgramHost = new ProgramHost();
@@ -0,0 +1,108 @@
+/**
+ * Incremental compilation support (experimental.incrementalCompilation)
+ *
+ * Transpile results are cached on disk under a key made of the source
+ * hash, the options hash and the transpiler version, so an unchanged file
+ * skips parsing, type checking and code generation on the next run. Output
+ * files are only rewritten when their content changes, which keeps their
+ * timestamps and lets the C++ build recompile only what really changed.
+ */
+
+import { join } from "@std/path";
+import type { TranspileOptions, TranspileResult } from "./types.ts";
+import { VERSION } from "./mod.ts";
+
+/**
+ * On-disk cache of transpile results, one JSON file per key
+ */
+export class TranspileCache {
+  private used = new Set<string>();
+
+  constructor(readonly directory: string) {}
+
+  /**
+   * Cache key for a source file transpiled with the given options
+   */
+  async key(source: string, options: TranspileOptions): Promise<string> {
+    const [sourceHash, optionsHash] = await Promise.all([
+      sha256(source),
+      sha256(stableStringify(options)),
+    ]);
+    return sha256(`${VERSION}\0${sourceHash}\0${optionsHash}`);
+  }
+
+  /**
+   * Cached result for a key, or undefined when there is none
+   */
+  async get(key: string): Promise<TranspileResult | undefined> {
+    this.used.add(key);
+    try {
+      return JSON.parse(await Deno.readTextFile(this.entryPath(key))) as TranspileResult;
+    } catch {
+      // Missing or unreadable entries are misses
+      return undefined;
+    }
+  }
+
+  async set(key: string, result: TranspileResult): Promise<void> {
+    this.used.add(key);
+    await Deno.mkdir(this.directory, { recursive: true });
+    await Deno.writeTextFile(this.entryPath(key), JSON.stringify(result));
+  }
+
+  /**
+   * Remove the entries this run did not look up, so the cache holds one
+   * entry per file instead of one per edit
+   */
+  async prune(): Promise<void> {
+    try {
+      for await (const entry of Deno.readDir(this.directory)) {
+        if (entry.isFile && entry.name.endsWith(".json")) {
+          if (!this.used.has(entry.name.slice(0, -".json".length))) {
+            await Deno.remove(join(this.directory, entry.name));
+          }
+        }
+      }
+    } catch (error) {
+      if (!(error instanceof Deno.errors.NotFound)) throw error;
+    }
+  }
+
+  private entryPath(key: string): string {
+    return join(this.directory, `${key}.json`);
+  }
+}
+
+/**
+ * Write a file unless it already has this content; returns whether it was written
+ */
+export async function writeIfChanged(path: string, content: string): Promise<boolean> {
+  try {
+    if (await Deno.readTextFile(path) === content) {
+      return false;
+    }
+  } catch (error) {
+    if (!(error instanceof Deno.errors.NotFound)) throw error;
+  }
+  await Deno.writeTextFile(path, content);
+  return true;
+}
+
+async function sha256(text: string): Promise<string> {
+  const digest = await crypto.subtle.digest("SHA-256", new TextEncoder().encode(text));
+  return Array.from(new Uint8Array(digest), (byte) => byte.toString(16).padStart(2, "0")).join("");
+}
+
+/**
+ * JSON with object keys sorted, so equal options hash equally
+ */
+function stableStringify(value: unknown): string {
+  return JSON.stringify(value, (_key, item) => {
+    if (item && typeof item === "object" && !Array.isArray(item)) {
+      return Object.fromEntries(
+        Object.keys(item).sort().map((key) => [key, (item as Record<string, unknown>)[key]]),
+      );
+    }
+    return item;
+  });
+}
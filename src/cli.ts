@@ -37,7 +37,13 @@
  */
 
 import { parseArgs } from "jsr:@std/cli@1/parse-args";
+import { dirname, join, resolve } from "jsr:@std/path@1";
 import { compile, type CompileOptions } from "./compiler.ts";
+import { CMakeBuild } from "./cmake/build.ts";
+import { loadConfig } from "./config/loader.ts";
+import { Profiler } from "./profiler.ts";
+import { transpileProject } from "./project.ts";
+import { DEFAULT_DEBOUNCE_MS, watchProject, watchSourceChanges } from "./watch.ts";
 import { VERSION } from "./mod.ts";
 
 interface CliArgs {
@@ -50,6 +56,11 @@ interface CliArgs {
   verbose?: boolean;
   "dry-run"?: boolean;
   cmake?: boolean;
+  modules?: boolean;
+  unity?: boolean;
+  project?: string;
+  profile?: string;
+  "unity-batch"?: string;
   std?: string;
   readable?: string;
   optimization?: string;
@@ -73,9 +84,11 @@ Options:
   -v, --version       Show version information
   -o, --output <dir>  Output directory (default: .)
   -w, --watch         Watch mode for automatic recompilation
-  -b, --build         Build executable after transpilation
+  -b, --build         Build executable after transpilation (through CMake with --watch)
   -g, --debug         Generate debug information
   --cmake             Generate CMakeLists.txt for CMake build system
+  --project <config>  Transpile every file of the project described by a config file
+  --profile <file>    Write per-phase timings as a Chrome trace (chrome://tracing, Perfetto)
   --verbose           Verbose output
   --dry-run           Show what would be done without doing it
 
@@ -83,14 +96,17 @@ Transpilation Options:
   --std <standard>    C++ standard: c++17, c++20, c++23 (default: c++20)
   --readable <mode>   Code readability: default, debug, minimal, false
   --optimization <O>  Optimization level: O0, O1, O2, O3, Os (default: O2)
-  --memory <strategy> Memory strategy: auto, shared, unique, manual (default: auto)
+  --memory <strategy> Memory strategy: auto, shared, unique, manual, arena (default: auto)
   --runtime <path>    Runtime include path (default: core.h)
+  --modules           Import the runtime as the C++20 module js.runtime (with --cmake)
   --plugin <name>     Load plugin (can be specified multiple times)
 
 Compilation Options:
   --compiler <name>   C++ compiler: clang++, g++, msvc, auto (default: auto)
   -I, --include <dir> Add include directory (can be specified multiple times)
   -l, --lib <name>    Link library (can be specified multiple times)
+  --unity             Compile generated sources in unity batches (with --cmake)
+  --unity-batch <n>   Sources per unity batch (default: 8, 0 for one batch)
 
 Examples:
   typescript2cxx input.ts
@@ -107,7 +123,18 @@ function printVersion() {
 
 async function main() {
   const args = parseArgs(Deno.args, {
-    boolean: ["help", "version", "watch", "build", "debug", "verbose", "dry-run", "cmake"],
+    boolean: [
+      "help",
+      "version",
+      "watch",
+      "build",
+      "debug",
+      "verbose",
+      "dry-run",
+      "cmake",
+      "modules",
+      "unity",
+    ],
     string: [
       "output",
       "std",
@@ -118,6 +145,9 @@ async function main() {
       "compiler",
       "include",
       "lib",
+      "unity-batch",
+      "project",
+      "profile",
     ],
     collect: ["plugin", "include", "lib"],
     alias: {
@@ -142,6 +172,15 @@ async function main() {
     Deno.exit(0);
   }
 
+  if (args.project && args.watch) {
+    await watchProjectFromConfig(args.project, args);
+    return;
+  }
+
+  if (args.project) {
+    Deno.exit(await transpileProjectFromConfig(args.project, args) ? 0 : 1);
+  }
+
   const inputFile = args._[0];
   if (!inputFile) {
     console.error("Error: No input file specified");
@@ -160,34 +199,25 @@ async function main() {
     standard: (args.std as "c++17" | "c++20" | "c++23") ?? "c++20",
     readability: (args.readable as "default" | "debug" | "minimal" | false) ?? "default",
     optimization: (args.optimization as "O0" | "O1" | "O2" | "O3" | "Os") ?? "O2",
-    memoryStrategy: (args.memory as "auto" | "shared" | "unique" | "manual") ?? "auto",
+    memoryStrategy: (args.memory as "auto" | "shared" | "unique" | "manual" | "arena") ?? "auto",
     runtimeInclude: args.runtime as string,
+    useModules: args.modules ?? false,
+    unityBuild: args.unity ?? false,
+    unityBatchSize: args["unity-batch"] !== undefined ? Number(args["unity-batch"]) : undefined,
     plugins: Array.isArray(args.plugin) ? args.plugin : (args.plugin ? [args.plugin] : []),
     compiler: (args.compiler as "clang++" | "g++" | "msvc" | "auto") ?? "auto",
     includePaths: Array.isArray(args.include) ? args.include : (args.include ? [args.include] : []),
     libraries: Array.isArray(args.lib) ? args.lib : (args.lib ? [args.lib] : []),
   };
 
+  const profiler = args.profile ? new Profiler() : undefined;
   try {
     if (args.watch) {
-      // Watch mode
-      console.log(`Watching ${inputFile} for changes...`);
-
-      const watcher = Deno.watchFs([inputFile]);
-
-      // Initial compilation
-      await compileFile(inputFile, options);
-
-      // Watch for changes
-      for await (const event of watcher) {
-        if (event.kind === "modify") {
-          console.log(`\nFile changed, recompiling...`);
-          await compileFile(inputFile, options);
-        }
-      }
+      await watchFile(inputFile, options, profiler, args.profile);
     } else {
       // Single compilation
-      await compileFile(inputFile, options);
+      await compileFile(inputFile, options, profiler);
+      if (profiler) await writeProfile(args.profile!, profiler);
     }
   } catch (error) {
     console.error("Error:", error instanceof Error ? error.message : String(error));
@@ -199,11 +229,16 @@ async function main() {
 }
 
 // Compile file function
-async function compileFile(filePath: string, options: CompileOptions): Promise<void> {
+async function compileFile(
+  filePath: string,
+  options: CompileOptions,
+  profiler?: Profiler,
+): Promise<boolean> {
   try {
     console.log(`Transpiling ${filePath}...`);
 
     const result = await compile(filePath, options);
+    profiler?.add(filePath, result.phases ?? []);
 
     if (result.success) {
       console.log(`✓ Generated ${result.headerPath}`);
@@ -222,6 +257,7 @@ async function compileFile(filePath: string, options: CompileOptions): Promise<v
         console.error(result.output);
       }
     }
+    return result.success;
   } catch (error) {
     console.error(
       "✗ Transpilation failed:",
@@ -230,9 +266,139 @@ async function compileFile(filePath: string, options: CompileOptions): Promise<v
     if (options.verbose && error instanceof Error && error.stack) {
       console.error(error.stack);
     }
+    return false;
   }
 }
 
+// Single-file watch mode; --build keeps a CMake build directory and rebuilds it
+// incrementally instead of compiling everything from scratch each time
+async function watchFile(
+  filePath: string,
+  options: CompileOptions,
+  profiler?: Profiler,
+  profilePath?: string,
+): Promise<void> {
+  const inputPath = resolve(filePath);
+  const outputDir = resolve(options.outputDir ?? ".");
+  const builder = options.buildExecutable
+    ? new CMakeBuild(outputDir, join(outputDir, "build"))
+    : undefined;
+  const compileOptions = builder
+    ? { ...options, buildExecutable: false, generateCMake: true }
+    : options;
+
+  const rebuild = async (startTime: number) => {
+    const compiled = await compileFile(filePath, compileOptions, profiler);
+    const build = compiled && builder ? await builder.build() : undefined;
+    if (build) {
+      profiler?.add(filePath, [{ phase: "compile", start: build.start, duration: build.timeMs }]);
+    }
+    if (profiler) await writeProfile(profilePath!, profiler);
+    if (!build) return;
+    if (!build.success) {
+      console.error("✗ Build failed");
+      console.error(build.output);
+      return;
+    }
+    console.log(
+      `✓ Built in ${build.timeMs.toFixed(0)}ms ` +
+        `(edit → binary ${(performance.now() - startTime).toFixed(0)}ms)`,
+    );
+  };
+
+  await rebuild(performance.now());
+  console.log(`Watching ${filePath} for changes...`);
+  await watchSourceChanges(dirname(inputPath), DEFAULT_DEBOUNCE_MS, async (changed, startTime) => {
+    if (!changed.includes(inputPath)) return;
+    console.log(`\nFile changed, recompiling...`);
+    await rebuild(startTime);
+  });
+}
+
+// Project mode: every file matched by the config's project.include
+async function transpileProjectFromConfig(configPath: string, args: CliArgs): Promise<boolean> {
+  const config = await loadConfig(configPath);
+  const result = await transpileProject(config, {
+    root: dirname(configPath),
+    outputDir: args.output ? resolve(args.output) : undefined,
+    transpileOptions: args.runtime ? { runtimeInclude: args.runtime } : {},
+  });
+  if (args.profile) {
+    const profiler = new Profiler();
+    profiler.addProject(result);
+    await writeProfile(args.profile, profiler);
+  }
+
+  for (const file of result.files) {
+    if (file.error) {
+      console.error(`✗ ${file.module.relativePath}: ${file.error.message}`);
+    } else if (args.verbose) {
+      console.log(`✓ ${file.module.relativePath} → ${file.headerPath}, ${file.sourcePath}`);
+    }
+  }
+  if (result.cmakeListsPath) {
+    console.log(`✓ Generated ${result.cmakeListsPath}`);
+  }
+
+  const failed = result.files.filter((file) => file.error).length;
+  console.log(
+    `${result.files.length - failed}/${result.files.length} files transpiled ` +
+      `in ${result.timeMs.toFixed(0)}ms`,
+  );
+  return failed === 0;
+}
+
+// Project watch mode: only changed modules and their importers are transpiled again
+async function watchProjectFromConfig(configPath: string, args: CliArgs): Promise<void> {
+  const config = await loadConfig(configPath);
+  const profiler = args.profile ? new Profiler() : undefined;
+  await watchProject(config, {
+    root: dirname(configPath),
+    outputDir: args.output ? resolve(args.output) : undefined,
+    transpileOptions: args.runtime ? { runtimeInclude: args.runtime } : {},
+    build: args.build ?? false,
+    onIteration: async ({ changed, result, transpiled, build, latencyMs }) => {
+      if (profiler) {
+        profiler.addProject(result);
+        if (build) {
+          profiler.add("", [{ phase: "compile", start: build.start, duration: build.timeMs }]);
+        }
+        await writeProfile(args.profile!, profiler);
+      }
+      for (const file of result.files) {
+        if (file.error) {
+          console.error(`✗ ${file.module.relativePath}: ${file.error.message}`);
+        }
+      }
+      if (build && !build.success) {
+        console.error("✗ Build failed");
+        console.error(build.output);
+      }
+      const trigger = changed.length > 0 ? `${changed.length} changed, ` : "";
+      const built = build?.success ? `, built in ${build.timeMs.toFixed(0)}ms` : "";
+      console.log(
+        `${trigger}${transpiled}/${result.files.length} modules transpiled${built} ` +
+          `(${build?.success ? "edit → binary" : "total"} ${latencyMs.toFixed(0)}ms)`,
+      );
+      if (changed.length === 0) {
+        console.log(`Watching ${resolve(dirname(configPath))} for changes...`);
+      }
+    },
+    onError: (error) => {
+      console.error("✗ Watch iteration failed:", error instanceof Error ? error.message : error);
+    },
+  });
+}
+
+// Chrome trace of the run so far, plus the time per phase
+async function writeProfile(path: string, profiler: Profiler): Promise<void> {
+  await Deno.writeTextFile(path, profiler.toChromeTrace());
+  const totals = [...profiler.totals()]
+    .map(([phase, ms]) => `${phase} ${ms.toFixed(0)}ms`)
+    .join(", ");
+  console.log(`Profile written to ${path}: ${totals}`);
+}
+
 if (import.meta.main) {
   main().catch((error) => {
     console.error("Fatal error:", error instanceof Error ? error.message : String(error));
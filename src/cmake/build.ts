@@ -0,0 +1,89 @@
+/**
+ * Persistent CMake build directory
+ *
+ * The build directory is configured once and then rebuilt with
+ * `cmake --build`, which recompiles only the translation units whose sources
+ * or headers changed and re-runs the configure step by itself when
+ * CMakeLists.txt changed. Ninja is used when it is installed.
+ */
+
+import { join } from "@std/path";
+import { commandExists } from "../compiler.ts";
+import { epochNow } from "../profiler.ts";
+
+/**
+ * Outcome of one build
+ */
+export interface CMakeBuildResult {
+  success: boolean;
+
+  /** Configure and build output */
+  output: string;
+
+  /** Start of the build in ms since the Unix epoch */
+  start: number;
+
+  /** Wall time of the build in ms */
+  timeMs: number;
+}
+
+/**
+ * A CMake build directory kept across builds
+ */
+export class CMakeBuild {
+  private configured = false;
+
+  constructor(
+    readonly sourceDir: string,
+    readonly buildDir: string,
+    private configureArgs: string[] = [],
+  ) {}
+
+  async build(): Promise<CMakeBuildResult> {
+    const start = epochNow();
+    let output = "";
+
+    if (!this.configured) {
+      // The generator of an existing build directory cannot change
+      const fresh = !(await exists(join(this.buildDir, "CMakeCache.txt")));
+      const generator = fresh && await commandExists("ninja") ? ["-G", "Ninja"] : [];
+      const configure = await run([
+        "-S",
+        this.sourceDir,
+        "-B",
+        this.buildDir,
+        ...generator,
+        ...this.configureArgs,
+      ]);
+      output += configure.output;
+      if (!configure.success) {
+        return { success: false, output, start, timeMs: epochNow() - start };
+      }
+      this.configured = true;
+    }
+
+    const build = await run(["--build", this.buildDir, "--parallel"]);
+    output += build.output;
+    return { success: build.success, output, start, timeMs: epochNow() - start };
+  }
+}
+
+async function run(args: string[]): Promise<{ success: boolean; output: string }> {
+  const { code, stdout, stderr } = await new Deno.Command("cmake", {
+    args,
+    stdout: "piped",
+    stderr: "piped",
+  }).output();
+  const decoder = new TextDecoder();
+  return { success: code === 0, output: decoder.decode(stdout) + decoder.decode(stderr) };
+}
+
+async function exists(path: string): Promise<boolean> {
+  try {
+    await Deno.stat(path);
+    return true;
+  } catch (error) {
+    if (error instanceof Deno.errors.NotFound) return false;
+    throw error;
+  }
+}
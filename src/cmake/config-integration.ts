@@ -3,15 +3,19 @@
  */
 
 import type { TranspilerConfig } from "../config/types.ts";
-import { CMakeGenerator, type CMakeOptions } from "./generator.ts";
+import { CMakeGenerator, type CMakeOptions, DEFAULT_UNITY_BATCH_SIZE } from "./generator.ts";
 
 /**
  * Generate CMakeLists.txt from transpiler configuration
+ *
+ * With a runtime directory the runtime is built as the jsruntime library,
+ * as a C++20 module when experimental.modules is set.
  */
 export function generateCMakeFromConfig(
   config: TranspilerConfig,
   sourceFiles: string[],
   headerFiles: string[],
+  runtimeDir?: string,
 ): string | null {
   // Check if CMake generation is enabled
   if (!config.integration?.cmake?.generate) {
@@ -33,6 +37,10 @@ export function generateCMakeFromConfig(
     findPackages: cmakeConfig.findPackages || [],
     executable: determineExecutable(config),
     outputName: cmakeConfig.outputName || inferOutputName(config, cmakeConfig.projectName),
+    runtimeDir,
+    useModules: config.experimental?.modules ?? false,
+    unityBuild: cmakeConfig.unityBuild ?? false,
+    unityBatchSize: cmakeConfig.unityBatchSize ?? DEFAULT_UNITY_BATCH_SIZE,
   };
 
   const generator = new CMakeGenerator(options);
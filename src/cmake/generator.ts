@@ -3,6 +3,9 @@
  * Generates CMakeLists.txt for C++ projects
  */
 
+/** Sources per unity translation unit unless configured (CMake's own default) */
+export const DEFAULT_UNITY_BATCH_SIZE = 8;
+
 export interface CMakeOptions {
   projectName: string;
   minimumVersion?: string;
@@ -15,6 +18,16 @@ export interface CMakeOptions {
   executable?: boolean;
   libraryType?: "STATIC" | "SHARED" | "INTERFACE";
   outputName?: string;
+  /** Runtime directory; its core.cpp is built as the jsruntime library the target links */
+  runtimeDir?: string;
+  /** Precompile the runtime headers for the target (needs runtimeDir) */
+  precompileHeaders?: boolean;
+  /** Build the runtime as the C++20 module js.runtime (needs runtimeDir and CMake 3.28) */
+  useModules?: boolean;
+  /** Compile the sources as unity (jumbo) translation units */
+  unityBuild?: boolean;
+  /** Sources per unity translation unit (0 puts all of them in one) */
+  unityBatchSize?: number;
 }
 
 export class CMakeGenerator {
@@ -31,6 +44,11 @@ export class CMakeGenerator {
       executable: true,
       libraryType: "STATIC",
       outputName: options.projectName.toLowerCase(),
+      runtimeDir: "",
+      precompileHeaders: true,
+      useModules: false,
+      unityBuild: false,
+      unityBatchSize: DEFAULT_UNITY_BATCH_SIZE,
       ...options,
     };
   }
@@ -38,8 +56,13 @@ export class CMakeGenerator {
   generate(): string {
     const lines: string[] = [];
 
-    // CMake minimum version
-    lines.push(`cmake_minimum_required(VERSION ${this.options.minimumVersion})`);
+    // CMake minimum version; named modules need 3.28
+    const runtimeModule = this.options.useModules && this.options.runtimeDir !== "";
+    const minimumVersion =
+      runtimeModule && compareVersions(this.options.minimumVersion, "3.28") < 0
+        ? "3.28"
+        : this.options.minimumVersion;
+    lines.push(`cmake_minimum_required(VERSION ${minimumVersion})`);
     lines.push(`project(${this.options.projectName})`);
     lines.push("");
 
@@ -59,6 +82,15 @@ export class CMakeGenerator {
     lines.push(`endif()`);
     lines.push("");
 
+    // Runtime allocation counters (runtime/memory_stats.h)
+    lines.push(`option(JS_MEMORY_STATS "Count runtime allocations per type and report them" OFF)`);
+    lines.push(`if(JS_MEMORY_STATS)`);
+    lines.push(`    add_compile_definitions(JS_MEMORY_STATS)`);
+    lines.push(`    find_package(Threads REQUIRED)`);
+    lines.push(`    link_libraries(Threads::Threads)`);
+    lines.push(`endif()`);
+    lines.push("");
+
     // Find packages
     if (this.options.findPackages.length > 0) {
       lines.push(`# Find required packages`);
@@ -79,6 +111,23 @@ export class CMakeGenerator {
       lines.push("");
     }
 
+    // Prebuilt runtime (runtime/core/library.h); JS_RUNTIME_LIBRARY is public so
+    // every target linking it sees the runtime as declarations only
+    if (this.options.runtimeDir) {
+      lines.push(`# Runtime library`);
+      lines.push(`add_library(jsruntime STATIC ${this.options.runtimeDir}/core.cpp)`);
+      lines.push(`target_compile_definitions(jsruntime PUBLIC JS_RUNTIME_LIBRARY)`);
+      if (runtimeModule) {
+        // runtime/js.runtime.cppm; generated sources `import js.runtime;`
+        lines.push(`target_sources(jsruntime PUBLIC`);
+        lines.push(`    FILE_SET CXX_MODULES`);
+        lines.push(`    BASE_DIRS ${this.options.runtimeDir}`);
+        lines.push(`    FILES ${this.options.runtimeDir}/js.runtime.cppm`);
+        lines.push(`)`);
+      }
+      lines.push("");
+    }
+
     // Source files
     lines.push(`# Source files`);
     lines.push(`set(SOURCES`);
@@ -112,16 +161,45 @@ export class CMakeGenerator {
     lines.push("");
 
     // Link libraries
-    if (this.options.libraries.length > 0) {
+    const libraries = this.options.runtimeDir
+      ? ["jsruntime", ...this.options.libraries]
+      : this.options.libraries;
+    if (libraries.length > 0) {
       lines.push(`# Link libraries`);
       lines.push(`target_link_libraries(${this.options.outputName}`);
-      for (const lib of this.options.libraries) {
+      for (const lib of libraries) {
         lines.push(`    ${lib}`);
       }
       lines.push(`)`);
       lines.push("");
     }
 
+    // The whole runtime parsed once per build rather than once per source file
+    if (this.options.runtimeDir && this.options.precompileHeaders && !runtimeModule) {
+      lines.push(`# Precompiled runtime headers`);
+      lines.push(`option(JS_PRECOMPILE_RUNTIME "Precompile the runtime headers" ON)`);
+      lines.push(`if(JS_PRECOMPILE_RUNTIME AND COMMAND target_precompile_headers)`);
+      lines.push(
+        `    target_precompile_headers(${this.options.outputName} PRIVATE ${this.options.runtimeDir}/core.h)`,
+      );
+      lines.push(`endif()`);
+      lines.push("");
+    }
+
+    // Modules share one translation unit per batch: the runtime templates are
+    // instantiated once per batch and calls across modules can be inlined
+    if (this.options.unityBuild) {
+      lines.push(`# Unity build`);
+      lines.push(`option(JS_UNITY_BUILD "Compile sources in unity batches" ON)`);
+      lines.push(`if(JS_UNITY_BUILD)`);
+      lines.push(`    set_target_properties(${this.options.outputName} PROPERTIES`);
+      lines.push(`        UNITY_BUILD ON`);
+      lines.push(`        UNITY_BUILD_BATCH_SIZE ${this.options.unityBatchSize}`);
+      lines.push(`    )`);
+      lines.push(`endif()`);
+      lines.push("");
+    }
+
     // Installation rules
     lines.push(`# Installation`);
     if (this.options.executable) {
@@ -135,6 +213,19 @@ export class CMakeGenerator {
   }
 }
 
+/**
+ * Compare dotted version strings numerically
+ */
+function compareVersions(a: string, b: string): number {
+  const left = a.split(".").map(Number);
+  const right = b.split(".").map(Number);
+  for (let i = 0; i < Math.max(left.length, right.length); i++) {
+    const diff = (left[i] ?? 0) - (right[i] ?? 0);
+    if (diff !== 0) return diff;
+  }
+  return 0;
+}
+
 /**
  * Generate a CMakeLists.txt file for a transpiled TypeScript project
  */
@@ -2,7 +2,7 @@
  * C++ code generator
  */
 
-import { createSourceMap } from "../sourcemap/generator.ts";
+import { createRecordedSourceMap } from "../sourcemap/generator.ts";
 import type { CompilerContext } from "../types.ts";
 import type { Plugin } from "../plugins/types.ts";
 import type { ErrorReporter } from "../errors.ts";
@@ -65,9 +65,13 @@ import type {
   IRUnaryExpression,
   IRVariableDeclaration,
   IRWhileStatement,
+  IRYieldExpression,
 } from "../ir/nodes.ts";
-import { IRNodeKind, MemoryManagement } from "../ir/nodes.ts";
+import { IRNodeKind, MemoryManagement, ParameterPassing } from "../ir/nodes.ts";
+import { getModuleFacts } from "../ir/visitor.ts";
+import { collectStructs, type StructField } from "../ir/structs.ts";
 import type { TranspileOptions } from "../types.ts";
+import { CodeWriter } from "./writer.ts";
 
 /**
  * Generation options
@@ -98,6 +102,9 @@ export interface GenerateResult {
 
   /** Source map (if enabled) */
   sourceMap?: string;
+
+  /** Time spent on the source map in ms, at the end of generation */
+  sourceMapTime?: number;
 }
 
 /**
@@ -122,12 +129,41 @@ type IRClassMemberWithAccess = IRClassMember & {
   isPrivateField?: boolean;
 };
 
+/** Umbrella header with the whole runtime; the default runtime include */
+const RUNTIME_UMBRELLA = "runtime/core.h";
+
+/** Base of every module on the modular runtime (number, string, array, object, any, Error) */
+const RUNTIME_BASE = `"runtime/core/any.h"`;
+
+/**
+ * The rest of the runtime, included when the generated code names it
+ */
+const RUNTIME_HEADERS: ReadonlyArray<readonly [include: string, uses: RegExp]> = [
+  [`"runtime/core/console.h"`, /\bjs::console\b/],
+  [`"runtime/core/operators.h"`, /\bjs::(?:instanceof_op|in_op|delete_property|delete_op)\b/],
+  [`"runtime/core/date.h"`, /\bjs::Date\b/],
+  [`"runtime/core/global.h"`, /\bjs::(?:parseInt|parseFloat|(?:en|de)codeURI(?:Component)?)\b/],
+  [`"runtime/core/math.h"`, /\bjs::Math\b/],
+  [`"runtime/core/symbol.h"`, /\bjs::symbol\b/],
+  [`"runtime/core/bigint.h"`, /\bjs::bigint\b/],
+  [`"runtime/core/function.h"`, /\bjs::(?:function|make_function|lambda)\b/],
+  [
+    `"runtime/core/typed_array.h"`,
+    /\bjs::(?:TypedArray|(?:Big)?(?:Int|Uint|Float)(?:8|16|32|64)(?:Clamped)?Array)\b/,
+  ],
+  [`"runtime/core/object_static.h"`, /\bjs::Object::/],
+  [`"runtime/type_guards.h"`, /\bjs::(?:typeof\w*|to_boolean|is_null_or_undefined|type_guards)\b/],
+  [`"runtime/typed_wrappers.h"`, /\bjs::typed::/],
+  [`"runtime/arena.h"`, /\bjs::(?:ArenaScope|arena_new)\b/],
+  ["<functional>", /\bstd::function\b/],
+];
+
 /**
  * Code generation context
  */
 interface CodeGenContext {
-  /** Current indentation level */
-  indent: number;
+  /** Where statements are written, at its current indentation */
+  writer: CodeWriter;
 
   /** Collected forward declarations */
   forwardDeclarations: Set<string>;
@@ -142,7 +178,7 @@ interface CodeGenContext {
   headerContent: string[];
 
   /** Source content being built */
-  sourceContent: string[];
+  source: CodeWriter;
 
   /** Current namespace */
   namespace?: string;
@@ -162,9 +198,27 @@ interface CodeGenContext {
   /** Current base class name */
   currentBaseClass?: string;
 
+  /** Fields of the current class held through std::weak_ptr */
+  weakFields?: Set<string>;
+
+  /** Fields of the current class holding structs or arrays of structs (name -> type) */
+  structFields?: Map<string, string>;
+
+  /** Variables and parameters in scope holding structs or arrays of structs (name -> type) */
+  structBindings?: Map<string, string>;
+
+  /** Variables and parameters in scope holding generator objects */
+  generatorBindings?: Set<string>;
+
+  /** C++ return type of the function being generated */
+  returnType?: string;
+
   /** Whether we're in an async function */
   isAsync?: boolean;
 
+  /** Whether we're in a generator function */
+  isGenerator?: boolean;
+
   /** Rest parameter mappings (parameter name -> array variable name) */
   restParamMappings?: Map<string, string>;
 
@@ -189,6 +243,24 @@ export function generateCpp(
 class CppGenerator {
   private options: GenerateOptions;
 
+  /** Weak fields per class, inherited fields included */
+  private weakFields = new Map<string, Set<string>>();
+
+  /** Classes annotated `@pooled` in the current module */
+  private pooledClasses = new Set<string>();
+
+  /** Closed interfaces of the current module lowered to structs */
+  private structs = new Map<string, StructField[]>();
+
+  /** Structs annotated `@soa`, whose arrays are js::soa_array */
+  private soaStructs = new Set<string>();
+
+  /** Parameter types of top-level functions, so struct arguments are built in place */
+  private functionParams = new Map<string, string[]>();
+
+  /** Top-level generator functions, whose calls return js::Generator / AsyncGenerator */
+  private generatorFunctions = new Set<string>();
+
   constructor(options: GenerateOptions) {
     this.options = options;
   }
@@ -216,7 +288,7 @@ class CppGenerator {
   private generateModule(module: IRModule, program: IRProgram): GenerateResult {
     // Create context
     const context: CodeGenContext = {
-      indent: 0,
+      writer: new CodeWriter(),
       forwardDeclarations: new Set(),
       includes: new Set([
         "<iostream>",
@@ -229,22 +301,29 @@ class CppGenerator {
       ]),
       typeDefinitions: [],
       headerContent: [],
-      sourceContent: [],
+      source: new CodeWriter(),
       namespaceImports: new Map(),
       userNamespaces: new Set(),
       isHeader: true,
+      structBindings: new Map(),
+      generatorBindings: new Set(),
       options: this.options.options,
     };
 
-    // Add runtime includes
-    const runtimeInclude = this.options.options.runtimeInclude || "runtime/core.h";
-    context.includes.add(`"${runtimeInclude}"`);
+    // Add runtime includes: the default runtime is included header by header
+    // (see RUNTIME_HEADERS below), a custom --runtime header as given
+    const runtimeInclude = this.options.options.runtimeInclude || RUNTIME_UMBRELLA;
+    const modularRuntime = runtimeInclude === RUNTIME_UMBRELLA;
+    context.includes.add(modularRuntime ? RUNTIME_BASE : `"${runtimeInclude}"`);
 
-    // Check if we need async support
-    const hasAsyncFunctions = this.hasAsyncFunctions(module);
-    if (hasAsyncFunctions) {
+    // Async, generator and tuple support, from one walk over the module
+    const facts = getModuleFacts(module);
+    if (facts.hasAsync) {
       context.includes.add(`"runtime/async.h"`);
     }
+    if (facts.hasGenerators) {
+      context.includes.add(`"runtime/generator.h"`);
+    }
 
     // Add module headers
     for (const header of module.headers) {
@@ -253,14 +332,31 @@ class CppGenerator {
 
     // Add program includes
     for (const include of program.includes) {
+      if (modularRuntime && include === RUNTIME_UMBRELLA) continue;
       context.includes.add(include.startsWith("<") ? include : `"${include}"`);
     }
 
     // Add tuple include if needed
-    if (this.needsTupleInclude(module)) {
+    if (facts.usesTuples) {
       context.includes.add("<tuple>");
     }
 
+    // Pooled classes are constructed through runtime/pool.h
+    this.pooledClasses = this.collectPooledClasses(module);
+    if (this.pooledClasses.size > 0) {
+      context.includes.add(`"runtime/pool.h"`);
+    }
+
+    // Data-only interfaces become plain structs, stored column-wise when marked @soa
+    this.soaStructs = new Set();
+    this.structs = collectStructs(module, (type) => this.mapType(type));
+    this.soaStructs = this.collectSoaStructs(module);
+    if (this.soaStructs.size > 0) {
+      context.includes.add(`"runtime/soa.h"`);
+    }
+    this.functionParams = this.collectFunctionParams(module);
+    this.generatorFunctions = this.collectGeneratorFunctions(module);
+
     // Generate header content
     context.isHeader = true;
     this.generateModuleHeader(module, context);
@@ -269,37 +365,54 @@ class CppGenerator {
     context.isHeader = false;
     this.generateModuleSource(module, context);
 
+    // Cancellation types can reach a module through signatures alone
+    const generated = context.headerContent.join("\n") + context.source.toString();
+    if (/\bjs::Abort(?:Signal|Controller)\b/.test(generated)) {
+      context.includes.add(`"runtime/abort.h"`);
+    }
+
+    // Only the parts of the runtime the module uses
+    if (modularRuntime) {
+      for (const [include, uses] of RUNTIME_HEADERS) {
+        if (uses.test(generated)) {
+          context.includes.add(include);
+        }
+      }
+    }
+
     // Build final header
     const outputName = this.options.options.outputName || module.name || "output";
     const guardName = outputName.toUpperCase().replace(/[^A-Z0-9]/g, "_") + "_H";
 
-    const header = this.buildHeader(guardName, context);
-    const source = this.buildSource(outputName, context);
+    // C++20 modules: the default runtime comes from `import js.runtime;` (runtime/js.runtime.cppm)
+    const importRuntime = modularRuntime && this.options.options.useModules === true;
+
+    const header = this.buildHeader(guardName, context, importRuntime);
+    const sourceWriter = this.buildSource(outputName, context);
+    const source = sourceWriter.toString();
 
     // Generate source map if enabled
     let sourceMap: string | undefined;
+    let sourceMapTime: number | undefined;
     if (this.options.options.sourceMap) {
+      const sourceMapStart = performance.now();
       // Get original source information from options context
       const originalSource =
         (this.options.context as CompilerContext & { originalSource?: string })?.originalSource ||
         "";
       const originalFilename = this.options.options.filename || "input.ts";
 
-      const sourceMaps = createSourceMap(
+      // Statements recorded their positions while the source was written
+      sourceMap = createRecordedSourceMap(
         originalSource,
         originalFilename,
-        header,
-        source,
-        `${outputName}.h`,
+        sourceWriter.mappings,
         `${outputName}.cpp`,
       );
-
-      // For now, return the source file source map
-      // In a full implementation, we'd return both header and source maps
-      sourceMap = sourceMaps.sourceSourceMap;
+      sourceMapTime = performance.now() - sourceMapStart;
     }
 
-    return { header, source, sourceMap };
+    return { header, source, sourceMap, sourceMapTime };
   }
 
   /**
@@ -309,9 +422,9 @@ class CppGenerator {
     // Generate import includes
     this.generateImportIncludes(module, context);
 
-    // First pass: collect forward declarations
-    for (const stmt of module.body) {
-      this.collectForwardDeclarations(stmt, context);
+    // Forward declarations for the top-level classes
+    for (const name of getModuleFacts(module).classNames) {
+      context.forwardDeclarations.add(`class ${name};`);
     }
 
     // Generate forward declarations (already handled in buildHeader)
@@ -332,109 +445,155 @@ class CppGenerator {
    * Generate module source content
    */
   private generateModuleSource(module: IRModule, context: CodeGenContext): void {
-    // Generate implementations
-    const hasMain = this.hasMainFunction(module);
-    const topLevelStatements: string[] = [];
+    const hasMain = getModuleFacts(module).hasMain;
+    const source = context.source;
+
+    // Top-level statements go into Main(), written after the implementations
+    const main = new CodeWriter().indent();
 
     for (const stmt of module.body) {
-      // Only generate implementations for declarations in source file
       if (this.isDeclaration(stmt)) {
-        const code = this.generateStatement(stmt, context);
-        if (code) {
-          context.sourceContent.push(code);
-          context.sourceContent.push("");
+        context.writer = source;
+        const start = source.lineCount;
+        this.emitStatement(stmt, context);
+        if (source.lineCount > start) {
+          source.writeLine();
         }
       } else {
-        // Collect top-level statements to put in Main()
-        const code = this.generateStatement(stmt, context);
-        if (code) {
-          topLevelStatements.push(code);
-        }
+        context.writer = main;
+        this.emitStatement(stmt, context);
       }
     }
+    context.writer = source;
 
     // Generate main function if needed
-    if (!hasMain && topLevelStatements.length > 0) {
-      context.sourceContent.push("// Entry point");
-      context.sourceContent.push("void Main() {");
-      context.indent++;
-
-      // Execute top-level code
-      for (const code of topLevelStatements) {
-        context.sourceContent.push(this.getIndent(context) + code);
+    if (!hasMain && main.lineCount > 0) {
+      source.writeLine("// Entry point");
+      source.writeLine("void Main() {");
+      source.append(main);
+      source.writeLine("}");
+      source.writeLine();
+      source.writeLine("int main(int /*argc*/, char** /*argv*/) {");
+      source.indent();
+      // Allocation report of -DJS_MEMORY_STATS builds (a no-op otherwise)
+      source.writeLine("js::install_memory_report();");
+      source.writeLine("Main();");
+      const eventLoopHeaders = [
+        `"runtime/async.h"`,
+        `"runtime/fs.h"`,
+        `"runtime/timers.h"`,
+        `"runtime/abort.h"`,
+      ];
+      if (eventLoopHeaders.some((header) => context.includes.has(header))) {
+        // Drive pending promises (timers, file I/O) to completion
+        source.writeLine("js::EventLoop::instance().run();");
       }
-
-      context.indent--;
-      context.sourceContent.push("}");
-      context.sourceContent.push("");
-      context.sourceContent.push("int main(int /*argc*/, char** /*argv*/) {");
-      context.sourceContent.push("    Main();");
-      context.sourceContent.push("    return 0;");
-      context.sourceContent.push("}");
+      source.writeLine("return 0;");
+      source.dedent();
+      source.writeLine("}");
     }
   }
 
   /**
-   * Generate statement
+   * Generate a statement as a string, for code that is assembled elsewhere
+   * (header declarations)
    */
   private generateStatement(stmt: IRStatement, context: CodeGenContext): string {
-    switch (stmt.kind) {
-      case IRNodeKind.ImportDeclaration:
-        // Imports are handled in generateImportIncludes
-        return "";
+    return this.captureCode(context, () => this.emitStatement(stmt, context));
+  }
 
-      case IRNodeKind.ExportDeclaration:
-      case IRNodeKind.ExportNamedDeclaration:
-      case IRNodeKind.ExportDefaultDeclaration:
-      case IRNodeKind.ExportAllDeclaration:
-        // Exports don't generate separate code, they just modify declarations
-        return "";
+  /**
+   * Run `emit` against a separate writer and return what it wrote, without
+   * the final newline
+   */
+  private captureCode(context: CodeGenContext, emit: () => void): string {
+    const outer = context.writer;
+    context.writer = new CodeWriter();
+    emit();
+    const code = context.writer.toString();
+    context.writer = outer;
+    return code.endsWith("\n") ? code.slice(0, -1) : code;
+  }
 
+  /**
+   * Write a statement to context.writer as whole lines, at the writer's
+   * current indentation
+   */
+  private emitStatement(stmt: IRStatement, context: CodeGenContext): void {
+    switch (stmt.kind) {
       case IRNodeKind.NamespaceDeclaration:
-        return this.generateNamespace(stmt as IRNamespaceDeclaration, context);
+        return this.emitNamespace(stmt as IRNamespaceDeclaration, context);
 
       case IRNodeKind.FunctionDeclaration:
-        return this.generateFunction(stmt as IRFunctionDeclaration, context);
+        return this.emitFunction(stmt as IRFunctionDeclaration, context);
 
       case IRNodeKind.ClassDeclaration:
-        return this.generateClass(stmt as IRClassDeclaration, context);
-
-      case IRNodeKind.InterfaceDeclaration:
-        return this.generateInterface(stmt as IRInterfaceDeclaration, context);
-
-      case IRNodeKind.EnumDeclaration:
-        return this.generateEnum(stmt as IREnumDeclaration, context);
-
-      case IRNodeKind.VariableDeclaration:
-        return this.generateVariable(stmt as IRVariableDeclaration, context);
+        return this.emitClass(stmt as IRClassDeclaration, context);
 
       case IRNodeKind.BlockStatement:
-        return this.generateBlock(stmt as IRBlockStatement, context);
+        context.writer.mark(stmt.location);
+        this.emitBlock(stmt as IRBlockStatement, context);
+        context.writer.writeLine();
+        return;
 
       case IRNodeKind.IfStatement:
-        return this.generateIf(stmt as IRIfStatement, context);
+        return this.emitIf(stmt as IRIfStatement, context);
 
       case IRNodeKind.SwitchStatement:
-        return this.generateSwitch(stmt as IRSwitchStatement, context);
+        return this.emitSwitch(stmt as IRSwitchStatement, context);
 
       case IRNodeKind.WhileStatement:
-        return this.generateWhile(stmt as IRWhileStatement, context);
+        return this.emitWhile(stmt as IRWhileStatement, context);
 
       case IRNodeKind.ForStatement:
-        return this.generateFor(stmt as IRForStatement, context);
+        return this.emitFor(stmt as IRForStatement, context);
 
       case IRNodeKind.ForOfStatement:
-        return this.generateForOf(stmt as IRForOfStatement, context);
+        return this.emitForOf(stmt as IRForOfStatement, context);
 
       case IRNodeKind.ForInStatement:
-        return this.generateForIn(stmt as IRForInStatement, context);
+        return this.emitForIn(stmt as IRForInStatement, context);
+
+      case IRNodeKind.TryStatement:
+        return this.emitTry(stmt as IRTryStatement, context);
+
+      default: {
+        const code = this.generateSimpleStatement(stmt, context);
+        if (code) {
+          context.writer.mark(stmt.location).writeLine(code);
+        }
+      }
+    }
+  }
+
+  /**
+   * Generate a statement that contains no other statements
+   */
+  private generateSimpleStatement(stmt: IRStatement, context: CodeGenContext): string {
+    switch (stmt.kind) {
+      case IRNodeKind.ImportDeclaration:
+        // Imports are handled in generateImportIncludes
+        return "";
+
+      case IRNodeKind.ExportDeclaration:
+      case IRNodeKind.ExportNamedDeclaration:
+      case IRNodeKind.ExportDefaultDeclaration:
+      case IRNodeKind.ExportAllDeclaration:
+        // Exports don't generate separate code, they just modify declarations
+        return "";
+
+      case IRNodeKind.InterfaceDeclaration:
+        return this.generateInterface(stmt as IRInterfaceDeclaration, context);
+
+      case IRNodeKind.EnumDeclaration:
+        return this.generateEnum(stmt as IREnumDeclaration, context);
+
+      case IRNodeKind.VariableDeclaration:
+        return this.generateVariable(stmt as IRVariableDeclaration, context);
 
       case IRNodeKind.ReturnStatement:
         return this.generateReturn(stmt as IRReturnStatement, context);
 
-      case IRNodeKind.TryStatement:
-        return this.generateTry(stmt as IRTryStatement, context);
-
       case IRNodeKind.ThrowStatement:
         return this.generateThrow(stmt as IRThrowStatement, context);
 
@@ -455,7 +614,8 @@ class CppGenerator {
   /**
    * Generate function
    */
-  private generateFunction(func: IRFunctionDeclaration, context: CodeGenContext): string {
+  private emitFunction(func: IRFunctionDeclaration, context: CodeGenContext): void {
+    const writer = context.writer;
     const name = func.id?.name || "anonymous";
     const params = this.generateParameters(func.params, context);
     let returnType = this.mapType(func.returnType);
@@ -482,8 +642,14 @@ class CppGenerator {
       templateDecl = templateDecl.replace(">\n", ", typename... Args>\n");
     }
 
-    // Handle async functions
-    if (func.isAsync) {
+    // Handle generator functions (function* / async function*)
+    if (func.isGenerator) {
+      const generatorType = func.isAsync ? "js::AsyncGenerator" : "js::Generator";
+      if (!returnType.startsWith(`${generatorType}<`)) {
+        returnType = `${generatorType}<${this.getGeneratorElementType(func.returnType)}>`;
+      }
+    } else if (func.isAsync) {
+      // Handle async functions
       // For async functions, unwrap Promise<T> to get T, then wrap with Task
       let innerType = returnType;
 
@@ -507,22 +673,32 @@ class CppGenerator {
 
     if (context.isHeader) {
       // Generate declaration
-      return `${templateDecl}${returnType} ${name}(${params});`;
+      writer.mark(func.location).writeLine(`${templateDecl}${returnType} ${name}(${params});`);
     } else {
       // Generate implementation (no default parameters in implementation)
       const implParams = this.generateParameters(func.params, context, false);
       const prevAsync = context.isAsync;
+      const prevGenerator = context.isGenerator;
       context.isAsync = func.isAsync;
+      context.isGenerator = func.isGenerator;
+      const leaveScope = this.enterStructScope(
+        func.params,
+        returnType.match(/^js::Task<(.+)>$/)?.[1] ?? returnType,
+        context,
+      );
 
-      const lines: string[] = [];
-      lines.push(`${templateDecl}${returnType} ${name}(${implParams}) {`);
+      writer.mark(func.location).writeLine(`${templateDecl}${returnType} ${name}(${implParams}) {`);
+      writer.indent();
+
+      // Everything allocated during the call is released together on return
+      if (func.arenaScope && context.options.memoryStrategy === "arena") {
+        writer.writeLine("js::ArenaScope arena_scope;");
+      }
 
       // If function has rest parameters, convert variadic pack to array at start of function
       if (hasRestParams) {
         const restParam = func.params.find((p) => p.isRest);
         if (restParam) {
-          context.indent++;
-
           // Extract element type from array type
           let elementType = "js::any";
           const paramType = this.mapType(restParam.type);
@@ -530,58 +706,44 @@ class CppGenerator {
             elementType = paramType.slice(10, -1);
           }
 
-          lines.push(
-            `${
-              this.getIndent(context)
-            }auto ${restParam.name}_array = js::array<${elementType}>{${restParam.name}...};`,
+          writer.writeLine(
+            `auto ${restParam.name}_array = js::array<${elementType}>{${restParam.name}...};`,
           );
           // Store a reference to map rest parameter name to array variable
           context.restParamMappings = context.restParamMappings || new Map();
           context.restParamMappings.set(restParam.name, `${restParam.name}_array`);
-          context.indent--;
         }
       }
 
       if (func.body) {
-        context.indent++;
-
         // For function body, generate the statements inside the block without the block braces
         if (func.body.kind === IRNodeKind.BlockStatement) {
           const block = func.body as IRBlockStatement;
           for (const stmt of block.body) {
-            const code = this.generateStatement(stmt, context);
-            if (code) {
-              lines.push(
-                ...code.split("\n").map((line) => line ? this.getIndent(context) + line : ""),
-              );
-            }
+            this.emitStatement(stmt, context);
           }
         } else {
           // Single statement function body
-          const bodyCode = this.generateStatement(func.body, context);
-          if (bodyCode) {
-            lines.push(
-              ...bodyCode.split("\n").map((line) => line ? this.getIndent(context) + line : ""),
-            );
-          }
+          this.emitStatement(func.body, context);
         }
-
-        context.indent--;
       }
 
-      lines.push("}");
+      writer.dedent();
+      writer.writeLine("}");
+      leaveScope();
       context.isAsync = prevAsync;
-      return lines.join("\n");
+      context.isGenerator = prevGenerator;
     }
   }
 
   /**
    * Generate class
    */
-  private generateClass(cls: IRClassDeclaration, context: CodeGenContext): string {
+  private emitClass(cls: IRClassDeclaration, context: CodeGenContext): void {
     const name = cls.id.name;
     const prevClass = context.currentClass;
     const prevBaseClass = context.currentBaseClass;
+    const prevWeakFields = context.weakFields;
     context.currentClass = name;
 
     // Track base class for super calls
@@ -589,6 +751,28 @@ class CppGenerator {
       context.currentBaseClass = this.generateExpression(cls.superClass, context);
     }
 
+    // Weak fields are read through lock()
+    const weakFields = new Set(this.weakFields.get(context.currentBaseClass ?? "") ?? []);
+    for (const member of cls.members) {
+      const prop = member as IRPropertyDefinition;
+      if (member.kind === IRNodeKind.VariableDeclaration && prop.memory === MemoryManagement.Weak) {
+        weakFields.add(this.getPropertyName(prop.key));
+      }
+    }
+    this.weakFields.set(name, weakFields);
+    context.weakFields = weakFields;
+
+    // Struct fields (and arrays of structs) are accessed and assigned as values
+    const prevStructFields = context.structFields;
+    context.structFields = new Map();
+    for (const member of cls.members) {
+      const prop = member as IRPropertyDefinition;
+      const type = member.kind === IRNodeKind.VariableDeclaration ? this.mapType(prop.type) : "";
+      if (this.holdsStructs(type)) {
+        context.structFields.set(this.getPropertyName(prop.key), type);
+      }
+    }
+
     if (context.isHeader) {
       const lines: string[] = [];
 
@@ -658,67 +842,63 @@ class CppGenerator {
       // Generate members by access level
       if (publicMembers.length > 0 || !hasConstructor) {
         lines.push("public:");
-        context.indent++;
 
         // Add default constructor if needed
         if (!hasConstructor) {
-          lines.push(this.getIndent(context) + `${name}() = default;`);
+          lines.push(`    ${name}() = default;`);
         }
 
         for (const member of publicMembers) {
           const code = this.generateClassMember(member, context, cls);
           if (code) {
-            lines.push(this.getIndent(context) + code);
+            lines.push(`    ${code}`);
           }
         }
-        context.indent--;
       }
 
       if (protectedMembers.length > 0) {
         lines.push("protected:");
-        context.indent++;
         for (const member of protectedMembers) {
           const code = this.generateClassMember(member, context, cls);
           if (code) {
-            lines.push(this.getIndent(context) + code);
+            lines.push(`    ${code}`);
           }
         }
-        context.indent--;
       }
 
       if (privateMembers.length > 0) {
         lines.push("private:");
-        context.indent++;
         for (const member of privateMembers) {
           const code = this.generateClassMember(member, context, cls);
           if (code) {
-            lines.push(this.getIndent(context) + code);
+            lines.push(`    ${code}`);
           }
         }
-        context.indent--;
       }
 
       // Add metadata storage if class has decorators
       if (cls.decorators) {
         lines.push("");
         lines.push("public:");
-        context.indent++;
-        lines.push(this.getIndent(context) + `static js::metadata_t _metadata;`);
-        context.indent--;
+        lines.push(`    static js::metadata_t _metadata;`);
       }
 
+      // Instance counters for -DJS_MEMORY_STATS builds (empty otherwise)
+      lines.push(`    JS_TRACK_INSTANCES(${name})`);
       lines.push("};");
       context.currentClass = prevClass;
       context.currentBaseClass = prevBaseClass;
-      return lines.join("\n");
+      context.weakFields = prevWeakFields;
+      context.structFields = prevStructFields;
+      context.writer.mark(cls.location).writeLine(lines.join("\n"));
     } else {
-      // Generate method implementations
-      const lines: string[] = [];
+      // Generate method implementations, separated by blank lines
+      const writer = context.writer;
+      const start = writer.lineCount;
 
       // Generate metadata initialization if class has decorators
       if (cls.decorators) {
-        lines.push(this.generateMetadataInitialization(cls, context));
-        lines.push("");
+        writer.writeLine(this.generateMetadataInitialization(cls, context));
       }
 
       for (const member of cls.members) {
@@ -731,6 +911,9 @@ class CppGenerator {
           if (funcDecl.body && !method.isAbstract) {
             // Generate implementation parameters without defaults
             const implParams = this.generateParameters(funcDecl.params, context, false);
+            if (writer.lineCount > start) {
+              writer.writeLine();
+            }
 
             // Handle constructor specially
             if (methodName === "constructor") {
@@ -754,30 +937,33 @@ class CppGenerator {
               }
 
               ctorLine += " {";
-              lines.push(ctorLine);
+              writer.mark(method.location).writeLine(ctorLine);
             } else {
               const returnType = this.mapType(funcDecl.returnType);
-              lines.push(`${returnType} ${name}::${methodName}(${implParams}) {`);
-            }
-
-            context.indent++;
-            const bodyCode = this.generateStatement(funcDecl.body, context);
-            if (bodyCode) {
-              lines.push(
-                ...bodyCode.split("\n").map((line) => line ? this.getIndent(context) + line : ""),
+              writer.mark(method.location).writeLine(
+                `${returnType} ${name}::${methodName}(${implParams}) {`,
               );
             }
-            context.indent--;
 
-            lines.push("}");
-            lines.push("");
+            const leaveScope = this.enterStructScope(
+              funcDecl.params,
+              methodName === "constructor" ? undefined : this.mapType(funcDecl.returnType),
+              context,
+            );
+            writer.indent();
+            this.emitStatement(funcDecl.body, context);
+            writer.dedent();
+            leaveScope();
+
+            writer.writeLine("}");
           }
         }
       }
 
       context.currentClass = prevClass;
       context.currentBaseClass = prevBaseClass;
-      return lines.join("\n").trim();
+      context.weakFields = prevWeakFields;
+      context.structFields = prevStructFields;
     }
   }
 
@@ -795,6 +981,12 @@ class CppGenerator {
       const name = this.getPropertyName(prop.key);
       let type = this.mapType(prop.type);
 
+      // A weak_ptr is already nullable
+      const nullable = type.match(/^js::typed::Nullable<(.+)>$/);
+      if (nullable && prop.memory === MemoryManagement.Weak) {
+        type = nullable[1];
+      }
+
       // Apply memory management annotations
       type = this.applyMemoryManagement(type, prop.memory);
 
@@ -851,16 +1043,322 @@ class CppGenerator {
   }
 
   /**
-   * Generate interface (as abstract class in C++)
+   * Generate interface (as a struct when closed, otherwise an abstract class in C++)
    */
   private generateInterface(iface: IRInterfaceDeclaration, context: CodeGenContext): string {
     if (context.isHeader) {
       const name = iface.id.name;
+      const fields = this.structs.get(name);
+      if (fields) {
+        return this.generateStruct(name, fields, context);
+      }
       return `// Interface ${name}\nclass I${name} {\npublic:\n    virtual ~I${name}() = default;\n    // TODO: Interface members\n};`;
     }
     return "";
   }
 
+  /**
+   * Generate a closed interface as a plain struct, fields in declaration order
+   */
+  private generateStruct(name: string, fields: StructField[], context: CodeGenContext): string {
+    const lines: string[] = [];
+    lines.push(`// Interface ${name}`);
+    lines.push(`struct ${name} {`);
+    for (const field of fields) {
+      if (field.optional) {
+        lines.push(`    std::optional<${field.type}> ${field.name};`);
+      } else {
+        const init = field.type === "bool" ? " = false" : "";
+        lines.push(`    ${field.type} ${field.name}${init};`);
+      }
+    }
+    lines.push("};");
+
+    // Records of numbers and booleans can be copied as raw bytes
+    if (this.isTriviallyCopyableStruct(name)) {
+      context.includes.add("<type_traits>");
+      lines.push(`static_assert(std::is_trivially_copyable_v<${name}>);`);
+    }
+
+    if (this.soaStructs.has(name)) {
+      lines.push("", this.generateSoaLayout(name, fields));
+    }
+
+    return lines.join("\n");
+  }
+
+  /**
+   * Generate the js::soa_layout specialization of a @soa struct: its members
+   * in declaration order and proxy references with the same field names
+   */
+  private generateSoaLayout(name: string, fields: StructField[]): string {
+    const types = fields.map((field) =>
+      field.optional ? `std::optional<${field.type}>` : field.type
+    );
+    const members = fields.map((field) => `&${name}::${field.name}`).join(", ");
+    const values = fields.map((field) => field.name).join(", ");
+
+    const lines: string[] = [];
+    lines.push(`// Struct-of-arrays layout of ${name} (js::soa_array<${name}>)`);
+    lines.push("template<>");
+    lines.push(`struct js::soa_layout<${name}> {`);
+    lines.push(`    static constexpr auto members = std::make_tuple(${members});`);
+    lines.push("");
+    lines.push("    struct reference {");
+    fields.forEach((field, i) => lines.push(`        ${types[i]}& ${field.name};`));
+    lines.push("");
+    lines.push(`        reference& operator=(const ${name}& value) {`);
+    for (const field of fields) {
+      lines.push(`            this->${field.name} = value.${field.name};`);
+    }
+    lines.push("            return *this;");
+    lines.push("        }");
+    lines.push(
+      `        reference& operator=(const reference& other) { return *this = ${name}(other); }`,
+    );
+    lines.push(`        operator ${name}() const { return ${name}{${values}}; }`);
+    lines.push("    };");
+    lines.push("");
+    lines.push("    struct const_reference {");
+    fields.forEach((field, i) => lines.push(`        const ${types[i]}& ${field.name};`));
+    lines.push("");
+    lines.push(`        operator ${name}() const { return ${name}{${values}}; }`);
+    lines.push("    };");
+    lines.push("};");
+    return lines.join("\n");
+  }
+
+  private isTriviallyCopyableStruct(name: string): boolean {
+    return (this.structs.get(name) ?? []).every((field) =>
+      field.type === "js::number" || field.type === "bool" ||
+      (this.structs.has(field.type) && this.isTriviallyCopyableStruct(field.type))
+    );
+  }
+
+  /**
+   * Collect structs annotated `@soa`. Field types are remapped afterwards so
+   * that arrays of them nested in other structs are column-wise as well.
+   */
+  private collectSoaStructs(module: IRModule): Set<string> {
+    const soaStructs = new Set<string>();
+    for (const stmt of module.body) {
+      if (stmt.kind !== IRNodeKind.InterfaceDeclaration) continue;
+      const iface = stmt as IRInterfaceDeclaration;
+      if (!iface.isSoa) continue;
+
+      if (this.structs.has(iface.id.name)) {
+        soaStructs.add(iface.id.name);
+      } else {
+        this.options.context.warnings.push({
+          code: "SOA_LAYOUT",
+          message: `@soa is ignored on '${iface.id.name}': only interfaces with data fields ` +
+            "of fixed-layout types can be stored column-wise",
+          location: iface.location,
+          severity: "warning",
+        });
+      }
+    }
+
+    this.soaStructs = soaStructs;
+    for (const fields of this.structs.values()) {
+      for (const field of fields) {
+        field.type = this.mapType(field.type);
+      }
+    }
+    return soaStructs;
+  }
+
+  /**
+   * Track struct-typed and generator parameters and the return type of a
+   * function body; returns a callback restoring the enclosing scope
+   */
+  private enterStructScope(
+    params: IRParameter[],
+    returnType: string | undefined,
+    context: CodeGenContext,
+  ): () => void {
+    const prevBindings = context.structBindings;
+    const prevGenerators = context.generatorBindings;
+    const prevReturnType = context.returnType;
+    const bindings = new Map(prevBindings);
+    const generators = new Set(prevGenerators);
+    for (const param of params) {
+      const type = this.mapType(param.type);
+      if (this.holdsStructs(type)) {
+        bindings.set(param.name, type);
+      } else {
+        bindings.delete(param.name);
+      }
+      if (this.isGeneratorType(type)) {
+        generators.add(param.name);
+      } else {
+        generators.delete(param.name);
+      }
+    }
+    context.structBindings = bindings;
+    context.generatorBindings = generators;
+    context.returnType = returnType;
+
+    return () => {
+      context.structBindings = prevBindings;
+      context.generatorBindings = prevGenerators;
+      context.returnType = prevReturnType;
+    };
+  }
+
+  /**
+   * Type of an expression that denotes a struct or an array of structs
+   */
+  private valueTypeOf(expr: IRNode, context: CodeGenContext): string | undefined {
+    if (expr.kind === IRNodeKind.Identifier) {
+      return context.structBindings?.get((expr as IRIdentifier).name);
+    }
+    if (expr.kind !== IRNodeKind.MemberExpression) return undefined;
+
+    const member = expr as IRMemberExpression;
+    if (member.computed) {
+      return this.structElementType(this.valueTypeOf(member.object, context));
+    }
+    if (member.property.kind !== IRNodeKind.Identifier) return undefined;
+    const property = (member.property as IRIdentifier).name;
+    if (member.object.kind === IRNodeKind.ThisExpression) {
+      return context.structFields?.get(property);
+    }
+    const owner = this.structTypeOf(member.object, context);
+    const field = owner ? this.structs.get(owner)?.find((f) => f.name === property) : undefined;
+    return field && !field.optional && this.holdsStructs(field.type) ? field.type : undefined;
+  }
+
+  /**
+   * Struct type of an expression, if it denotes a struct value
+   */
+  private structTypeOf(expr: IRNode, context: CodeGenContext): string | undefined {
+    const type = this.valueTypeOf(expr, context);
+    return type && this.structs.has(type) ? type : undefined;
+  }
+
+  /**
+   * Element struct of a js::array / js::soa_array type
+   */
+  private structElementType(type: string | undefined): string | undefined {
+    const element = type?.match(/^js::(?:soa_)?array<(\w+)>$/)?.[1];
+    return element && this.structs.has(element) ? element : undefined;
+  }
+
+  private holdsStructs(type: string): boolean {
+    return this.structs.has(type) || this.structElementType(type) !== undefined;
+  }
+
+  /**
+   * Generate an expression initializing a value of a known C++ type: object
+   * literals of struct type become aggregates instead of js::object
+   */
+  private generateInitializer(
+    expr: IRExpression,
+    type: string | undefined,
+    context: CodeGenContext,
+  ): string {
+    if (type && expr.kind === IRNodeKind.ObjectExpression && this.structs.has(type)) {
+      const aggregate = this.generateStructLiteral(expr as IRObjectExpression, type, context);
+      if (aggregate) {
+        return aggregate;
+      }
+      this.reportUnfitLiteral(type, expr);
+    }
+
+    const elementType = this.structElementType(type);
+    if (elementType && expr.kind === IRNodeKind.ArrayExpression) {
+      const elements = (expr as IRArrayExpression).elements;
+      if (elements.every((elem) => elem && elem.kind !== IRNodeKind.SpreadElement)) {
+        const values = elements.map((elem) =>
+          this.generateInitializer(elem!, elementType, context)
+        );
+        return `${type}{${values.join(", ")}}`;
+      }
+    }
+
+    return this.generateExpression(expr, context);
+  }
+
+  /**
+   * Generate an object literal as aggregate initialization of a struct, or
+   * null when its shape does not match (spreads, methods, unknown or missing
+   * fields) and it has to stay a js::object
+   */
+  private generateStructLiteral(
+    expr: IRObjectExpression,
+    type: string,
+    context: CodeGenContext,
+  ): string | null {
+    const values = this.structLiteralValues(expr, type);
+    if (!values) return null;
+
+    const initializers: string[] = [];
+    for (const field of this.structs.get(type)!) {
+      // Omitted and undefined optional fields stay std::nullopt
+      const value = values.get(field.name);
+      const isUndefined = value?.kind === IRNodeKind.Identifier &&
+        (value as IRIdentifier).name === "undefined";
+      if (!value || isUndefined) continue;
+      initializers.push(`.${field.name} = ${this.generateInitializer(value, field.type, context)}`);
+    }
+
+    return `${type}{${initializers.join(", ")}}`;
+  }
+
+  /**
+   * Field values of an object literal that fits a struct, or null
+   */
+  private structLiteralValues(
+    expr: IRObjectExpression,
+    type: string,
+  ): Map<string, IRExpression> | null {
+    const fields = this.structs.get(type)!;
+    const values = new Map<string, IRExpression>();
+
+    for (const prop of expr.properties) {
+      if (prop.computed || prop.method || prop.kind !== "init") return null;
+      if (prop.key.kind !== IRNodeKind.Identifier) return null;
+      const key = (prop.key as IRIdentifier).name;
+      if (!fields.some((field) => field.name === key) || values.has(key)) return null;
+      values.set(key, prop.value);
+    }
+    if (fields.some((field) => !field.optional && !values.has(field.name))) return null;
+
+    // Designated initializers run in declaration order; only reorder values
+    // whose evaluation has no side effects
+    const written = [...values.keys()];
+    const declared = fields.map((field) => field.name).filter((name) => values.has(name));
+    const reordered = written.some((name, index) => name !== declared[index]);
+    if (reordered && ![...values.values()].every((value) => this.isSimpleValue(value))) {
+      return null;
+    }
+    return values;
+  }
+
+  /**
+   * Whether an initializer is an object literal that cannot become the
+   * struct it is declared as
+   */
+  private isUnfitStructLiteral(init: IRExpression | undefined, type: string): boolean {
+    return init?.kind === IRNodeKind.ObjectExpression && this.structs.has(type) &&
+      !this.structLiteralValues(init as IRObjectExpression, type);
+  }
+
+  private reportUnfitLiteral(type: string, node: IRNode): void {
+    this.options.context.warnings.push({
+      code: "STRUCT_LITERAL",
+      message: `Object literal does not match the fields of '${type}' ` +
+        "(computed keys, spreads, methods, unknown or missing fields); it stays a js::object",
+      location: node.location,
+      severity: "warning",
+    });
+  }
+
+  private isSimpleValue(expr: IRExpression): boolean {
+    return expr.kind === IRNodeKind.Literal || expr.kind === IRNodeKind.Identifier;
+  }
+
   /**
    * Generate enum declaration
    */
@@ -1028,6 +1526,9 @@ class CppGenerator {
         context,
       );
       const type = decl.cppType;
+      // An intersection keeps the type of its first member, which is not
+      // lowered: the literal has fields of the other members too
+      const lowered = !decl.isIntersection;
       // Check for const declaration or const assertion
       const isConst = varDecl.declarationKind === "const" ||
         (decl.init &&
@@ -1042,33 +1543,57 @@ class CppGenerator {
         }
         // Use the mapped type
         cppType = this.mapType(cppType);
+        if (lowered && this.isUnfitStructLiteral(decl.init, cppType)) {
+          cppType = "js::object";
+        }
         // For arrays with const assertions, use const to make them readonly
         // For regular const declarations, arrays are mutable (JavaScript semantics)
         const hasConstAssertion = decl.init &&
           (decl.init as IRExpression & { isConstAssertion?: boolean }).isConstAssertion;
-        const shouldBeConst = isConst && (!cppType.startsWith("js::array") || hasConstAssertion);
+        // Fields of a const struct binding stay assignable, as in JavaScript
+        const isStruct = this.structs.has(cppType);
+        const shouldBeConst = isConst && !isStruct &&
+          (!cppType.startsWith("js::array") || hasConstAssertion);
         const code = `extern ${shouldBeConst ? "const " : ""}${cppType} ${name};`;
         lines.push(code);
+        this.bindStruct(rawName, lowered ? cppType : "", context);
+        this.bindGenerator(rawName, cppType, decl.init, context);
       } else {
         // In source, define the variable with consistent type
         let cppType = type;
         if (type === "auto" && decl.init) {
           // Use the same inferred type as in header
           cppType = this.inferTypeFromInitializer(decl.init, context);
+        } else if (decl.memory !== MemoryManagement.Auto && decl.memory !== undefined) {
+          // Storage chosen by memory analysis for an annotated local
+          cppType = this.applyMemoryManagement(this.mapType(type), decl.memory);
         }
         // Use the mapped type (this will convert js::string to js::string properly)
         cppType = this.mapType(cppType);
+        // A literal that does not fit its struct is declared as what it is
+        if (lowered && this.isUnfitStructLiteral(decl.init, cppType)) {
+          this.reportUnfitLiteral(cppType, varDecl);
+          cppType = "js::object";
+        }
         // For arrays with const assertions, use const to make them readonly
         // For regular const declarations, arrays are mutable (JavaScript semantics)
         const hasConstAssertion = decl.init &&
           (decl.init as IRExpression & { isConstAssertion?: boolean }).isConstAssertion;
-        const shouldBeConst = isConst && (!cppType.startsWith("js::array") || hasConstAssertion);
+        // A const binding to a stack instance still allows its members to
+        // change, and a uniquely owned one must stay movable
+        const ownsInstance = decl.memory === MemoryManagement.Value ||
+          decl.memory === MemoryManagement.Unique || this.structs.has(cppType);
+        const shouldBeConst = isConst && !ownsInstance &&
+          (!cppType.startsWith("js::array") || hasConstAssertion);
         let code = `${shouldBeConst ? "const " : ""}${cppType} ${name}`;
         if (decl.init) {
-          code += ` = ${this.generateExpression(decl.init, context)}`;
+          const initType = lowered ? cppType : undefined;
+          code += ` = ${this.generateInitializer(decl.init, initType, context)}`;
         }
         code += ";";
         lines.push(code);
+        this.bindStruct(rawName, lowered ? cppType : "", context);
+        this.bindGenerator(rawName, cppType, decl.init, context);
       }
     }
 
@@ -1076,91 +1601,109 @@ class CppGenerator {
   }
 
   /**
-   * Generate block statement
+   * Record whether a declared variable holds a generator object: declared as
+   * one, or initialized by calling a generator function
    */
-  private generateBlock(block: IRBlockStatement, context: CodeGenContext): string {
-    const lines: string[] = [];
+  private bindGenerator(
+    name: string,
+    cppType: string,
+    init: IRExpression | null | undefined,
+    context: CodeGenContext,
+  ): void {
+    if (this.isGeneratorType(cppType) || (init && this.isGeneratorObject(init, context))) {
+      context.generatorBindings?.add(name);
+    } else {
+      context.generatorBindings?.delete(name);
+    }
+  }
 
-    lines.push("{");
-    context.indent++;
+  private isGeneratorType(type: string): boolean {
+    return /^js::(?:Async)?Generator</.test(type);
+  }
 
-    for (const stmt of block.body) {
-      const code = this.generateStatement(stmt, context);
-      if (code) {
-        lines.push(...code.split("\n").map((line) => line ? this.getIndent(context) + line : ""));
-      }
+  /**
+   * Whether an expression denotes a generator object
+   */
+  private isGeneratorObject(expr: IRNode, context: CodeGenContext): boolean {
+    if (expr.kind === IRNodeKind.Identifier) {
+      return context.generatorBindings?.has((expr as IRIdentifier).name) ?? false;
     }
+    const callee = (expr as IRCallExpression).callee;
+    return expr.kind === IRNodeKind.CallExpression && callee.kind === IRNodeKind.Identifier &&
+      this.generatorFunctions.has((callee as IRIdentifier).name);
+  }
 
-    context.indent--;
-    lines.push("}");
+  /**
+   * Record whether a declared variable holds a struct or an array of structs
+   */
+  private bindStruct(name: string, cppType: string, context: CodeGenContext): void {
+    if (this.holdsStructs(cppType)) {
+      context.structBindings?.set(name, cppType);
+    } else {
+      context.structBindings?.delete(name);
+    }
+  }
 
-    return lines.join("\n");
+  /**
+   * Generate block statement; the line is left open after the closing brace
+   */
+  private emitBlock(block: IRBlockStatement, context: CodeGenContext): void {
+    const writer = context.writer;
+    writer.writeLine("{");
+    writer.indent();
+    for (const stmt of block.body) {
+      this.emitStatement(stmt, context);
+    }
+    writer.dedent();
+    writer.write("}");
   }
 
   /**
    * Generate if statement
    */
-  private generateIf(ifStmt: IRIfStatement, context: CodeGenContext): string {
-    const lines: string[] = [];
-
+  private emitIf(ifStmt: IRIfStatement, context: CodeGenContext): void {
+    const writer = context.writer;
     const condition = this.generateExpression(ifStmt.test, context);
-    lines.push(`if (${condition}) {`);
+    writer.mark(ifStmt.location).writeLine(`if (${condition}) {`);
 
-    context.indent++;
-    const thenCode = this.generateStatement(ifStmt.consequent, context);
-    if (thenCode) {
-      lines.push(...thenCode.split("\n").map((line) => line ? this.getIndent(context) + line : ""));
-    }
-    context.indent--;
+    writer.indent();
+    this.emitStatement(ifStmt.consequent, context);
+    writer.dedent();
 
     if (ifStmt.alternate) {
-      lines.push("} else {");
-
-      context.indent++;
-      const elseCode = this.generateStatement(ifStmt.alternate, context);
-      if (elseCode) {
-        lines.push(
-          ...elseCode.split("\n").map((line) => line ? this.getIndent(context) + line : ""),
-        );
-      }
-      context.indent--;
+      writer.writeLine("} else {");
+      writer.indent();
+      this.emitStatement(ifStmt.alternate, context);
+      writer.dedent();
     }
 
-    lines.push("}");
-
-    return lines.join("\n");
+    writer.writeLine("}");
   }
 
   /**
    * Generate switch statement
    */
-  private generateSwitch(switchStmt: IRSwitchStatement, context: CodeGenContext): string {
-    const lines: string[] = [];
-
+  private emitSwitch(switchStmt: IRSwitchStatement, context: CodeGenContext): void {
+    const writer = context.writer;
     const discriminant = this.generateExpression(switchStmt.discriminant, context);
-    lines.push(`switch (${discriminant}) {`);
+    writer.mark(switchStmt.location).writeLine(`switch (${discriminant}) {`);
 
-    context.indent++;
+    writer.indent();
 
     for (const caseClause of switchStmt.cases) {
       if (caseClause.test === null) {
         // Default case
-        lines.push(this.getIndent(context) + "default:");
+        writer.writeLine("default:");
       } else {
         const caseValue = this.generateExpression(caseClause.test, context);
-        lines.push(this.getIndent(context) + `case ${caseValue}:`);
+        writer.writeLine(`case ${caseValue}:`);
       }
 
       // Generate statements for this case
       if (caseClause.consequent.length > 0) {
-        context.indent++;
+        writer.indent();
         for (const stmt of caseClause.consequent) {
-          const code = this.generateStatement(stmt, context);
-          if (code) {
-            lines.push(
-              ...code.split("\n").map((line) => line ? this.getIndent(context) + line : ""),
-            );
-          }
+          this.emitStatement(stmt, context);
         }
 
         // Check if we need to add a break statement
@@ -1178,43 +1721,34 @@ class CppGenerator {
           // However, we'll preserve JavaScript semantics by allowing fall-through
           // unless there's an explicit break
         }
-        context.indent--;
+        writer.dedent();
       }
     }
 
-    context.indent--;
-    lines.push("}");
-
-    return lines.join("\n");
+    writer.dedent();
+    writer.writeLine("}");
   }
 
   /**
    * Generate while statement
    */
-  private generateWhile(whileStmt: IRWhileStatement, context: CodeGenContext): string {
-    const lines: string[] = [];
-
+  private emitWhile(whileStmt: IRWhileStatement, context: CodeGenContext): void {
+    const writer = context.writer;
     const condition = this.generateExpression(whileStmt.test, context);
-    lines.push(`while (${condition}) {`);
-
-    context.indent++;
-    const bodyCode = this.generateStatement(whileStmt.body, context);
-    if (bodyCode) {
-      lines.push(...bodyCode.split("\n").map((line) => line ? this.getIndent(context) + line : ""));
-    }
-    context.indent--;
+    writer.mark(whileStmt.location).writeLine(`while (${condition}) {`);
 
-    lines.push("}");
+    writer.indent();
+    this.emitStatement(whileStmt.body, context);
+    writer.dedent();
 
-    return lines.join("\n");
+    writer.writeLine("}");
   }
 
   /**
    * Generate for statement
    */
-  private generateFor(forStmt: IRForStatement, context: CodeGenContext): string {
-    const lines: string[] = [];
-
+  private emitFor(forStmt: IRForStatement, context: CodeGenContext): void {
+    const writer = context.writer;
     let init = "";
     if (forStmt.init) {
       if (forStmt.init.kind === IRNodeKind.VariableDeclaration) {
@@ -1228,28 +1762,29 @@ class CppGenerator {
     const test = forStmt.test ? this.generateExpression(forStmt.test, context) : "";
     const update = forStmt.update ? this.generateExpression(forStmt.update, context) : "";
 
-    lines.push(`for (${init}; ${test}; ${update}) {`);
+    writer.mark(forStmt.location).writeLine(`for (${init}; ${test}; ${update}) {`);
 
-    context.indent++;
-    const bodyCode = this.generateStatement(forStmt.body, context);
-    if (bodyCode) {
-      lines.push(...bodyCode.split("\n").map((line) => line ? this.getIndent(context) + line : ""));
-    }
-    context.indent--;
-
-    lines.push("}");
+    writer.indent();
+    this.emitStatement(forStmt.body, context);
+    writer.dedent();
 
-    return lines.join("\n");
+    writer.writeLine("}");
   }
 
   /**
    * Generate for...of statement
    */
-  private generateForOf(forOfStmt: IRForOfStatement, context: CodeGenContext): string {
-    const lines: string[] = [];
+  private emitForOf(forOfStmt: IRForOfStatement, context: CodeGenContext): void {
+    if (forOfStmt.isAsync) {
+      return this.emitForAwait(forOfStmt, context);
+    }
+
+    const writer = context.writer;
+    writer.mark(forOfStmt.location);
 
     // Generate the loop variable
     let loopVar = "";
+    const prevBindings = context.structBindings;
 
     if (forOfStmt.left.kind === IRNodeKind.VariableDeclaration) {
       const varDecl = forOfStmt.left as IRVariableDeclaration;
@@ -1262,33 +1797,78 @@ class CppGenerator {
       // For C++, we need to create an iterator-based loop
       const iterableExpr = this.generateExpression(forOfStmt.right, context);
 
-      lines.push(`for (${varKind} auto& ${loopVar} : ${iterableExpr}) {`);
+      // Struct elements stay assignable through the loop variable; @soa
+      // arrays yield proxy references by value
+      const elementType = this.structElementType(this.valueTypeOf(forOfStmt.right, context));
+      if (elementType) {
+        const binding = this.soaStructs.has(elementType) ? "auto&&" : "auto&";
+        writer.writeLine(`for (${binding} ${loopVar} : ${iterableExpr}) {`);
+        context.structBindings = new Map(prevBindings);
+        context.structBindings.set((declarator.id as IRIdentifier).name, elementType);
+      } else {
+        writer.writeLine(`for (${varKind} auto& ${loopVar} : ${iterableExpr}) {`);
+      }
     } else {
       // Handle simple identifier assignment (not full patterns for now)
       const identId = forOfStmt.left as IRIdentifier;
       loopVar = this.generateIdentifier(identId, context);
       const iterableExpr = this.generateExpression(forOfStmt.right, context);
 
-      lines.push(`for (auto& ${loopVar} : ${iterableExpr}) {`);
+      writer.writeLine(`for (auto& ${loopVar} : ${iterableExpr}) {`);
     }
 
-    context.indent++;
-    const bodyCode = this.generateStatement(forOfStmt.body, context);
-    if (bodyCode) {
-      lines.push(...bodyCode.split("\n").map((line) => line ? this.getIndent(context) + line : ""));
-    }
-    context.indent--;
+    writer.indent();
+    this.emitStatement(forOfStmt.body, context);
+    writer.dedent();
+    context.structBindings = prevBindings;
 
-    lines.push("}");
+    writer.writeLine("}");
+  }
 
-    return lines.join("\n");
+  /**
+   * Generate for await...of statement as a co_await-driven loop
+   */
+  private emitForAwait(forOfStmt: IRForOfStatement, context: CodeGenContext): void {
+    let loopVar: string;
+    let binding: string;
+
+    if (forOfStmt.left.kind === IRNodeKind.VariableDeclaration) {
+      const varDecl = forOfStmt.left as IRVariableDeclaration;
+      const declarator = varDecl.declarations[0];
+      loopVar = this.generateIdentifier(declarator.id as IRIdentifier, context);
+      const varKind = varDecl.declarationKind === "const" ? "const " : "";
+      binding = `${varKind}auto& ${loopVar} = ${loopVar}_step.value;`;
+    } else {
+      loopVar = this.generateIdentifier(forOfStmt.left as IRIdentifier, context);
+      binding = `${loopVar} = ${loopVar}_step.value;`;
+    }
+
+    // js::async_iter accepts async generators, channels and ranges of promises
+    const iterableExpr = this.generateExpression(forOfStmt.right, context);
+    const writer = context.writer;
+    writer.mark(forOfStmt.location).writeLine("{");
+    writer.indent();
+    writer.writeLine(`auto&& ${loopVar}_iter = js::async_iter(${iterableExpr});`);
+    writer.writeLine("for (;;) {");
+    writer.indent();
+    writer.writeLine(`auto ${loopVar}_step = co_await ${loopVar}_iter.next();`);
+    writer.writeLine(`if (${loopVar}_step.done) break;`);
+    writer.writeLine(binding);
+
+    this.emitStatement(forOfStmt.body, context);
+
+    writer.dedent();
+    writer.writeLine("}");
+    writer.dedent();
+    writer.writeLine("}");
   }
 
   /**
    * Generate for...in statement
    */
-  private generateForIn(forInStmt: IRForInStatement, context: CodeGenContext): string {
-    const lines: string[] = [];
+  private emitForIn(forInStmt: IRForInStatement, context: CodeGenContext): void {
+    const writer = context.writer;
+    writer.mark(forInStmt.location);
 
     // Generate the loop variable
     let loopVar = "";
@@ -1296,42 +1876,39 @@ class CppGenerator {
       const varDecl = forInStmt.left as IRVariableDeclaration;
       const declarator = varDecl.declarations[0];
       loopVar = this.generateIdentifier(declarator.id as IRIdentifier, context);
-
-      // For C++, we enumerate object properties using a helper
-      const objectExpr = this.generateExpression(forInStmt.right, context);
-
-      lines.push(`for (auto& ${loopVar}_pair : js::Object::entries(${objectExpr})) {`);
-      context.indent++;
-      lines.push(this.getIndent(context) + `auto ${loopVar} = ${loopVar}_pair.first;`);
     } else {
       // Handle simple identifier assignment
-      const identId = forInStmt.left as IRIdentifier;
-      loopVar = this.generateIdentifier(identId, context);
-      const objectExpr = this.generateExpression(forInStmt.right, context);
-
-      lines.push(`for (auto& ${loopVar}_pair : js::Object::entries(${objectExpr})) {`);
-      context.indent++;
-      lines.push(this.getIndent(context) + `auto ${loopVar} = ${loopVar}_pair.first;`);
+      loopVar = this.generateIdentifier(forInStmt.left as IRIdentifier, context);
     }
 
-    context.indent++;
-    const bodyCode = this.generateStatement(forInStmt.body, context);
-    if (bodyCode) {
-      lines.push(...bodyCode.split("\n").map((line) => line ? this.getIndent(context) + line : ""));
-    }
-    context.indent--;
+    // For C++, we enumerate object properties using a helper
+    const objectExpr = this.generateExpression(forInStmt.right, context);
+    writer.writeLine(`for (auto& ${loopVar}_pair : js::Object::entries(${objectExpr})) {`);
+    writer.indent();
+    writer.writeLine(`auto ${loopVar} = ${loopVar}_pair.first;`);
 
-    lines.push("}");
+    this.emitStatement(forInStmt.body, context);
+    writer.dedent();
 
-    return lines.join("\n");
+    writer.writeLine("}");
   }
 
   /**
    * Generate return statement
    */
   private generateReturn(returnStmt: IRReturnStatement, context: CodeGenContext): string {
+    // Generators only signal completion; a return value is not observable in for-of,
+    // but it is still evaluated for its side effects
+    if (context.isGenerator) {
+      if (returnStmt.argument) {
+        const value = this.generateExpression(returnStmt.argument, context);
+        return `static_cast<void>(${value});\nco_return;`;
+      }
+      return "co_return;";
+    }
+
     if (returnStmt.argument) {
-      const value = this.generateExpression(returnStmt.argument, context);
+      const value = this.generateInitializer(returnStmt.argument, context.returnType, context);
 
       // Use co_return for async functions
       if (context.isAsync) {
@@ -1374,35 +1951,36 @@ class CppGenerator {
   /**
    * Generate try statement
    */
-  private generateTry(tryStmt: IRTryStatement, context: CodeGenContext): string {
-    const tryBlock = this.generateBlock(tryStmt.block, context);
-    let result = `try ${tryBlock}`;
+  private emitTry(tryStmt: IRTryStatement, context: CodeGenContext): void {
+    const writer = context.writer;
+    writer.mark(tryStmt.location).write("try ");
+    this.emitBlock(tryStmt.block, context);
 
     if (tryStmt.handler) {
-      const catchBlock = this.generateCatch(tryStmt.handler, context);
-      result += ` ${catchBlock}`;
+      writer.write(" ");
+      this.emitCatch(tryStmt.handler, context);
     }
 
     if (tryStmt.finalizer) {
-      const finallyBlock = this.generateBlock(tryStmt.finalizer, context);
       // C++ doesn't have finally, but we can simulate with RAII
       // For now, we'll add a comment and execute the finally block
-      result += ` /* finally */ ${finallyBlock}`;
+      writer.write(" /* finally */ ");
+      this.emitBlock(tryStmt.finalizer, context);
     }
 
-    return result;
+    writer.writeLine();
   }
 
   /**
-   * Generate catch clause
+   * Generate catch clause; the line is left open after the closing brace
    */
-  private generateCatch(catchClause: IRCatchClause, context: CodeGenContext): string {
+  private emitCatch(catchClause: IRCatchClause, context: CodeGenContext): void {
     // Use js::any as universal exception type for flexibility
     const exceptionType = "js::any";
     const paramName = catchClause.param?.name || "e";
 
-    const catchBody = this.generateBlock(catchClause.body, context);
-    return `catch (const ${exceptionType}& ${paramName}) ${catchBody}`;
+    context.writer.write(`catch (const ${exceptionType}& ${paramName}) `);
+    this.emitBlock(catchClause.body, context);
   }
 
   /**
@@ -1434,8 +2012,11 @@ class CppGenerator {
    */
   private generateExpression(expr: IRExpression, context: CodeGenContext): string {
     switch (expr.kind) {
-      case IRNodeKind.Identifier:
-        return this.generateIdentifier(expr as IRIdentifier, context);
+      case IRNodeKind.Identifier: {
+        const name = this.generateIdentifier(expr as IRIdentifier, context);
+        // Last use that hands ownership on
+        return (expr as IRIdentifier).isMoved ? `std::move(${name})` : name;
+      }
 
       case IRNodeKind.Literal:
         return this.generateLiteral(expr as IRLiteral, context);
@@ -1479,6 +2060,9 @@ class CppGenerator {
       case IRNodeKind.AwaitExpression:
         return this.generateAwait(expr as IRAwaitExpression, context);
 
+      case IRNodeKind.YieldExpression:
+        return this.generateYield(expr as IRYieldExpression, context);
+
       case IRNodeKind.FunctionExpression:
       case IRNodeKind.ArrowFunctionExpression:
         return this.generateLambda(expr as IRFunctionExpression, context);
@@ -1504,6 +2088,27 @@ class CppGenerator {
     return `co_await ${argument}`;
   }
 
+  /**
+   * Generate yield expression
+   */
+  private generateYield(expr: IRYieldExpression, context: CodeGenContext): string {
+    const argument = expr.argument
+      ? this.generateExpression(expr.argument, context)
+      : "js::undefined";
+
+    // yield* re-yields every element of the inner iterable (statement form)
+    if (expr.delegate) {
+      if (context.isAsync) {
+        return `for (auto&& yield_iter = js::async_iter(${argument});;) { ` +
+          `auto yield_step = co_await yield_iter.next(); ` +
+          `if (yield_step.done) break; co_yield std::move(yield_step.value); }`;
+      }
+      return `for (auto&& yield_item : ${argument}) co_yield yield_item`;
+    }
+
+    return `co_yield ${argument}`;
+  }
+
   /**
    * Generate identifier
    */
@@ -1633,12 +2238,28 @@ class CppGenerator {
       "encodeURIComponent": "js::encodeURIComponent",
       "decodeURIComponent": "js::decodeURIComponent",
       "Array": "js::array",
+      "AbortController": "js::AbortController",
+      "AbortSignal": "js::AbortSignal",
+      "setTimeout": "js::setTimeout",
+      "clearTimeout": "js::clearTimeout",
+    };
+
+    // Runtime headers that are only included when their identifiers are used
+    const identifierIncludes: Record<string, string> = {
+      "AbortController": "runtime/abort.h",
+      "AbortSignal": "runtime/abort.h",
+      "setTimeout": "runtime/timers.h",
+      "clearTimeout": "runtime/timers.h",
     };
 
     // Don't map if it's a user-defined namespace
     if (!context.userNamespaces.has(id.name)) {
       const mappedName = identifierMap[id.name];
       if (mappedName) {
+        const include = identifierIncludes[id.name];
+        if (include) {
+          context.includes.add(`"${include}"`);
+        }
         return mappedName;
       }
     }
@@ -1794,12 +2415,76 @@ class CppGenerator {
       return "";
     }
 
+    const combinator = this.mapPromiseCombinator(expr, context);
+    if (combinator) {
+      return combinator;
+    }
+
     const callee = this.generateExpression(expr.callee, context);
-    const args = expr.arguments.map((arg) => this.generateExpression(arg, context));
+
+    // Elements pushed onto struct arrays and struct arguments of module
+    // functions are built in place
+    const member = expr.callee as IRMemberExpression;
+    const elementType = expr.callee.kind === IRNodeKind.MemberExpression && !member.computed &&
+        (member.property as IRIdentifier).name === "push"
+      ? this.structElementType(this.valueTypeOf(member.object, context))
+      : undefined;
+    const paramTypes = expr.callee.kind === IRNodeKind.Identifier
+      ? this.functionParams.get((expr.callee as IRIdentifier).name)
+      : undefined;
+    const args = expr.arguments.map((arg, index) =>
+      this.generateInitializer(arg, elementType ?? paramTypes?.[index], context)
+    );
+
+    // Deno file options objects become the runtime's option structs
+    const options = this.mapFileSystemOptions(expr, callee, context);
+    if (options) {
+      args.splice(options.index, 1, ...(options.code ? [options.code] : []));
+    }
 
     return `${callee}(${args.join(", ")})`;
   }
 
+  /**
+   * Map Promise.all / allSettled / any / race onto the runtime combinators
+   * (runtime/async.h). The elements of an array literal are passed one by
+   * one, so the value type comes from the tasks themselves.
+   */
+  private mapPromiseCombinator(expr: IRCallExpression, context: CodeGenContext): string | null {
+    const member = expr.callee as IRMemberExpression;
+    if (
+      expr.callee.kind !== IRNodeKind.MemberExpression || member.computed ||
+      member.object.kind !== IRNodeKind.Identifier ||
+      (member.object as IRIdentifier).name !== "Promise" ||
+      member.property.kind !== IRNodeKind.Identifier
+    ) {
+      return null;
+    }
+    const combinators: Record<string, string> = {
+      "all": "js::promise_all",
+      "allSettled": "js::promise_all_settled",
+      "any": "js::promise_any",
+      "race": "js::promise_race",
+    };
+    const combinator = combinators[(member.property as IRIdentifier).name];
+    if (!combinator || expr.arguments.length !== 1) {
+      return null;
+    }
+
+    const input = expr.arguments[0];
+    const elements = input.kind === IRNodeKind.ArrayExpression
+      ? (input as IRArrayExpression).elements
+      : undefined;
+    const inputs = elements && elements.every((element) =>
+        element !== null && element.kind !== IRNodeKind.SpreadElement
+      )
+      ? elements.map((element) => this.generateExpression(element!, context))
+      : [this.generateExpression(input, context)];
+
+    context.includes.add(`"runtime/async.h"`);
+    return `${combinator}(${inputs.join(", ")})`;
+  }
+
   /**
    * Generate member expression
    */
@@ -1810,12 +2495,20 @@ class CppGenerator {
     if (!expr.computed && context.namespaceImports.has(object)) {
       const property = this.generateExpression(expr.property, context);
       const namespaceName = context.namespaceImports.get(object);
+      if (namespaceName === "js::fs") {
+        return this.mapFileSystemMember("fs.promises", property, context) ?? `js::fs::${property}`;
+      }
       return `${namespaceName}::${property}`;
     }
 
     if (expr.computed) {
       const property = this.generateExpression(expr.property, context);
 
+      // Elements of struct arrays (proxy references for @soa layouts)
+      if (this.structElementType(this.valueTypeOf(expr.object, context))) {
+        return `${object}[${property}]`;
+      }
+
       // Check if this is enum reverse mapping (e.g., Color[0])
       // If object is a simple identifier starting with uppercase (enum convention)
       // and not a known runtime type, treat it as enum reverse mapping
@@ -1869,9 +2562,39 @@ class CppGenerator {
 
       // Handle special cases for our runtime types
       if (object === "this") {
+        if (context.weakFields?.has(property)) {
+          return `${object}->${property}.lock()`;
+        }
         return `${object}->${property}`;
       }
 
+      // Generator.return() - `return` is a C++ keyword
+      if (property === "return" && this.isGeneratorObject(expr.object, context)) {
+        return `${object}.return_`;
+      }
+
+      // Struct values (closed interfaces) are accessed directly
+      if (this.structTypeOf(expr.object, context)) {
+        return `${object}.${property}`;
+      }
+
+      // Bindings whose storage was chosen by memory analysis
+      if (expr.object.kind === IRNodeKind.Identifier) {
+        const memory = (expr.object as IRIdentifier).memory;
+        if (memory === MemoryManagement.Value) {
+          return `${object}.${property}`;
+        }
+        if (memory === MemoryManagement.Unique || memory === MemoryManagement.Shared) {
+          return `${object}->${property}`;
+        }
+      }
+
+      // Handle Deno / fs.promises file APIs (runtime/fs.h)
+      const fsMember = this.mapFileSystemMember(object, property, context);
+      if (fsMember) {
+        return fsMember;
+      }
+
       // Handle Math static methods
       if (object === "js::Math") {
         return `js::Math::${property}`;
@@ -1892,6 +2615,11 @@ class CppGenerator {
         return `js::Object::${property}`;
       }
 
+      // Handle AbortSignal.abort / timeout / any
+      if (object === "js::AbortSignal") {
+        return `js::AbortSignal::${property}`;
+      }
+
       // Handle static method calls on class names
       // Check if object is a class name (starts with uppercase)
       if (
@@ -2076,8 +2804,13 @@ class CppGenerator {
    * Generate assignment expression
    */
   private generateAssignment(expr: IRAssignmentExpression, context: CodeGenContext): string {
-    const left = this.generateExpression(expr.left, context);
-    const right = this.generateExpression(expr.right, context);
+    // Weak fields are assigned directly, not through lock()
+    const left = this.isWeakFieldAccess(expr.left, context)
+      ? `this->${((expr.left as IRMemberExpression).property as IRIdentifier).name}`
+      : this.generateExpression(expr.left, context);
+    const right = expr.operator === "="
+      ? this.generateInitializer(expr.right, this.structTypeOf(expr.left, context), context)
+      : this.generateExpression(expr.right, context);
 
     // Handle logical assignment operators with short-circuit evaluation
     if (expr.operator === "&&=") {
@@ -2098,6 +2831,17 @@ class CppGenerator {
     return `${left} ${expr.operator} ${right}`;
   }
 
+  /**
+   * Whether an expression is `this.field` for a weak field of the current class
+   */
+  private isWeakFieldAccess(expr: IRNode, context: CodeGenContext): boolean {
+    if (expr.kind !== IRNodeKind.MemberExpression) return false;
+    const member = expr as IRMemberExpression;
+    return !member.computed && member.object.kind === IRNodeKind.ThisExpression &&
+      member.property.kind === IRNodeKind.Identifier &&
+      !!context.weakFields?.has((member.property as IRIdentifier).name);
+  }
+
   /**
    * Generate lambda/arrow function expression
    */
@@ -2119,28 +2863,39 @@ class CppGenerator {
     }).join(", ");
 
     // Generate return type (use auto for type inference if not specified)
-    const returnType = expr.returnType && expr.returnType !== "any"
-      ? ` -> ${this.mapType(expr.returnType)}`
-      : "";
+    const cppReturnType = expr.returnType && expr.returnType !== "any"
+      ? this.mapType(expr.returnType)
+      : undefined;
+    const returnType = cppReturnType ? ` -> ${cppReturnType}` : "";
 
-    // Generate body
-    const bodyLines: string[] = [];
-    for (const stmt of expr.body.body) {
-      bodyLines.push(this.generateStatement(stmt, context));
-    }
-    const body = bodyLines.join("\n");
+    const leaveScope = this.enterStructScope(expr.params, cppReturnType, context);
+    const statements = expr.body.body;
 
-    // Format the lambda
-    if (bodyLines.length === 1 && expr.body.body[0].kind === IRNodeKind.ReturnStatement) {
-      // Simple single-expression lambda
-      const returnStmt = expr.body.body[0] as IRReturnStatement;
+    // Simple single-expression lambda
+    if (statements.length === 1 && statements[0].kind === IRNodeKind.ReturnStatement) {
+      const returnStmt = statements[0] as IRReturnStatement;
       if (returnStmt.argument) {
-        const value = this.generateExpression(returnStmt.argument, context);
+        const value = this.generateInitializer(returnStmt.argument, cppReturnType, context);
+        leaveScope();
         return `${capture}(${params})${returnType} { return ${value}; }`;
       }
     }
 
-    // Multi-line lambda
+    // Multi-line lambda; the enclosing statement indents it as a whole. Its
+    // returns follow the lambda's own kind, not the enclosing function's.
+    const prevAsync = context.isAsync;
+    const prevGenerator = context.isGenerator;
+    context.isAsync = !!expr.isAsync;
+    context.isGenerator = !!expr.isGenerator;
+    const body = this.captureCode(context, () => {
+      context.writer.indent();
+      for (const stmt of statements) {
+        this.emitStatement(stmt, context);
+      }
+    });
+    context.isAsync = prevAsync;
+    context.isGenerator = prevGenerator;
+    leaveScope();
     return `${capture}(${params})${returnType} {\n${body}\n}`;
   }
 
@@ -2322,18 +3077,49 @@ class CppGenerator {
     const args = expr.arguments.map((arg) => this.generateExpression(arg, context));
 
     // Handle runtime types directly (they are value types, not pointers)
-    if (
-      callee === "js::Date" || callee === "js::RegExp" || callee === "js::Error" ||
-      callee === "js::TypeError" || callee === "js::ReferenceError" ||
-      callee === "js::SyntaxError" || callee === "js::RangeError"
-    ) {
+    if (this.isRuntimeValueType(callee)) {
+      return `${callee}(${args.join(", ")})`;
+    }
+
+    // Non-escaping locals live on the stack or in a unique_ptr
+    if (expr.memory === MemoryManagement.Value) {
       return `${callee}(${args.join(", ")})`;
     }
+    if (expr.memory === MemoryManagement.Unique) {
+      return `std::make_unique<${callee}>(${args.join(", ")})`;
+    }
+
+    // Recycle slots of classes constructed at high rates
+    if (this.pooledClasses.has(callee)) {
+      return `js::pooled_new<${callee}>(${args.join(", ")})`;
+    }
+
+    // Allocate from the current arena (heap outside any arena scope)
+    if (context.options.memoryStrategy === "arena") {
+      return `js::arena_new<${callee}>(${args.join(", ")})`;
+    }
 
     // Use make_shared for user-defined classes
     return `std::make_shared<${callee}>(${args.join(", ")})`;
   }
 
+  /**
+   * Check if a constructor produces a runtime value type rather than a pointer
+   */
+  private isRuntimeValueType(className: string): boolean {
+    const valueTypes = [
+      "js::Date",
+      "js::RegExp",
+      "js::Error",
+      "js::TypeError",
+      "js::ReferenceError",
+      "js::SyntaxError",
+      "js::RangeError",
+      "js::AbortController",
+    ];
+    return valueTypes.includes(className);
+  }
+
   /**
    * Generate parameters
    */
@@ -2366,6 +3152,12 @@ class CppGenerator {
       if (param.isOptional && !param.defaultValue) {
         // Optional parameters without default values use std::optional
         paramType = `std::optional<${paramType}>`;
+      } else if (param.passing === ParameterPassing.ConstReference) {
+        // Borrowed parameters are not retained, so skip the copy or refcount traffic
+        paramType = `const ${paramType}&`;
+      } else if (param.passing === ParameterPassing.Reference) {
+        // Written through but not retained: the caller's object is updated in place
+        paramType = `${paramType}&`;
       }
 
       // Add default value if present and allowed
@@ -2386,6 +3178,13 @@ class CppGenerator {
    * Map TypeScript type to C++ type
    */
   private mapType(tsType: string): string {
+    // Arrays of @soa structs are stored field by field
+    const arrayElement = tsType.match(/^(?:js::array<(\w+)>|Array<(\w+)>|(\w+)\[\])$/);
+    const element = arrayElement?.slice(1).find((name) => name !== undefined);
+    if (element && this.soaStructs.has(element)) {
+      return `js::soa_array<${element}>`;
+    }
+
     // If it's already a js:: type, return as-is
     if (tsType.startsWith("js::")) {
       return tsType;
@@ -2430,6 +3229,15 @@ class CppGenerator {
       // Utility types
       "Function": "std::shared_ptr<js::function>",
       "Promise": "js::Promise<js::any>",
+
+      // File system (runtime/fs.h)
+      "Deno.FileInfo": "js::fs::FileInfo",
+      "Deno.FsFile": "js::fs::FileHandle",
+      "FileHandle": "js::fs::FileHandle",
+
+      // Cancellation (runtime/abort.h)
+      "AbortController": "js::AbortController",
+      "AbortSignal": "js::AbortSignal",
     };
 
     // Handle arrays with specific element types
@@ -2501,10 +3309,6 @@ class CppGenerator {
    * Helper methods
    */
 
-  private getIndent(context: CodeGenContext): string {
-    return "    ".repeat(context.indent);
-  }
-
   private isPrimitive(type: string): boolean {
     // Include our custom js:: types that should not have smart pointer wrappers
     return [
@@ -2526,8 +3330,8 @@ class CppGenerator {
   }
 
   private applyMemoryManagement(type: string, memory: MemoryManagement): string {
-    // Don't apply pointer types to primitives
-    if (this.isPrimitive(type) || type === "void") {
+    // Don't apply pointer types to primitives or structs
+    if (this.isPrimitive(type) || type === "void" || this.structs.has(type)) {
       return type;
     }
 
@@ -2563,13 +3367,6 @@ class CppGenerator {
     ].includes(stmt.kind);
   }
 
-  private hasMainFunction(module: IRModule): boolean {
-    return module.body.some((stmt) =>
-      stmt.kind === IRNodeKind.FunctionDeclaration &&
-      (stmt as IRFunctionDeclaration).id?.name === "main"
-    );
-  }
-
   /**
    * Find super constructor call in a block statement
    */
@@ -2606,13 +3403,6 @@ class CppGenerator {
     return true;
   }
 
-  private collectForwardDeclarations(stmt: IRStatement, context: CodeGenContext): void {
-    if (stmt.kind === IRNodeKind.ClassDeclaration) {
-      const cls = stmt as IRClassDeclaration;
-      context.forwardDeclarations.add(`class ${cls.id.name};`);
-    }
-  }
-
   private getPropertyName(key: IRIdentifier | IRLiteral): string {
     if (key.kind === IRNodeKind.Identifier) {
       return key.name;
@@ -2634,21 +3424,33 @@ class CppGenerator {
     return name;
   }
 
-  private buildHeader(guardName: string, context: CodeGenContext): string {
+  private buildHeader(guardName: string, context: CodeGenContext, importRuntime = false): string {
     const lines: string[] = [];
 
     lines.push(`#ifndef ${guardName}`);
     lines.push(`#define ${guardName}`);
     lines.push("");
 
-    // Includes
-    if (context.includes.size > 0) {
-      for (const include of context.includes) {
+    // Includes; an imported runtime replaces the runtime headers, except for
+    // memory_stats.h whose JS_TRACK_INSTANCES macro a module cannot export
+    const includes = importRuntime
+      ? [
+        `"runtime/memory_stats.h"`,
+        ...[...context.includes].filter((include) => !include.startsWith(`"runtime/`)),
+      ]
+      : [...context.includes];
+    if (includes.length > 0) {
+      for (const include of includes) {
         lines.push(`#include ${include}`);
       }
       lines.push("");
     }
 
+    if (importRuntime) {
+      lines.push("import js.runtime;");
+      lines.push("");
+    }
+
     // Using namespace
     lines.push("using namespace js;");
     lines.push("");
@@ -2671,18 +3473,16 @@ class CppGenerator {
     return lines.join("\n");
   }
 
-  private buildSource(outputName: string, context: CodeGenContext): string {
-    const lines: string[] = [];
-
-    lines.push(`#include "${outputName}.h"`);
-    lines.push("");
-    lines.push("using namespace js;");
-    lines.push("");
+  private buildSource(outputName: string, context: CodeGenContext): CodeWriter {
+    const source = new CodeWriter();
 
-    // Content
-    lines.push(...context.sourceContent);
+    source.writeLine(`#include "${outputName}.h"`);
+    source.writeLine();
+    source.writeLine("using namespace js;");
+    source.writeLine();
 
-    return lines.join("\n");
+    // Content, with its source map positions
+    return source.append(context.source);
   }
 
   /**
@@ -2802,9 +3602,16 @@ class CppGenerator {
       const className = this.generateExpression(newExpr.callee, context);
 
       // Runtime types are value types, not smart pointers
-      if (this.isPrimitive(className)) {
+      if (this.isPrimitive(className) || this.isRuntimeValueType(className)) {
+        return className;
+      }
+
+      if (newExpr.memory === MemoryManagement.Value) {
         return className;
       }
+      if (newExpr.memory === MemoryManagement.Unique) {
+        return `std::unique_ptr<${className}>`;
+      }
 
       return `std::shared_ptr<${className}>`;
     }
@@ -3092,7 +3899,6 @@ class CppGenerator {
 
     lines.push(`// Initialize metadata for ${className}`);
     lines.push(`js::metadata_t ${className}::_metadata = {`);
-    context.indent++;
 
     const metadataEntries: string[] = [];
 
@@ -3172,12 +3978,11 @@ class CppGenerator {
 
     for (const entry of metadataEntries) {
       lines.push(
-        this.getIndent(context) + entry +
+        "    " + entry +
           (metadataEntries.indexOf(entry) < metadataEntries.length - 1 ? "," : ""),
       );
     }
 
-    context.indent--;
     lines.push("};");
 
     return lines.join("\n");
@@ -3193,6 +3998,10 @@ class CppGenerator {
 
       // Track namespace imports for member expression generation
       if (importInfo.isNamespace && importInfo.namespace) {
+        if (this.isFileSystemModule(importInfo.from)) {
+          context.namespaceImports.set(importInfo.namespace, "js::fs");
+          continue;
+        }
         // Extract the module name from the path for C++ namespace
         const moduleName = importInfo.from.replace(/^\.\//, "").replace(/\.(ts|js)$/, "");
         context.namespaceImports.set(importInfo.namespace, moduleName);
@@ -3200,12 +4009,160 @@ class CppGenerator {
     }
   }
 
+  /**
+   * Map Deno.* and fs.promises.* file APIs onto the js::fs runtime
+   */
+  private mapFileSystemMember(
+    object: string,
+    property: string,
+    context: CodeGenContext,
+  ): string | null {
+    const fileSystemApis: Record<string, Record<string, string>> = {
+      "Deno": {
+        readFile: "readFile",
+        readTextFile: "readTextFile",
+        writeFile: "writeFile",
+        writeTextFile: "writeTextFile",
+        open: "openFile",
+        stat: "stat",
+      },
+      "fs.promises": {
+        readFile: "readFile",
+        writeFile: "writeFile",
+        appendFile: "appendFile",
+        open: "openFile",
+        stat: "stat",
+      },
+    };
+
+    const mapped = fileSystemApis[object]?.[property];
+    if (!mapped) {
+      return null;
+    }
+    context.includes.add(`"runtime/fs.h"`);
+    return `js::fs::${mapped}`;
+  }
+
+  /**
+   * Translate the options object of Deno.open / writeFile / writeTextFile
+   * into js::fs::OpenOptions or WriteFileOptions. Options that are not an
+   * object literal, and keys the runtime does not know, are dropped with a
+   * warning.
+   */
+  private mapFileSystemOptions(
+    expr: IRCallExpression,
+    callee: string,
+    context: CodeGenContext,
+  ): { index: number; code?: string } | null {
+    const member = expr.callee as IRMemberExpression;
+    if (
+      expr.callee.kind !== IRNodeKind.MemberExpression ||
+      member.object.kind !== IRNodeKind.Identifier ||
+      (member.object as IRIdentifier).name !== "Deno"
+    ) {
+      return null;
+    }
+    const optionTypes: Record<string, { index: number; type: string; fields: string[] }> = {
+      "js::fs::openFile": {
+        index: 1,
+        type: "js::fs::OpenOptions",
+        fields: ["read", "write", "append", "truncate", "create", "createNew", "mode"],
+      },
+      "js::fs::writeFile": {
+        index: 2,
+        type: "js::fs::WriteFileOptions",
+        fields: ["append", "create", "createNew", "mode", "signal"],
+      },
+      "js::fs::writeTextFile": {
+        index: 2,
+        type: "js::fs::WriteFileOptions",
+        fields: ["append", "create", "createNew", "mode", "signal"],
+      },
+    };
+    const target = optionTypes[callee];
+    const arg = expr.arguments[target?.index ?? -1];
+    if (!target || !arg) {
+      return null;
+    }
+
+    const api = `Deno.${(member.property as IRIdentifier).name}`;
+    const warn = (message: string) =>
+      this.options.context.warnings.push({
+        code: "FS_OPTIONS",
+        message,
+        location: expr.location,
+        severity: "warning",
+      });
+    if (arg.kind !== IRNodeKind.ObjectExpression) {
+      warn(`Options of ${api} are only translated from an object literal; they are ignored`);
+      return { index: target.index };
+    }
+
+    const values = new Map<string, string>();
+    for (const prop of (arg as IRObjectExpression).properties) {
+      const key = prop.computed || prop.kind !== "init"
+        ? undefined
+        : prop.key.kind === IRNodeKind.Identifier
+        ? (prop.key as IRIdentifier).name
+        : (prop.key as IRLiteral).value?.toString();
+      if (!key || !target.fields.includes(key)) {
+        warn(`${api} option '${key ?? "(computed)"}' is not supported; it is ignored`);
+        continue;
+      }
+      const value = this.generateExpression(prop.value, context);
+      values.set(key, key === "mode" ? `static_cast<unsigned>((${value}).value())` : value);
+    }
+
+    const fields = target.fields
+      .filter((field) => values.has(field))
+      .map((field) => `.${field} = ${values.get(field)}`);
+    return { index: target.index, code: `${target.type}{${fields.join(", ")}}` };
+  }
+
+  /**
+   * Check if a module specifier refers to Node's file system module
+   */
+  private isFileSystemModule(modulePath: string): boolean {
+    return ["fs", "fs/promises", "node:fs", "node:fs/promises"].includes(modulePath);
+  }
+
+  /**
+   * Extract the yielded element type from a generator return type
+   * (e.g. AsyncGenerator<number, void, unknown> -> js::number)
+   */
+  private getGeneratorElementType(returnType?: string): string {
+    const match = returnType?.match(
+      /^(?:Async)?(?:Generator|Iterable|IterableIterator|Iterator)<(.+)>$/,
+    );
+    if (!match) {
+      return "js::any";
+    }
+
+    // Only the first type argument is the yielded type
+    const args = match[1];
+    let depth = 0;
+    for (let i = 0; i < args.length; i++) {
+      const ch = args[i];
+      if (ch === "<" || ch === "(" || ch === "[" || ch === "{") {
+        depth++;
+      } else if (ch === ">" || ch === ")" || ch === "]" || ch === "}") {
+        depth--;
+      } else if (ch === "," && depth === 0) {
+        return this.mapType(args.slice(0, i).trim());
+      }
+    }
+    return this.mapType(args.trim());
+  }
+
   /**
    * Resolve import path to header path
    */
   private resolveImportPath(modulePath: string): string {
     // Handle different types of imports
-    if (modulePath.startsWith("./") || modulePath.startsWith("../")) {
+    if (this.isFileSystemModule(modulePath)) {
+      // Node file system module - provided by the runtime
+      return `"runtime/fs.h"`;
+    } else if (modulePath.startsWith("./") || modulePath.startsWith("../")) {
       // Relative imports - convert to header includes
       return `"${modulePath.replace(/\.ts$|\.js$/, "")}.h"`;
     } else if (modulePath.startsWith("/")) {
@@ -3218,122 +4175,66 @@ class CppGenerator {
   }
 
   /**
-   * Check if module contains async functions
+   * Parameter types of top-level functions by name
    */
-  private hasAsyncFunctions(module: IRModule): boolean {
-    const checkAsync = (node: IRNode): boolean => {
-      if (!node) return false;
-
-      // Check if it's an async function
-      if (node.kind === IRNodeKind.FunctionDeclaration) {
-        const funcNode = node as IRFunctionDeclaration;
-        if (funcNode.isAsync) {
-          return true;
-        }
-      } else if (
-        node.kind === IRNodeKind.FunctionExpression ||
-        node.kind === IRNodeKind.ArrowFunctionExpression
-      ) {
-        const funcExpr = node as IRFunctionExpression;
-        if (funcExpr.isAsync) {
-          return true;
-        }
-      }
-
-      // Check if it contains await expressions
-      if (node.kind === IRNodeKind.AwaitExpression) {
-        return true;
-      }
-
-      // Recursively check children
-      for (const key in node) {
-        const value = (node as unknown as Record<string, unknown>)[key];
-        if (value && typeof value === "object") {
-          if (Array.isArray(value)) {
-            for (const item of value) {
-              if (checkAsync(item)) return true;
-            }
-          } else {
-            if (checkAsync(value as IRNode)) return true;
-          }
-        }
+  private collectFunctionParams(module: IRModule): Map<string, string[]> {
+    const params = new Map<string, string[]>();
+    for (const stmt of module.body) {
+      const decl = stmt.kind === IRNodeKind.FunctionDeclaration
+        ? stmt
+        : (stmt as { declaration?: IRNode }).declaration;
+      if (decl?.kind !== IRNodeKind.FunctionDeclaration) continue;
+      const func = decl as IRFunctionDeclaration;
+      if (func.id) {
+        // Rest arguments are collected into an array by the callee
+        params.set(
+          func.id.name,
+          func.params.map((param) => param.isRest ? "" : this.mapType(param.type)),
+        );
       }
-
-      return false;
-    };
-
-    return module.body.some((stmt) => checkAsync(stmt));
+    }
+    return params;
   }
 
   /**
-   * Check if module uses tuple types that require <tuple> include
+   * Names of top-level generator functions (`function*`, `async function*`)
    */
-  private needsTupleInclude(module: IRModule): boolean {
-    const checkForTuple = (node: IRNode): boolean => {
-      if (!node) return false;
-
-      // Check for std::tuple in type strings (this won't actually happen since node is IRNode)
-      // Removed this check as it's incorrect
-
-      // Check for tuple types in variable declarations
-      if (node.kind === IRNodeKind.VariableDeclaration) {
-        const varDecl = node as IRVariableDeclaration;
-        if (varDecl.declarations && Array.isArray(varDecl.declarations)) {
-          for (const decl of varDecl.declarations) {
-            if (typeof decl.cppType === "string" && decl.cppType.includes("std::tuple<")) {
-              return true;
-            }
-          }
-        }
-      }
-
-      // Check for tuple types in function parameters and return types
-      if (node.kind === IRNodeKind.FunctionDeclaration) {
-        const funcDecl = node as IRFunctionDeclaration;
-        if (
-          funcDecl.returnType && typeof funcDecl.returnType === "string" &&
-          funcDecl.returnType.includes("std::tuple<")
-        ) {
-          return true;
-        }
-        if (funcDecl.params) {
-          for (const param of funcDecl.params) {
-            if (
-              param.type && typeof param.type === "string" &&
-              param.type.includes("std::tuple<")
-            ) {
-              return true;
-            }
-          }
-        }
+  private collectGeneratorFunctions(module: IRModule): Set<string> {
+    const generators = new Set<string>();
+    for (const stmt of module.body) {
+      const decl = stmt.kind === IRNodeKind.FunctionDeclaration
+        ? stmt
+        : (stmt as { declaration?: IRNode }).declaration;
+      if (decl?.kind !== IRNodeKind.FunctionDeclaration) continue;
+      const func = decl as IRFunctionDeclaration;
+      if (func.id && func.isGenerator) {
+        generators.add(func.id.name);
       }
+    }
+    return generators;
+  }
 
-      // Recursively check all properties
-      for (const key in node) {
-        if (key === "parent") continue; // Skip parent to avoid circular references
-        const value = (node as unknown as Record<string, unknown>)[key];
-        if (value && typeof value === "object") {
-          if (Array.isArray(value)) {
-            for (const item of value) {
-              if (checkForTuple(item)) return true;
-            }
-          } else {
-            if (checkForTuple(value as IRNode)) return true;
-          }
-        }
+  /**
+   * Names of top-level classes annotated `@pooled`
+   */
+  private collectPooledClasses(module: IRModule): Set<string> {
+    const pooled = new Set<string>();
+    for (const stmt of module.body) {
+      const decl = stmt.kind === IRNodeKind.ClassDeclaration
+        ? stmt
+        : (stmt as { declaration?: IRNode }).declaration;
+      if (decl?.kind === IRNodeKind.ClassDeclaration && (decl as IRClassDeclaration).isPooled) {
+        pooled.add((decl as IRClassDeclaration).id.name);
       }
-
-      return false;
-    };
-
-    return module.body.some((stmt) => checkForTuple(stmt));
+    }
+    return pooled;
   }
 
   /**
    * Generate namespace declaration
    */
-  private generateNamespace(ns: IRNamespaceDeclaration, context: CodeGenContext): string {
-    const lines: string[] = [];
+  private emitNamespace(ns: IRNamespaceDeclaration, context: CodeGenContext): void {
+    const writer = context.writer;
 
     // Handle nested namespaces (e.g., A.B.C -> namespace A { namespace B { namespace C { ... } } })
     const namespaces = ns.nested || [ns.name];
@@ -3342,29 +4243,28 @@ class CppGenerator {
     context.userNamespaces.add(ns.name);
 
     // Open namespace declarations
+    writer.mark(ns.location);
     for (const name of namespaces) {
-      lines.push(`${this.getIndent(context)}namespace ${name} {`);
-      context.indent++;
+      writer.writeLine(`namespace ${name} {`);
+      writer.indent();
     }
 
-    lines.push("");
+    writer.writeLine();
 
     // Generate namespace body
     for (const stmt of ns.body) {
-      const stmtCode = this.generateStatement(stmt, context);
-      if (stmtCode) {
-        lines.push(stmtCode);
-        lines.push("");
+      const start = writer.lineCount;
+      this.emitStatement(stmt, context);
+      if (writer.lineCount > start) {
+        writer.writeLine();
       }
     }
 
     // Close namespace declarations
     for (let i = namespaces.length - 1; i >= 0; i--) {
-      context.indent--;
-      lines.push(`${this.getIndent(context)}} // namespace ${namespaces[i]}`);
+      writer.dedent();
+      writer.writeLine(`} // namespace ${namespaces[i]}`);
     }
-
-    return lines.join("\n");
   }
 
   /**
@@ -52,6 +52,18 @@ export class TypeMapper {
       ["BigUint64Array", "js::BigUint64Array"],
       ["ArrayBuffer", "js::ArrayBuffer"],
       ["DataView", "js::DataView"],
+
+      // File system (runtime/fs.h)
+      ["Deno.FileInfo", "js::fs::FileInfo"],
+      ["Deno.FsFile", "js::fs::FileHandle"],
+      ["Stats", "js::fs::FileInfo"],
+      ["fs.Stats", "js::fs::FileInfo"],
+      ["FileHandle", "js::fs::FileHandle"],
+      ["fs.promises.FileHandle", "js::fs::FileHandle"],
+
+      // Cancellation (runtime/abort.h)
+      ["AbortController", "js::AbortController"],
+      ["AbortSignal", "js::AbortSignal"],
     ]);
   }
 
@@ -0,0 +1,155 @@
+/**
+ * Indentation-aware code writer
+ *
+ * Statements are written straight into the output at the writer's current
+ * indentation, instead of being returned as strings and re-indented by every
+ * enclosing statement. Text is kept as a list of chunks and joined once.
+ * While writing, the writer tracks its line and column, so statements can
+ * record where they start for the source map.
+ */
+
+import type { SourceLocation } from "../types.ts";
+import type { SourceMapMapping } from "../sourcemap/generator.ts";
+
+const INDENT_UNIT = "    ";
+
+/**
+ * Indentation strings by level, built on demand
+ */
+const indentation: string[] = [""];
+
+function indentOf(level: number): string {
+  for (let i = indentation.length; i <= level; i++) {
+    indentation.push(indentation[i - 1] + INDENT_UNIT);
+  }
+  return indentation[level];
+}
+
+/**
+ * Appends generated C++ at a current indentation level, tracking positions
+ */
+export class CodeWriter {
+  private chunks: string[] = [];
+  private text?: string;
+  private level = 0;
+  private line = 0;
+  private column = 0;
+  private atLineStart = true;
+
+  /** Generated (0-based) to original (0-based) positions, in write order */
+  readonly mappings: SourceMapMapping[] = [];
+
+  /** Current indentation level */
+  get indentLevel(): number {
+    return this.level;
+  }
+
+  /** Lines started so far */
+  get lineCount(): number {
+    return this.atLineStart ? this.line : this.line + 1;
+  }
+
+  indent(levels = 1): this {
+    this.level += levels;
+    return this;
+  }
+
+  dedent(levels = 1): this {
+    this.level = Math.max(0, this.level - levels);
+    return this;
+  }
+
+  /**
+   * Write text; every non-empty line that starts in it is indented
+   */
+  write(text: string): this {
+    let start = 0;
+    for (;;) {
+      const end = text.indexOf("\n", start);
+      if (end === -1) {
+        this.writeSegment(start === 0 ? text : text.slice(start));
+        return this;
+      }
+      if (end > start) {
+        this.writeSegment(text.slice(start, end));
+      }
+      this.newline();
+      start = end + 1;
+    }
+  }
+
+  /**
+   * Write text and end the line
+   */
+  writeLine(text = ""): this {
+    return this.write(text).newline();
+  }
+
+  /**
+   * Map the next written text to a TypeScript location (1-based)
+   */
+  mark(location?: SourceLocation): this {
+    if (location) {
+      this.mappings.push({
+        generatedLine: this.line,
+        generatedColumn: this.atLineStart ? indentOf(this.level).length : this.column,
+        originalLine: location.line - 1,
+        originalColumn: location.column - 1,
+        source: location.file,
+      });
+    }
+    return this;
+  }
+
+  /**
+   * Append the text and mappings of another writer, starting on a new line
+   */
+  append(other: CodeWriter): this {
+    if (!this.atLineStart) {
+      this.newline();
+    }
+    for (const mapping of other.mappings) {
+      this.mappings.push({ ...mapping, generatedLine: mapping.generatedLine + this.line });
+    }
+    this.push(other.toString());
+    this.line += other.line;
+    this.column = other.column;
+    this.atLineStart = other.atLineStart;
+    return this;
+  }
+
+  toString(): string {
+    if (this.text === undefined) {
+      this.text = this.chunks.join("");
+      this.chunks = [this.text];
+    }
+    return this.text;
+  }
+
+  private writeSegment(segment: string): void {
+    if (!segment) return;
+    if (this.atLineStart) {
+      const prefix = indentOf(this.level);
+      if (prefix) {
+        this.push(prefix);
+        this.column = prefix.length;
+      }
+      this.atLineStart = false;
+    }
+    this.push(segment);
+    this.column += segment.length;
+  }
+
+  private newline(): this {
+    this.push("\n");
+    this.line++;
+    this.column = 0;
+    this.atLineStart = true;
+    return this;
+  }
+
+  private push(chunk: string): void {
+    this.chunks.push(chunk);
+    this.text = undefined;
+  }
+}
@@ -3,9 +3,11 @@
  */
 
 import { transpileFile } from "./transpiler.ts";
-import type { TranspileOptions } from "./types.ts";
-import { generateCMakeLists } from "./cmake/generator.ts";
-import { basename, join } from "jsr:@std/path@1";
+import { writeIfChanged } from "./cache.ts";
+import type { PhaseTiming, TranspileOptions } from "./types.ts";
+import { PhaseTimer } from "./profiler.ts";
+import { DEFAULT_UNITY_BATCH_SIZE, generateCMakeLists } from "./cmake/generator.ts";
+import { basename, dirname, join } from "jsr:@std/path@1";
 
 /**
  * Compile options
@@ -23,6 +25,12 @@ export interface CompileOptions extends TranspileOptions {
   /** Generate CMakeLists.txt */
   generateCMake?: boolean;
 
+  /** Compile the generated sources as unity (jumbo) translation units */
+  unityBuild?: boolean;
+
+  /** Sources per unity translation unit (default: 8, 0 for a single one) */
+  unityBatchSize?: number;
+
   /** C++ compiler to use */
   compiler?: "clang++" | "g++" | "msvc" | "auto";
 
@@ -72,6 +80,9 @@ export interface CompileResult {
 
   /** Success status */
   success: boolean;
+
+  /** Transpile phases followed by writing the outputs and compiling them */
+  phases?: PhaseTiming[];
 }
 
 /**
@@ -94,12 +105,15 @@ export async function compile(
     outputName: baseName,
   });
 
-  // Ensure output directory exists
-  await Deno.mkdir(outputDir, { recursive: true });
+  const timer = new PhaseTimer();
+  await timer.measure("write", async () => {
+    // Ensure output directory exists
+    await Deno.mkdir(outputDir, { recursive: true });
 
-  // Write generated files
-  await Deno.writeTextFile(headerPath, result.header);
-  await Deno.writeTextFile(sourcePath, result.source);
+    // Write generated files; unchanged ones keep their timestamps for the C++ build
+    await writeIfChanged(headerPath, result.header);
+    await writeIfChanged(sourcePath, result.source);
+  });
 
   if (options.verbose) {
     console.log(`Generated ${headerPath}`);
@@ -124,12 +138,19 @@ export async function compile(
 
   // Optionally compile to executable
   if (options.buildExecutable && !options.dryRun) {
-    const compileResult = await compileCpp(sourcePath, {
-      ...options,
-      outputName: baseName,
-      outputDir,
-      runtimePath: options.runtimeInclude, // Pass runtime include path for compilation
-    });
+    // The runtime module has to be built before the sources importing it
+    if (options.useModules) {
+      throw new Error("C++20 modules need a CMake build: use --cmake instead of --build");
+    }
+
+    const compileResult = await timer.measure("compile", () =>
+      compileCpp(sourcePath, {
+        ...options,
+        outputName: baseName,
+        outputDir,
+        runtimePath: options.runtimeInclude, // Pass runtime include path for compilation
+      })
+    );
 
     return {
       headerPath,
@@ -139,6 +160,7 @@ export async function compile(
       command: compileResult.command,
       output: compileResult.output,
       success: compileResult.success,
+      phases: [...result.stats.phases ?? [], ...timer.phases],
     };
   }
 
@@ -147,6 +169,7 @@ export async function compile(
     sourcePath,
     cmakeListsPath,
     success: true,
+    phases: [...result.stats.phases ?? [], ...timer.phases],
   };
 }
 
@@ -246,7 +269,7 @@ async function detectCompiler(
 /**
  * Check if command exists
  */
-async function commandExists(command: string): Promise<boolean> {
+export async function commandExists(command: string): Promise<boolean> {
   try {
     const process = new Deno.Command(command, {
       args: ["--version"],
@@ -349,6 +372,11 @@ function buildCompilerCommand(
     }
   }
 
+  // The runtime event loop and file I/O use worker threads
+  if (compiler !== "cl") {
+    command.push("-pthread");
+  }
+
   return command;
 }
 
@@ -391,6 +419,9 @@ async function generateCMakeListsFile(
 ): Promise<string> {
   const cmakeListsPath = join(outputDir, "CMakeLists.txt");
 
+  // Generated code includes "runtime/core/...", relative to the runtime's parent
+  const runtimeDir = getRuntimeIncludePath(options.runtimePath);
+
   // Build CMake options from compile options
   const cmakeOptions = {
     projectName: projectName.replace(/[^a-zA-Z0-9_]/g, "_"), // Make project name safe
@@ -400,14 +431,19 @@ async function generateCMakeListsFile(
     includeDirs: [
       ".", // Current directory
       ...(options.includePaths ?? []),
-      getRuntimeIncludePath(options.runtimePath),
-    ].filter((path): path is string => path !== undefined),
+      runtimeDir,
+      dirname(runtimeDir),
+    ].filter((path, index, paths) => paths.indexOf(path) === index),
     libraries: [
       ...(options.libraries ?? []),
       "m", // Math library
     ],
     executable: true, // Always generate executable for now
     outputName: projectName.toLowerCase(),
+    runtimeDir, // Runtime sources built once as libjsruntime
+    useModules: options.useModules ?? false, // ...and exported as the js.runtime module
+    unityBuild: options.unityBuild ?? false,
+    unityBatchSize: options.unityBatchSize ?? DEFAULT_UNITY_BATCH_SIZE,
   };
 
   // Generate debug/release configurations
@@ -442,7 +478,7 @@ set(CMAKE_CXX_FLAGS_MINSIZEREL "-Os -DNDEBUG")
 message(STATUS "Build type: \${CMAKE_BUILD_TYPE}")
 `;
 
-  await Deno.writeTextFile(cmakeListsPath, enhancedContent);
+  await writeIfChanged(cmakeListsPath, enhancedContent);
   return cmakeListsPath;
 }
 
@@ -0,0 +1,19 @@
+/**
+ * Loading of typescript2cxx.config.ts files
+ */
+
+import { resolve, toFileUrl } from "@std/path";
+import { TranspilerError } from "../errors.ts";
+import type { TranspilerConfig } from "./types.ts";
+
+/**
+ * Import a configuration module and return its default export
+ */
+export async function loadConfig(path: string): Promise<TranspilerConfig> {
+  const module = await import(toFileUrl(resolve(path)).href);
+  const config = module.default as TranspilerConfig | undefined;
+  if (!config || typeof config !== "object") {
+    throw new TranspilerError(`${path} has no default export`, "CONFIG_ERROR");
+  }
+  return config;
+}
@@ -182,6 +182,8 @@ export interface CMakeConfig {
   findPackages: string[];
   customCommands?: string[];
   outputName?: string;
+  unityBuild?: boolean;
+  unityBatchSize?: number;
 }
 
 export interface VcpkgConfig {
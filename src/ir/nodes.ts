@@ -49,6 +49,11 @@ export enum IRNodeKind {
   EnumDeclaration = "EnumDeclaration",
   TypeAliasDeclaration = "TypeAliasDeclaration",
 
+  // Interface members
+  PropertySignature = "PropertySignature",
+  MethodSignature = "MethodSignature",
+  IndexSignature = "IndexSignature",
+
   // Decorators
   Decorator = "Decorator",
   DecoratorFactory = "DecoratorFactory",
@@ -138,6 +143,20 @@ export enum MemoryManagement {
   Auto = "auto",
 }
 
+/**
+ * How a parameter is passed
+ */
+export enum ParameterPassing {
+  /** By value (copy or move) */
+  Value = "value",
+
+  /** By const reference (borrowed, not retained by the callee) */
+  ConstReference = "const-ref",
+
+  /** By reference (borrowed and written through, not retained by the callee) */
+  Reference = "ref",
+}
+
 /**
  * Access modifiers for class members
  */
@@ -200,6 +219,32 @@ export interface IRModule extends IRNode {
 
   /** Required C++ headers */
   headers: string[];
+
+  /** Cached by getModuleFacts (ir/visitor.ts) */
+  facts?: ModuleFacts;
+}
+
+/**
+ * Whole-module facts used by code generation
+ */
+export interface ModuleFacts {
+  /** IR nodes in the module, including the module itself */
+  nodeCount: number;
+
+  /** Has async functions or await expressions (needs runtime/async.h) */
+  hasAsync: boolean;
+
+  /** Has synchronous generator functions (needs runtime/generator.h) */
+  hasGenerators: boolean;
+
+  /** Declares variables, parameters or return values of std::tuple type */
+  usesTuples: boolean;
+
+  /** Has a top-level function named main */
+  hasMain: boolean;
+
+  /** Top-level classes, in order, for forward declarations */
+  classNames: string[];
 }
 
 /**
@@ -401,6 +446,9 @@ export interface IRVariableDeclarator {
 
   /** Is extern */
   isExtern?: boolean;
+
+  /** Declared with an intersection type, of which cppType is only the first member */
+  isIntersection?: boolean;
 }
 
 /**
@@ -464,6 +512,9 @@ export interface IRFunctionDeclaration extends IRDeclaration {
 
   /** Template parameters */
   templateParams?: IRTemplateParameter[];
+
+  /** Marked `@arena`: allocations during the call share one arena (--memory=arena) */
+  arenaScope?: boolean;
 }
 
 /**
@@ -488,6 +539,9 @@ export interface IRParameter {
   /** Memory management */
   memory: MemoryManagement;
 
+  /** Passing convention chosen by memory analysis */
+  passing?: ParameterPassing;
+
   /** Decorators */
   decorators?: IRDecorator[];
 }
@@ -518,6 +572,9 @@ export interface IRClassDeclaration extends IRDeclaration {
 
   /** Decorator metadata */
   decorators?: IRDecoratorMetadata;
+
+  /** Annotated `@pooled`: instances come from a per-type free-list pool */
+  isPooled?: boolean;
 }
 
 /**
@@ -848,6 +905,12 @@ export interface IRIdentifier extends IRExpression {
 
   /** Resolved C++ name (may differ due to keywords) */
   cppName?: string;
+
+  /** Memory management of the referenced binding (set by memory analysis) */
+  memory?: MemoryManagement;
+
+  /** Last use that hands ownership on; emitted as std::move */
+  isMoved?: boolean;
 }
 
 /**
@@ -1035,6 +1098,9 @@ export interface IRNewExpression extends IRExpression {
 
   /** Constructor arguments */
   arguments: IRExpression[];
+
+  /** Allocation chosen by memory analysis */
+  memory?: MemoryManagement;
 }
 
 /**
@@ -1066,6 +1132,12 @@ export interface IRInterfaceDeclaration extends IRDeclaration {
   /** Extended interfaces */
   extends: string[];
 
+  /** Generic type parameters */
+  typeParameters?: IRTemplateParameter[];
+
+  /** Annotated `@soa`: arrays of it are stored field by field */
+  isSoa?: boolean;
+
   /** Interface members */
   body: IRInterfaceBody;
 }
@@ -1090,6 +1162,8 @@ export type IRInterfaceMember =
  * Method signature in interface
  */
 export interface IRMethodSignature extends IRNode {
+  kind: IRNodeKind.MethodSignature;
+
   /** Method name */
   key: IRIdentifier | IRLiteral;
 
@@ -1107,6 +1181,8 @@ export interface IRMethodSignature extends IRNode {
  * Property signature in interface
  */
 export interface IRPropertySignature extends IRNode {
+  kind: IRNodeKind.PropertySignature;
+
   /** Property name */
   key: IRIdentifier | IRLiteral;
 
@@ -1124,6 +1200,8 @@ export interface IRPropertySignature extends IRNode {
  * Index signature in interface
  */
 export interface IRIndexSignature extends IRNode {
+  kind: IRNodeKind.IndexSignature;
+
   /** Index parameter name */
   indexName: string;
 
@@ -0,0 +1,105 @@
+/**
+ * Interfaces lowered to plain structs
+ *
+ * Data-only interfaces and object type aliases with a closed shape become
+ * C++ structs initialized by aggregate initialization; everything else keeps
+ * the abstract class form. Code generation emits the structs, and memory
+ * analysis borrows parameters of those types, so both decide through here.
+ */
+
+import {
+  type IRClassDeclaration,
+  type IRInterfaceDeclaration,
+  type IRModule,
+  IRNodeKind,
+} from "./nodes.ts";
+
+/**
+ * Field of an interface lowered to a struct
+ */
+export interface StructField {
+  /** Field name */
+  name: string;
+
+  /** C++ type of the value (without std::optional) */
+  type: string;
+
+  /** Optional property, held in std::optional */
+  optional: boolean;
+}
+
+/**
+ * Collect interfaces and object type aliases with a closed shape: only
+ * properties, all of a type with a fixed C++ layout. Base interfaces and
+ * field types must be closed and declared earlier in the module.
+ *
+ * @param mapType - Maps IR field types to C++ types
+ */
+export function collectStructs(
+  module: IRModule,
+  mapType: (type: string) => string = (type) => type,
+): Map<string, StructField[]> {
+  const structs = new Map<string, StructField[]>();
+
+  // Merged declarations (interface + interface / class) and interfaces
+  // implemented by classes keep the abstract class form
+  const declarations = new Map<string, number>();
+  for (const stmt of module.body) {
+    if (
+      stmt.kind === IRNodeKind.InterfaceDeclaration || stmt.kind === IRNodeKind.ClassDeclaration
+    ) {
+      const name = (stmt as IRInterfaceDeclaration | IRClassDeclaration).id.name;
+      declarations.set(name, (declarations.get(name) ?? 0) + 1);
+    }
+    if (stmt.kind === IRNodeKind.ClassDeclaration) {
+      for (const iface of (stmt as IRClassDeclaration).implements ?? []) {
+        declarations.set(iface, Infinity);
+      }
+    }
+  }
+
+  for (const stmt of module.body) {
+    if (stmt.kind !== IRNodeKind.InterfaceDeclaration) continue;
+    const iface = stmt as IRInterfaceDeclaration;
+    const name = iface.id.name;
+    if (declarations.get(name) !== 1 || iface.typeParameters?.length) continue;
+    if (!iface.extends.every((base) => structs.has(base))) continue;
+
+    const fields = iface.extends.flatMap((base) => structs.get(base)!);
+    let closed = true;
+    for (const member of iface.body.body) {
+      if (
+        member.kind !== IRNodeKind.PropertySignature || member.key.kind !== IRNodeKind.Identifier
+      ) {
+        closed = false;
+        break;
+      }
+      const type = mapType(member.type);
+      if (!isFixedLayoutType(type, structs)) {
+        closed = false;
+        break;
+      }
+      const field = { name: member.key.name, type, optional: member.optional };
+      const index = fields.findIndex((f) => f.name === field.name);
+      if (index >= 0) {
+        fields[index] = field;
+      } else {
+        fields.push(field);
+      }
+    }
+
+    if (closed && fields.length > 0) {
+      structs.set(name, fields);
+    }
+  }
+
+  return structs;
+}
+
+function isFixedLayoutType(type: string, structs: Map<string, StructField[]>): boolean {
+  if (["js::number", "js::string", "bool", "js::bigint"].includes(type) || structs.has(type)) {
+    return true;
+  }
+  const array = type.match(/^js::array<(.+)>$/);
+  return array !== null && isFixedLayoutType(array[1], structs);
+}
@@ -0,0 +1,257 @@
+/**
+ * Typed traversal of the IR
+ *
+ * CHILD_FIELDS lists, per node kind, the fields that hold child nodes, so a
+ * walk only follows the tree instead of reflecting over every property
+ * (types, memory info, source locations). Some kinds have several shapes -
+ * class methods and accessors are FunctionDeclaration nodes with key/value,
+ * class fields are VariableDeclaration nodes, enum members reuse
+ * EnumDeclaration - so a kind lists the fields of all its shapes.
+ *
+ * Fields may also hold plain records without an IR kind (declarators,
+ * parameters, object properties, switch cases, decorator metadata); their
+ * children are found through RECORD_FIELDS.
+ */
+
+import {
+  type IRFunctionDeclaration,
+  type IRModule,
+  type IRNode,
+  IRNodeKind,
+  type IRVariableDeclaration,
+  type ModuleFacts,
+} from "./nodes.ts";
+
+const CHILD_FIELDS: Record<IRNodeKind, readonly string[]> = {
+  [IRNodeKind.Program]: ["modules"],
+  [IRNodeKind.Module]: ["body"],
+  [IRNodeKind.Namespace]: ["body"],
+
+  [IRNodeKind.ImportDeclaration]: [],
+  [IRNodeKind.ExportDeclaration]: ["declaration"],
+  [IRNodeKind.ExportNamedDeclaration]: ["declaration"],
+  [IRNodeKind.ExportDefaultDeclaration]: ["declaration"],
+  [IRNodeKind.ExportAllDeclaration]: [],
+  [IRNodeKind.NamespaceDeclaration]: ["body"],
+
+  [IRNodeKind.VariableDeclaration]: ["declarations", "decorators", "key", "value"],
+  [IRNodeKind.FunctionDeclaration]: [
+    "id",
+    "decorators",
+    "params",
+    "initializers",
+    "body",
+    "key",
+    "value",
+  ],
+  [IRNodeKind.ClassDeclaration]: ["id", "decorators", "superClass", "members"],
+  [IRNodeKind.InterfaceDeclaration]: ["id", "body"],
+  [IRNodeKind.EnumDeclaration]: ["id", "members", "initializer"],
+  [IRNodeKind.TypeAliasDeclaration]: [],
+
+  [IRNodeKind.PropertySignature]: ["key"],
+  [IRNodeKind.MethodSignature]: ["key", "params"],
+  [IRNodeKind.IndexSignature]: [],
+
+  [IRNodeKind.Decorator]: ["expression"],
+  [IRNodeKind.DecoratorFactory]: ["arguments"],
+
+  [IRNodeKind.BlockStatement]: ["body"],
+  [IRNodeKind.ExpressionStatement]: ["expression"],
+  [IRNodeKind.IfStatement]: ["test", "consequent", "alternate"],
+  [IRNodeKind.SwitchStatement]: ["discriminant", "cases"],
+  [IRNodeKind.WhileStatement]: ["test", "body"],
+  [IRNodeKind.DoWhileStatement]: ["body", "test"],
+  [IRNodeKind.ForStatement]: ["init", "test", "update", "body"],
+  [IRNodeKind.ForInStatement]: ["left", "right", "body"],
+  [IRNodeKind.ForOfStatement]: ["left", "right", "body"],
+  [IRNodeKind.ReturnStatement]: ["argument"],
+  [IRNodeKind.BreakStatement]: [],
+  [IRNodeKind.ContinueStatement]: [],
+  [IRNodeKind.ThrowStatement]: ["argument"],
+  [IRNodeKind.TryStatement]: ["block", "handler", "finalizer"],
+  [IRNodeKind.CatchClause]: ["param", "body"],
+
+  [IRNodeKind.Identifier]: [],
+  [IRNodeKind.Literal]: [],
+  [IRNodeKind.ArrayExpression]: ["elements"],
+  [IRNodeKind.ObjectExpression]: ["properties"],
+  [IRNodeKind.FunctionExpression]: ["id", "name", "params", "body"],
+  [IRNodeKind.ArrowFunctionExpression]: ["params", "body"],
+  [IRNodeKind.ClassExpression]: ["id", "name", "decorators", "superClass", "members", "body"],
+  [IRNodeKind.MemberExpression]: ["object", "property"],
+  [IRNodeKind.OptionalChainingExpression]: ["base"],
+  [IRNodeKind.CallExpression]: ["callee", "arguments"],
+  [IRNodeKind.NewExpression]: ["callee", "arguments"],
+  [IRNodeKind.UpdateExpression]: ["argument"],
+  [IRNodeKind.UnaryExpression]: ["operand"],
+  [IRNodeKind.BinaryExpression]: ["left", "right"],
+  [IRNodeKind.AssignmentExpression]: ["left", "right"],
+  [IRNodeKind.LogicalExpression]: ["left", "right"],
+  [IRNodeKind.ConditionalExpression]: ["test", "consequent", "alternate"],
+  [IRNodeKind.ThisExpression]: [],
+  [IRNodeKind.SuperExpression]: [],
+  [IRNodeKind.TemplateLiteral]: ["parts"],
+  [IRNodeKind.TaggedTemplateExpression]: ["tag", "quasi"],
+  [IRNodeKind.YieldExpression]: ["argument"],
+  [IRNodeKind.AwaitExpression]: ["argument"],
+  [IRNodeKind.SpreadElement]: ["argument"],
+
+  [IRNodeKind.ObjectPattern]: ["properties"],
+  [IRNodeKind.ArrayPattern]: ["elements"],
+  [IRNodeKind.RestElement]: ["argument"],
+  [IRNodeKind.AssignmentPattern]: ["left", "right"],
+
+  [IRNodeKind.TypeAnnotation]: [],
+  [IRNodeKind.TypeParameter]: [],
+  [IRNodeKind.UnionType]: ["types"],
+  [IRNodeKind.IntersectionType]: ["types"],
+  [IRNodeKind.TypeGuard]: ["parameter", "guardedType", "expression"],
+
+  [IRNodeKind.CppRawExpression]: [],
+  [IRNodeKind.SmartPointerExpression]: ["expression"],
+  [IRNodeKind.MoveExpression]: ["argument"],
+};
+
+/**
+ * Child fields of records without an IR kind: declarators (id, init),
+ * parameters and pattern properties (defaultValue, decorators), object
+ * properties and member initializers (key, value), switch cases (test,
+ * consequent), interface bodies (body) and decorator metadata
+ * (classDecorators)
+ */
+const RECORD_FIELDS: readonly string[] = [
+  "id",
+  "init",
+  "key",
+  "value",
+  "defaultValue",
+  "decorators",
+  "test",
+  "consequent",
+  "body",
+  "classDecorators",
+];
+
+/**
+ * Is this value an IR node (rather than a record inside one)?
+ */
+export function isIRNode(value: unknown): value is IRNode {
+  const kind = (value as { kind?: unknown } | null)?.kind;
+  return typeof kind === "string" && Object.hasOwn(CHILD_FIELDS, kind);
+}
+
+/**
+ * Call `visit` for every direct child node, in source order, with the field
+ * that held it (for a child inside a plain record, the record's field)
+ */
+export function forEachChild(
+  node: IRNode,
+  visit: (child: IRNode, field: string) => void,
+): void {
+  visitFields(node as unknown as Record<string, unknown>, CHILD_FIELDS[node.kind], visit);
+}
+
+/**
+ * Visit `node` and its descendants depth-first; returning false from `visit`
+ * skips the children of that node
+ */
+export function walkIR(node: IRNode, visit: (node: IRNode) => boolean | void): void {
+  if (visit(node) !== false) {
+    forEachChild(node, (child) => walkIR(child, visit));
+  }
+}
+
+function visitFields(
+  record: Record<string, unknown>,
+  fields: readonly string[],
+  visit: (child: IRNode, field: string) => void,
+): void {
+  for (const field of fields) {
+    const value = record[field];
+    if (Array.isArray(value)) {
+      for (const item of value) {
+        visitValue(item, field, visit);
+      }
+    } else {
+      visitValue(value, field, visit);
+    }
+  }
+}
+
+function visitValue(
+  value: unknown,
+  field: string,
+  visit: (child: IRNode, field: string) => void,
+): void {
+  if (!value || typeof value !== "object") return;
+  if (isIRNode(value)) {
+    visit(value, field);
+  } else {
+    visitFields(value as Record<string, unknown>, RECORD_FIELDS, visit);
+  }
+}
+
+/**
+ * Facts about a module that code generation needs, computed in one walk and
+ * cached on the module. Anything that changes the module afterwards must
+ * reset `module.facts`.
+ */
+export function getModuleFacts(module: IRModule): ModuleFacts {
+  if (module.facts) return module.facts;
+
+  const facts: ModuleFacts = {
+    nodeCount: 0,
+    hasAsync: false,
+    hasGenerators: false,
+    usesTuples: false,
+    hasMain: false,
+    classNames: [],
+  };
+
+  for (const stmt of module.body) {
+    if (stmt.kind === IRNodeKind.ClassDeclaration) {
+      facts.classNames.push((stmt as { id: { name: string } }).id.name);
+    } else if (
+      stmt.kind === IRNodeKind.FunctionDeclaration &&
+      (stmt as IRFunctionDeclaration).id?.name === "main"
+    ) {
+      facts.hasMain = true;
+    }
+  }
+
+  walkIR(module, (node) => {
+    facts.nodeCount++;
+    switch (node.kind) {
+      case IRNodeKind.AwaitExpression:
+        facts.hasAsync = true;
+        break;
+      case IRNodeKind.ArrowFunctionExpression:
+        facts.hasAsync ||= !!(node as { isAsync?: boolean }).isAsync;
+        break;
+      case IRNodeKind.FunctionExpression:
+      case IRNodeKind.FunctionDeclaration: {
+        const func = node as IRFunctionDeclaration;
+        facts.hasAsync ||= !!func.isAsync;
+        facts.hasGenerators ||= !!func.isGenerator && !func.isAsync;
+        if (node.kind === IRNodeKind.FunctionDeclaration) {
+          facts.usesTuples ||= isTupleType(func.returnType) ||
+            (func.params ?? []).some((param) => isTupleType(param.type));
+        }
+        break;
+      }
+      case IRNodeKind.VariableDeclaration:
+        facts.usesTuples ||= ((node as IRVariableDeclaration).declarations ?? []).some((decl) =>
+          isTupleType(decl.cppType)
+        );
+        break;
+    }
+  });
+
+  module.facts = facts;
+  return facts;
+}
+
+function isTupleType(type: unknown): boolean {
+  return typeof type === "string" && type.includes("std::tuple<");
+}
@@ -1,9 +1,60 @@
 /**
  * Memory management analyzer
+ *
+ * Runs an intraprocedural ownership analysis over the IR. Every use of a
+ * local class instance (created with `new`) or of a class-typed or value-typed
+ * parameter is classified as a member access, a read, an argument, a store, a
+ * return or an escape. From that:
+ *
+ * - locals that are only ever accessed through members never leave their
+ *   function and become stack values;
+ * - locals handed on exactly once, as their last use, have a single owner
+ *   and become `unique_ptr`s moved into the consumer;
+ * - parameters the callee never retains are borrowed and passed as
+ *   `const std::shared_ptr<T>&`, so calls do no reference counting; retained
+ *   parameters are moved at their last use;
+ * - strings, arrays, objects and interface values are passed as `const T&`
+ *   when only read, as `T&` when the callee writes through them without
+ *   keeping them, and by value (moved at the last use) only when retained.
+ *
+ * Reference cycles between class fields are handled separately (see
+ * cycles.ts) and apply to every strategy but manual.
  */
 
-import type { IRNode } from "../ir/nodes.ts";
-import type { MemoryAnalysisResult } from "./types.ts";
+import {
+  type IRAssignmentExpression,
+  type IRCallExpression,
+  type IRClassDeclaration,
+  type IRForOfStatement,
+  type IRFunctionDeclaration,
+  type IRIdentifier,
+  type IRLiteral,
+  type IRMemberExpression,
+  type IRModule,
+  type IRNewExpression,
+  type IRNode,
+  IRNodeKind,
+  type IRObjectExpression,
+  type IRParameter,
+  type IRPropertyDefinition,
+  type IRUnaryExpression,
+  type IRUpdateExpression,
+  type IRVariableDeclaration,
+  MemoryManagement,
+  ParameterPassing,
+} from "../ir/nodes.ts";
+import {
+  LifetimeScope,
+  type MemoryAnalysisResult,
+  MemoryIssueType,
+  type OwnershipInfo,
+  OwnershipType,
+  PointerType,
+} from "./types.ts";
+import { analyzeReferenceCycles } from "./cycles.ts";
+import { collectStructs } from "../ir/structs.ts";
+import { forEachChild } from "../ir/visitor.ts";
+import type { TranspileOptions } from "../types.ts";
 
 /**
  * Analyze options
@@ -13,17 +64,1141 @@ export interface AnalyzeOptions {
   options: Record<string, unknown>;
 }
 
+/**
+ * How a use of a tracked binding treats the object
+ */
+enum UseKind {
+  /** `x.prop`, `x.method()` - the object stays where it is */
+  Member = "member",
+
+  /** Read in place: `x[i]`, `x + y`, `for (... of x)`, conditions */
+  Read = "read",
+
+  /** Argument of a call or `new` */
+  Argument = "argument",
+
+  /** Right-hand side of a plain assignment (`this.child = x`) */
+  Store = "store",
+
+  /** `return x` */
+  Return = "return",
+
+  /** Anything else: aliasing, captures, literals, comparisons, ... */
+  Escape = "escape",
+}
+
+/**
+ * A single reference to a tracked binding
+ */
+interface Use {
+  id: IRIdentifier;
+  kind: UseKind;
+
+  /** Position in source order */
+  order: number;
+
+  /** Number of enclosing loops inside the function */
+  loopDepth: number;
+
+  /** Innermost enclosing statement, standing in for the full-expression */
+  statement?: IRNode;
+
+  /** Module function called directly with this use as an argument */
+  callee?: IRFunctionDeclaration;
+  argumentIndex?: number;
+
+  /** Where a stored object ends up */
+  target?: IRNode;
+}
+
+/**
+ * A local variable or parameter whose uses are tracked
+ */
+interface Binding {
+  name: string;
+  loopDepth: number;
+  uses: Use[];
+}
+
+/**
+ * A local variable initialized with `new`
+ */
+interface AllocationBinding extends Binding {
+  declaration: IRVariableDeclaration;
+  cppType: string;
+  allocation: IRNewExpression;
+  className: string;
+}
+
+/**
+ * A class-typed or value-typed parameter of a top-level function
+ */
+interface ParameterBinding extends Binding {
+  param: IRParameter;
+
+  /** Held by value (strings, arrays, objects, structs) rather than shared_ptr */
+  value: boolean;
+
+  /** Arrays and interface values, which the callee may write through as `T&` */
+  referenceable: boolean;
+
+  /** Elements or fields are written, or mutating methods are called */
+  mutated: boolean;
+
+  /** Assigned to in the body, so the callee needs its own copy */
+  reassigned: boolean;
+
+  passing: ParameterPassing;
+}
+
+/**
+ * Nodes that introduce a function body
+ */
+interface FunctionLike extends IRNode {
+  params?: IRParameter[];
+  body?: IRNode;
+}
+
+/**
+ * Classes declared in the module
+ */
+interface ModuleClasses {
+  /** Every class name */
+  declared: Set<string>;
+
+  /** Concrete, non-generic classes that can be constructed in place */
+  concrete: Set<string>;
+}
+
+type Visitor = (node: IRNode, parent?: IRNode, key?: string) => boolean;
+
+/**
+ * Array and object methods that modify the receiver
+ */
+const MUTATING_METHODS = new Set([
+  "push",
+  "pop",
+  "shift",
+  "unshift",
+  "splice",
+  "sort",
+  "reverse",
+  "fill",
+  "copyWithin",
+  "set",
+  "delete",
+  "clear",
+]);
+
+/**
+ * Value types whose storage never comes from an arena
+ */
+const PLAIN_TYPES = new Set(["bool", "js::number", "js::string", "js::bigint"]);
+
+/**
+ * Passing conventions from cheapest to most demanding
+ */
+const PASSING_RANK: Record<ParameterPassing, number> = {
+  [ParameterPassing.ConstReference]: 0,
+  [ParameterPassing.Reference]: 1,
+  [ParameterPassing.Value]: 2,
+};
+
 /**
  * Analyze memory management for IR nodes
+ *
+ * Results are keyed by the `new` expression, by every identifier that refers
+ * to an analyzed binding and by analyzed parameters. For uses,
+ * `ownership.movable` marks the one use that may move the object.
  */
 export function analyzeMemory(
-  _ir: IRNode,
-  _options: AnalyzeOptions,
+  ir: IRNode,
+  options: AnalyzeOptions,
 ): Map<IRNode, MemoryAnalysisResult> {
-  // TODO: Implement memory analysis
-
   const results = new Map<IRNode, MemoryAnalysisResult>();
+  if (options.strategy === "manual") {
+    return results;
+  }
+
+  const validation = (options.options.validation ?? {}) as TranspileOptions["validation"];
+  analyzeReferenceCycles(ir, {
+    breakCycles: validation?.checkCircularDependencies ?? true,
+    reportLeaks: validation?.checkMemoryLeaks ?? true,
+  }, results);
+
+  // Shared ownership was requested explicitly
+  if (options.strategy === "shared") {
+    return results;
+  }
+
+  const classes = collectClasses(ir);
+  const structs = collectStructNames(ir);
+  const moduleFunctions = collectModuleFunctions(ir);
+  const weakFields = collectWeakFields(ir, results);
+  const parameters = new Map<FunctionLike, ParameterBinding[]>();
+  const arenaScopes = new Map<FunctionLike, AllocationBinding[]>();
+
+  walk(ir, (node) => {
+    if (!isFunctionLike(node)) return true;
+    const fn = node as FunctionLike;
+    const { allocations, params } = collectBindings(fn, classes, structs, moduleFunctions);
+    if (options.strategy === "arena" && (fn as IRFunctionDeclaration).arenaScope) {
+      arenaScopes.set(fn, allocations);
+    }
+    if (allocations.length > 0 || params.length > 0) {
+      collectUses(fn, [...allocations, ...params], moduleFunctions, weakFields);
+      collectMutations(fn, params);
+      for (const allocation of allocations) {
+        analyzeAllocation(allocation, classes, options.strategy, results);
+      }
+      parameters.set(fn, params);
+    }
+    return true;
+  });
+
+  inferParameterPassing(parameters, collectCallSiteSafety(ir, moduleFunctions));
+
+  for (const [fn, allocations] of arenaScopes) {
+    reportArenaEscapes(fn, allocations, parameters, results);
+  }
+
+  for (const params of parameters.values()) {
+    for (const binding of params) {
+      analyzeParameter(binding, results);
+    }
+  }
 
-  // For now, return empty results
   return results;
 }
+
+/**
+ * Map an analysis result onto the IR memory management enum
+ */
+export function toMemoryManagement(pointerType: PointerType): MemoryManagement {
+  switch (pointerType) {
+    case PointerType.Value:
+      return MemoryManagement.Value;
+    case PointerType.UniquePtr:
+      return MemoryManagement.Unique;
+    case PointerType.WeakPtr:
+      return MemoryManagement.Weak;
+    case PointerType.RawPtr:
+      return MemoryManagement.Raw;
+    case PointerType.SharedPtr:
+      return MemoryManagement.Shared;
+    default:
+      return MemoryManagement.Auto;
+  }
+}
+
+/**
+ * Names of class fields held through `std::weak_ptr`, annotated or weakened
+ * by cycle analysis
+ */
+function collectWeakFields(
+  ir: IRNode,
+  results: Map<IRNode, MemoryAnalysisResult>,
+): Set<string> {
+  const names = new Set<string>();
+  walk(ir, (node) => {
+    if (node.kind === IRNodeKind.VariableDeclaration && "key" in node) {
+      const field = node as IRPropertyDefinition;
+      const weak = field.memory === MemoryManagement.Weak ||
+        results.get(field)?.pointerType === PointerType.WeakPtr;
+      if (weak && field.key.kind === IRNodeKind.Identifier) {
+        names.add((field.key as IRIdentifier).name);
+      }
+    }
+    return true;
+  });
+  return names;
+}
+
+function isWeakStore(assignment: IRAssignmentExpression, weakFields: Set<string>): boolean {
+  if (assignment.left.kind !== IRNodeKind.MemberExpression) return false;
+  const member = assignment.left as IRMemberExpression;
+  return !member.computed && member.property.kind === IRNodeKind.Identifier &&
+    weakFields.has((member.property as IRIdentifier).name);
+}
+
+function collectClasses(ir: IRNode): ModuleClasses {
+  const classes: ModuleClasses = { declared: new Set(), concrete: new Set() };
+  walk(ir, (node) => {
+    if (node.kind === IRNodeKind.ClassDeclaration) {
+      const classDecl = node as IRClassDeclaration;
+      if (!classDecl.id) return true;
+      classes.declared.add(classDecl.id.name);
+      if (!classDecl.isAbstract && !classDecl.templateParams?.length) {
+        classes.concrete.add(classDecl.id.name);
+      }
+    }
+    return true;
+  });
+  return classes;
+}
+
+/**
+ * Names of interfaces (and object type aliases) lowered to structs; other
+ * interfaces stay abstract classes and are passed as before. Field types are
+ * taken as the IR has them, so this never exceeds what the generator lowers.
+ */
+function collectStructNames(ir: IRNode): Set<string> {
+  const names = new Set<string>();
+  walk(ir, (node) => {
+    if (node.kind !== IRNodeKind.Module) return true;
+    for (const name of collectStructs(node as IRModule).keys()) {
+      names.add(name);
+    }
+    return false;
+  });
+  return names;
+}
+
+/**
+ * Top-level functions that direct calls resolve to; overloaded names are
+ * left out
+ */
+function collectModuleFunctions(ir: IRNode): Map<string, IRFunctionDeclaration> {
+  const functions = new Map<string, IRFunctionDeclaration>();
+  const overloaded = new Set<string>();
+  walk(ir, (node, parent) => {
+    if (node.kind !== IRNodeKind.FunctionDeclaration) return true;
+    const fn = node as IRFunctionDeclaration;
+    const topLevel = parent?.kind === IRNodeKind.Module ||
+      parent?.kind === IRNodeKind.ExportNamedDeclaration ||
+      parent?.kind === IRNodeKind.ExportDefaultDeclaration ||
+      parent?.kind === IRNodeKind.ExportDeclaration;
+    if (topLevel && fn.id) {
+      if (functions.has(fn.id.name)) overloaded.add(fn.id.name);
+      functions.set(fn.id.name, fn);
+    }
+    return false;
+  });
+  for (const name of overloaded) {
+    functions.delete(name);
+  }
+  return functions;
+}
+
+function isFunctionLike(node: IRNode): boolean {
+  if (
+    node.kind !== IRNodeKind.FunctionDeclaration &&
+    node.kind !== IRNodeKind.FunctionExpression &&
+    node.kind !== IRNodeKind.ArrowFunctionExpression
+  ) {
+    return false;
+  }
+  const body = (node as FunctionLike).body;
+  return !!body && body.kind === IRNodeKind.BlockStatement;
+}
+
+function isLoop(node: IRNode): boolean {
+  return node.kind === IRNodeKind.ForStatement || node.kind === IRNodeKind.ForInStatement ||
+    node.kind === IRNodeKind.ForOfStatement || node.kind === IRNodeKind.WhileStatement ||
+    node.kind === IRNodeKind.DoWhileStatement;
+}
+
+/**
+ * Statements whose expressions are evaluated as one unit; C++ leaves the
+ * order of function arguments and most operands within them unspecified
+ */
+const FULL_EXPRESSION_STATEMENTS = new Set<IRNodeKind>([
+  IRNodeKind.ExpressionStatement,
+  IRNodeKind.VariableDeclaration,
+  IRNodeKind.ReturnStatement,
+  IRNodeKind.ThrowStatement,
+  IRNodeKind.IfStatement,
+  IRNodeKind.SwitchStatement,
+  IRNodeKind.WhileStatement,
+  IRNodeKind.DoWhileStatement,
+  IRNodeKind.ForStatement,
+  IRNodeKind.ForInStatement,
+  IRNodeKind.ForOfStatement,
+]);
+
+/**
+ * Find the `new`-initialized locals and the class-typed and value-typed
+ * parameters of a function. Names bound more than once are dropped.
+ */
+function collectBindings(
+  fn: FunctionLike,
+  classes: ModuleClasses,
+  structs: Set<string>,
+  moduleFunctions: Map<string, IRFunctionDeclaration>,
+): { allocations: AllocationBinding[]; params: ParameterBinding[] } {
+  const counts = new Map<string, number>();
+  const bind = (name: string) => counts.set(name, (counts.get(name) ?? 0) + 1);
+  const allocations: AllocationBinding[] = [];
+  const params: ParameterBinding[] = [];
+
+  // Only top-level functions change their signatures: method signatures must
+  // keep matching overrides, and lambdas keep their declared parameter types.
+  // Coroutines outlive their caller's arguments, so they keep taking copies.
+  const isModuleFunction = [...moduleFunctions.values()].includes(fn as IRFunctionDeclaration);
+  const isCoroutine = isModuleFunction &&
+    ((fn as IRFunctionDeclaration).isAsync || (fn as IRFunctionDeclaration).isGenerator);
+  for (const param of fn.params ?? []) {
+    bind(param.name);
+    if (
+      !isModuleFunction || isCoroutine || param.isRest || param.isOptional || param.defaultValue
+    ) {
+      continue;
+    }
+    const referenceable = param.type.startsWith("js::array<") || structs.has(param.type);
+    const value = referenceable || param.type === "js::string" || param.type === "js::object";
+    if (value || classes.declared.has(param.type)) {
+      params.push({
+        name: param.name,
+        loopDepth: 0,
+        uses: [],
+        param,
+        value,
+        referenceable,
+        mutated: false,
+        reassigned: false,
+        passing: ParameterPassing.Value,
+      });
+    }
+  }
+
+  let loopDepth = 0;
+  const visit: Visitor = (node) => {
+    if (isFunctionLike(node) || node.kind === IRNodeKind.ClassExpression) {
+      return false;
+    }
+    if (isLoop(node)) {
+      loopDepth++;
+      walkChildren(node, visit);
+      loopDepth--;
+      return false;
+    }
+    if (node.kind === IRNodeKind.VariableDeclaration) {
+      collect(node as IRVariableDeclaration);
+    }
+    return true;
+  };
+  walk(fn.body!, visit);
+
+  function collect(declaration: IRVariableDeclaration): void {
+    for (const declarator of declaration.declarations) {
+      if (declarator.id.kind !== IRNodeKind.Identifier) {
+        walk(declarator.id, (child) => {
+          if (child.kind === IRNodeKind.Identifier) bind((child as IRIdentifier).name);
+          return true;
+        });
+        continue;
+      }
+      const name = (declarator.id as IRIdentifier).name;
+      bind(name);
+      const init = declarator.init;
+      if (declaration.declarationKind === "var" || init?.kind !== IRNodeKind.NewExpression) {
+        continue;
+      }
+      const allocation = init as IRNewExpression;
+      if (allocation.callee.kind !== IRNodeKind.Identifier) continue;
+      const className = (allocation.callee as IRIdentifier).name;
+      if (!classes.concrete.has(className)) continue;
+      allocations.push({
+        name,
+        loopDepth,
+        uses: [],
+        declaration,
+        cppType: declarator.cppType,
+        allocation,
+        className,
+      });
+    }
+  }
+
+  const boundOnce = (binding: Binding) => counts.get(binding.name) === 1;
+  return { allocations: allocations.filter(boundOnce), params: params.filter(boundOnce) };
+}
+
+/**
+ * Record and classify every reference to the tracked bindings
+ */
+function collectUses(
+  fn: FunctionLike,
+  bindings: Binding[],
+  moduleFunctions: Map<string, IRFunctionDeclaration>,
+  weakFields: Set<string>,
+): void {
+  const byName = new Map(bindings.map((binding) => [binding.name, binding]));
+  let order = 0;
+  let loopDepth = 0;
+  let nested = 0;
+  let statement: IRNode | undefined;
+
+  const visit: Visitor = (node, parent, key) => {
+    if (!FULL_EXPRESSION_STATEMENTS.has(node.kind)) {
+      return visitNode(node, parent, key);
+    }
+    const outer = statement;
+    statement = node;
+    if (visitNode(node, parent, key)) {
+      walkChildren(node, visit);
+    }
+    statement = outer;
+    return false;
+  };
+
+  const visitNode: Visitor = (node, parent, key) => {
+    // Anything referenced from a nested function or class is captured
+    if (isFunctionLike(node) || node.kind === IRNodeKind.ClassExpression) {
+      nested++;
+      walkChildren(node, visit);
+      nested--;
+      return false;
+    }
+    if (isLoop(node)) {
+      loopDepth++;
+      walkChildren(node, visit);
+      loopDepth--;
+      return false;
+    }
+    if (node.kind !== IRNodeKind.Identifier) return true;
+
+    const id = node as IRIdentifier;
+    const binding = byName.get(id.name);
+    if (binding && isReference(id, parent, key)) {
+      const use: Use = { id, kind: UseKind.Escape, order: order++, loopDepth, statement };
+      if (nested === 0) {
+        classifyUse(use, parent, key, moduleFunctions, weakFields);
+      }
+      binding.uses.push(use);
+    }
+    return false;
+  };
+
+  walk(fn.body!, visit);
+}
+
+/**
+ * Whether an identifier refers to a binding rather than naming a property
+ * or declaring a variable
+ */
+function isReference(id: IRIdentifier, parent?: IRNode, key?: string): boolean {
+  if (parent?.kind === IRNodeKind.MemberExpression && key === "property") {
+    return (parent as IRMemberExpression).computed;
+  }
+  if (parent?.kind === IRNodeKind.ObjectExpression && key === "key") {
+    const property = (parent as IRObjectExpression).properties.find((p) => p.key === id);
+    return !!property?.computed;
+  }
+  return !(parent?.kind === IRNodeKind.VariableDeclaration && key === "id");
+}
+
+function classifyUse(
+  use: Use,
+  parent: IRNode | undefined,
+  key: string | undefined,
+  moduleFunctions: Map<string, IRFunctionDeclaration>,
+  weakFields: Set<string>,
+): void {
+  switch (parent?.kind) {
+    case IRNodeKind.MemberExpression: {
+      const member = parent as IRMemberExpression;
+      if (key === "object") {
+        use.kind = !member.computed && !member.optional ? UseKind.Member : UseKind.Read;
+      }
+      break;
+    }
+
+    case IRNodeKind.BinaryExpression:
+    case IRNodeKind.UnaryExpression:
+    case IRNodeKind.TemplateLiteral:
+      use.kind = UseKind.Read;
+      break;
+
+    case IRNodeKind.ForOfStatement:
+    case IRNodeKind.ForInStatement:
+      if (key === "right") {
+        use.kind = UseKind.Read;
+      }
+      break;
+
+    case IRNodeKind.IfStatement:
+    case IRNodeKind.WhileStatement:
+    case IRNodeKind.DoWhileStatement:
+    case IRNodeKind.ConditionalExpression:
+      if (key === "test") {
+        use.kind = UseKind.Read;
+      }
+      break;
+
+    case IRNodeKind.CallExpression:
+    case IRNodeKind.NewExpression: {
+      if (key !== "arguments") break;
+      const call = parent as IRCallExpression;
+      use.kind = UseKind.Argument;
+      use.argumentIndex = call.arguments.indexOf(use.id);
+      if (
+        parent.kind === IRNodeKind.CallExpression && call.callee.kind === IRNodeKind.Identifier
+      ) {
+        use.callee = moduleFunctions.get((call.callee as IRIdentifier).name);
+      }
+      break;
+    }
+
+    case IRNodeKind.AssignmentExpression: {
+      // A weak field cannot take over a unique owner, so the object must stay shared
+      const assignment = parent as IRAssignmentExpression;
+      if (key === "right" && assignment.operator === "=" && !isWeakStore(assignment, weakFields)) {
+        use.kind = UseKind.Store;
+        use.target = assignment.left;
+      }
+      break;
+    }
+
+    case IRNodeKind.ReturnStatement:
+      if (key === "argument") {
+        use.kind = UseKind.Return;
+      }
+      break;
+  }
+}
+
+/**
+ * The single use that hands the object on, provided it is also the last use,
+ * runs at most once per binding and is the only use in its statement: in
+ * `reg(x.value, std::move(x))` the move may well run before `x.value` is read
+ */
+function findLastTransfer(binding: Binding, transfers: (use: Use) => boolean): Use | undefined {
+  const handedOn = binding.uses.filter((use) => use.kind !== UseKind.Member);
+  if (handedOn.length !== 1 || !transfers(handedOn[0])) {
+    return undefined;
+  }
+  const last = handedOn[0];
+  const isLast = binding.uses.every((use) => use.order <= last.order);
+  const alone = binding.uses.every((use) => use === last || use.statement !== last.statement);
+  return isLast && alone && last.loopDepth === binding.loopDepth ? last : undefined;
+}
+
+/**
+ * Pick storage for a `new`-initialized local
+ */
+function analyzeAllocation(
+  binding: AllocationBinding,
+  classes: ModuleClasses,
+  strategy: string,
+  results: Map<IRNode, MemoryAnalysisResult>,
+): void {
+  // Locals annotated with a base class keep a (unique) pointer for dispatch;
+  // other annotations (interfaces, any) are left to the generator
+  const declaredAsOtherType = binding.cppType !== "auto" && binding.cppType !== binding.className;
+  if (declaredAsOtherType && !classes.declared.has(binding.cppType)) return;
+
+  const confined = binding.uses.every((use) => use.kind === UseKind.Member);
+  const transfer = confined ? undefined : findLastTransfer(
+    binding,
+    (use) =>
+      use.kind === UseKind.Argument || use.kind === UseKind.Store || use.kind === UseKind.Return,
+  );
+  if (!confined && !transfer) return;
+
+  const pointerType = confined && strategy !== "unique" && !declaredAsOtherType
+    ? PointerType.Value
+    : PointerType.UniquePtr;
+
+  // Arena allocations are already cheap to make and free; only the stack beats them
+  if (strategy === "arena" && pointerType !== PointerType.Value) return;
+  const ownership: OwnershipInfo = {
+    owner: binding.declaration,
+    type: pointerType === PointerType.Value ? OwnershipType.Value : OwnershipType.Unique,
+    scope: LifetimeScope.Local,
+    movable: true,
+    copyable: false,
+  };
+
+  results.set(binding.allocation, createResult(pointerType, ownership));
+  for (const use of binding.uses) {
+    // Returned locals are moved implicitly
+    const moved = use === transfer && use.kind !== UseKind.Return;
+    results.set(use.id, createResult(pointerType, { ...ownership, movable: moved }));
+  }
+}
+
+/**
+ * Record which value-typed parameters the body writes through or reassigns.
+ * Loop variables of `for...of` over a parameter write through to it.
+ */
+function collectMutations(fn: FunctionLike, params: ParameterBinding[]): void {
+  const byName = new Map(
+    params.filter((binding) => binding.value).map((binding) => [binding.name, binding]),
+  );
+  if (byName.size === 0) return;
+  const aliases = new Map<string, ParameterBinding>();
+
+  const target = (expr: IRNode): ParameterBinding | undefined => {
+    let node = expr;
+    while (node.kind === IRNodeKind.MemberExpression) {
+      node = (node as IRMemberExpression).object;
+    }
+    if (node.kind !== IRNodeKind.Identifier) return undefined;
+    const name = (node as IRIdentifier).name;
+    return byName.get(name) ?? aliases.get(name);
+  };
+
+  const write = (expr: IRNode): void => {
+    if (expr.kind === IRNodeKind.ObjectPattern || expr.kind === IRNodeKind.ArrayPattern) {
+      walk(expr, (child) => {
+        if (child.kind === IRNodeKind.Identifier) write(child);
+        return true;
+      });
+      return;
+    }
+    const binding = target(expr);
+    if (!binding) return;
+    if (expr.kind !== IRNodeKind.Identifier) {
+      binding.mutated = true;
+    } else if (byName.get((expr as IRIdentifier).name) === binding) {
+      // Rebinding a loop variable leaves the parameter alone
+      binding.reassigned = true;
+    }
+  };
+
+  walk(fn.body!, (node) => {
+    switch (node.kind) {
+      case IRNodeKind.AssignmentExpression:
+        write((node as IRAssignmentExpression).left);
+        break;
+
+      case IRNodeKind.UpdateExpression:
+        write((node as IRUpdateExpression).argument);
+        break;
+
+      case IRNodeKind.UnaryExpression: {
+        const unary = node as IRUnaryExpression;
+        if (unary.operator === "++" || unary.operator === "--" || unary.operator === "delete") {
+          write(unary.operand);
+        }
+        break;
+      }
+
+      case IRNodeKind.CallExpression: {
+        const callee = (node as IRCallExpression).callee;
+        if (callee.kind !== IRNodeKind.MemberExpression) break;
+        const member = callee as IRMemberExpression;
+        const method = !member.computed && member.property.kind === IRNodeKind.Identifier
+          ? (member.property as IRIdentifier).name
+          : undefined;
+        const binding = method && MUTATING_METHODS.has(method) ? target(member.object) : undefined;
+        if (binding) binding.mutated = true;
+        break;
+      }
+
+      case IRNodeKind.ForOfStatement: {
+        const loop = node as IRForOfStatement;
+        const binding = target(loop.right);
+        if (binding && loop.left.kind === IRNodeKind.VariableDeclaration) {
+          for (const declarator of (loop.left as IRVariableDeclaration).declarations) {
+            if (declarator.id.kind === IRNodeKind.Identifier) {
+              aliases.set((declarator.id as IRIdentifier).name, binding);
+            }
+          }
+        }
+        break;
+      }
+    }
+    return true;
+  });
+}
+
+/**
+ * What the call sites of module functions allow their parameters to borrow
+ */
+interface CallSiteSafety {
+  /**
+   * Functions whose parameters can be borrowed mutably (`T&`): not exported,
+   * never used as values and only called with plain variables that are not
+   * const in the generated code
+   */
+  referenceSafe: Set<FunctionLike>;
+
+  /**
+   * Parameter positions of functions that are only ever given a local or a
+   * parameter of the caller. A borrowed `shared_ptr` of anything else (a
+   * global, a field) is released under the callee if that is reassigned.
+   */
+  localArguments: Map<FunctionLike, Set<number>>;
+}
+
+function collectCallSiteSafety(
+  ir: IRNode,
+  moduleFunctions: Map<string, IRFunctionDeclaration>,
+): CallSiteSafety {
+  const unsafe = new Set<string>();
+  const external = new Set<string>();
+  const globals = new Set<string>();
+  const constBound = new Set<string>();
+  const calls: { name: string; args: IRNode[] }[] = [];
+  let copyCaptures = 0;
+
+  const bindConst = (pattern: IRNode) =>
+    walk(pattern, (child) => {
+      if (child.kind === IRNodeKind.Identifier) constBound.add((child as IRIdentifier).name);
+      return true;
+    });
+
+  const visit: Visitor = (node, parent, key) => {
+    // Non-arrow function expressions capture by copy, and the copies are const
+    if (node.kind === IRNodeKind.FunctionExpression) {
+      copyCaptures++;
+      walkChildren(node, visit);
+      copyCaptures--;
+      return false;
+    }
+
+    switch (node.kind) {
+      // Callers in other translation units may pass anything
+      case IRNodeKind.Module:
+        for (const name of (node as IRModule).exports) external.add(name);
+        for (const stmt of (node as IRModule).body) {
+          if (stmt.kind !== IRNodeKind.VariableDeclaration) continue;
+          for (const declarator of (stmt as IRVariableDeclaration).declarations ?? []) {
+            walk(declarator.id, (child) => {
+              if (child.kind === IRNodeKind.Identifier) globals.add((child as IRIdentifier).name);
+              return true;
+            });
+          }
+        }
+        break;
+
+      // Loop variables and destructured names are bound as const references
+      case IRNodeKind.ForOfStatement:
+      case IRNodeKind.ForInStatement:
+        bindConst((node as IRForOfStatement).left);
+        break;
+
+      case IRNodeKind.VariableDeclaration:
+        for (const declarator of (node as IRVariableDeclaration).declarations ?? []) {
+          if (declarator.id.kind !== IRNodeKind.Identifier) bindConst(declarator.id);
+        }
+        break;
+
+      case IRNodeKind.CallExpression: {
+        const call = node as IRCallExpression;
+        if (call.callee.kind !== IRNodeKind.Identifier) break;
+        const name = (call.callee as IRIdentifier).name;
+        if (!moduleFunctions.has(name)) break;
+        calls.push({ name, args: call.arguments });
+        if (copyCaptures > 0) unsafe.add(name);
+        break;
+      }
+
+      case IRNodeKind.Identifier: {
+        const id = node as IRIdentifier;
+        const isCall = parent?.kind === IRNodeKind.CallExpression && key === "callee";
+        const isDeclaration = parent?.kind === IRNodeKind.FunctionDeclaration && key === "id";
+        if (
+          moduleFunctions.has(id.name) && !isCall && !isDeclaration &&
+          isReference(id, parent, key)
+        ) {
+          external.add(id.name);
+        }
+        break;
+      }
+    }
+    return true;
+  };
+  walk(ir, visit);
+
+  const nonLocal = new Map<string, Set<number>>();
+  for (const call of calls) {
+    const plainVariables = call.args.every((arg) =>
+      arg.kind === IRNodeKind.Identifier && !constBound.has((arg as IRIdentifier).name)
+    );
+    if (!plainVariables) unsafe.add(call.name);
+
+    const positions = nonLocal.get(call.name) ?? new Set<number>();
+    call.args.forEach((arg, index) => {
+      if (arg.kind !== IRNodeKind.Identifier || globals.has((arg as IRIdentifier).name)) {
+        positions.add(index);
+      }
+    });
+    nonLocal.set(call.name, positions);
+  }
+
+  const referenceSafe = new Set<FunctionLike>();
+  const localArguments = new Map<FunctionLike, Set<number>>();
+  for (const [name, fn] of moduleFunctions) {
+    if (external.has(name)) continue;
+    if (!unsafe.has(name)) referenceSafe.add(fn);
+    const positions = new Set<number>();
+    fn.params.forEach((_, index) => {
+      if (!nonLocal.get(name)?.has(index)) positions.add(index);
+    });
+    localArguments.set(fn, positions);
+  }
+  return { referenceSafe, localArguments };
+}
+
+/**
+ * What a parameter needs from its own body. Class-typed parameters are
+ * borrowed when the callee only accesses their members or lends them on.
+ * Value-typed parameters are borrowed unless the callee keeps or rebinds
+ * them, and borrowed mutably when it writes through them.
+ */
+function requiredPassing(
+  binding: ParameterBinding,
+  lendsTo: (use: Use) => ParameterBinding | undefined,
+): ParameterPassing {
+  if (!binding.value) {
+    const borrowed = binding.uses.every((use) =>
+      use.kind === UseKind.Member || (use.kind === UseKind.Argument && !!lendsTo(use))
+    );
+    return borrowed ? ParameterPassing.ConstReference : ParameterPassing.Value;
+  }
+
+  // Calls outside the analysis copy the argument themselves if they need to
+  const retained = binding.reassigned || binding.uses.some((use) =>
+    use.kind === UseKind.Store || use.kind === UseKind.Return || use.kind === UseKind.Escape
+  );
+  if (retained || (binding.mutated && !binding.referenceable)) {
+    return ParameterPassing.Value;
+  }
+  return binding.mutated ? ParameterPassing.Reference : ParameterPassing.ConstReference;
+}
+
+/**
+ * A parameter lent to another module function needs at least what that
+ * function's parameter needs. Starts optimistic and iterates to a fixed
+ * point, since functions may lend to each other.
+ */
+function inferParameterPassing(
+  parameters: Map<FunctionLike, ParameterBinding[]>,
+  { referenceSafe, localArguments }: CallSiteSafety,
+): void {
+  const lendsTo = (use: Use): ParameterBinding | undefined => {
+    const param = use.callee?.params[use.argumentIndex!];
+    return parameters.get(use.callee!)?.find((binding) => binding.param === param);
+  };
+
+  for (const params of parameters.values()) {
+    for (const binding of params) {
+      binding.passing = requiredPassing(binding, lendsTo);
+    }
+  }
+
+  let changed = true;
+  while (changed) {
+    changed = false;
+    for (const [fn, params] of parameters) {
+      for (const binding of params) {
+        let passing = binding.passing;
+        for (const use of binding.uses) {
+          const lent = use.kind === UseKind.Argument ? lendsTo(use) : undefined;
+          if (lent && PASSING_RANK[lent.passing] > PASSING_RANK[passing]) {
+            passing = lent.passing;
+          }
+        }
+        // Temporaries and const bindings cannot bind to `T&`
+        if (passing === ParameterPassing.Reference && !referenceSafe.has(fn)) {
+          passing = ParameterPassing.Value;
+        }
+        // Objects are only borrowed from callers that keep them alive
+        if (
+          !binding.value && passing === ParameterPassing.ConstReference &&
+          !localArguments.get(fn)?.has((fn.params ?? []).indexOf(binding.param))
+        ) {
+          passing = ParameterPassing.Value;
+        }
+        if (passing !== binding.passing) {
+          binding.passing = passing;
+          changed = true;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Record how a parameter is passed
+ */
+function analyzeParameter(
+  binding: ParameterBinding,
+  results: Map<IRNode, MemoryAnalysisResult>,
+): void {
+  const borrowed = binding.passing !== ParameterPassing.Value;
+  let pointerType = PointerType.SharedPtr;
+  if (binding.value) {
+    pointerType = binding.passing === ParameterPassing.Reference
+      ? PointerType.Reference
+      : PointerType.Value;
+  }
+  const ownership: OwnershipInfo = {
+    type: borrowed
+      ? OwnershipType.Borrowed
+      : (binding.value ? OwnershipType.Value : OwnershipType.Shared),
+    scope: LifetimeScope.Local,
+    movable: !borrowed,
+    copyable: true,
+  };
+
+  // Value-typed parameters are only moved into module functions and stores
+  const transfer = borrowed ? undefined : findLastTransfer(
+    binding,
+    (use) =>
+      use.kind === UseKind.Store ||
+      (use.kind === UseKind.Argument && (!binding.value || !!use.callee)),
+  );
+
+  results.set(binding.param as unknown as IRNode, createResult(pointerType, ownership));
+  for (const use of binding.uses) {
+    // Other uses of value-typed parameters keep their generated form
+    if (binding.value && use !== transfer) continue;
+    results.set(use.id, createResult(pointerType, { ...ownership, movable: use === transfer }));
+  }
+}
+
+/**
+ * Close the arena scope of an `@arena` function when something it allocates
+ * could outlive the scope: objects stored through `this`, a parameter or a
+ * global, or handed to a module function that keeps its argument, and any
+ * array or object value stored or pushed there. Returned values are checked
+ * against the function's return type by the transformer.
+ */
+function reportArenaEscapes(
+  fn: FunctionLike,
+  allocations: AllocationBinding[],
+  parameters: Map<FunctionLike, ParameterBinding[]>,
+  results: Map<IRNode, MemoryAnalysisResult>,
+): void {
+  const locals = new Map<string, string | undefined>();
+  walk(fn.body!, (node) => {
+    if (isFunctionLike(node) || node.kind === IRNodeKind.ClassExpression) return false;
+    if (node.kind === IRNodeKind.VariableDeclaration) {
+      for (const declarator of (node as IRVariableDeclaration).declarations ?? []) {
+        walk(declarator.id, (child) => {
+          if (child.kind === IRNodeKind.Identifier) {
+            locals.set((child as IRIdentifier).name, declarator.cppType);
+          }
+          return true;
+        });
+      }
+    }
+    return true;
+  });
+  const params = fn.params ?? [];
+
+  // Storing into a local leaves the object inside the scope
+  const outlivesScope = (target: IRNode, rebinds: boolean): boolean => {
+    let root = target;
+    while (root.kind === IRNodeKind.MemberExpression) {
+      root = (root as IRMemberExpression).object;
+    }
+    if (root.kind === IRNodeKind.ThisExpression) return true;
+    if (root.kind !== IRNodeKind.Identifier) return false;
+    const name = (root as IRIdentifier).name;
+    const isParam = params.some((param) => param.name === name);
+    return !locals.has(name) && (!isParam || !rebinds || root !== target);
+  };
+
+  // Values whose storage does not come from the arena
+  const isPlain = (value: IRNode): boolean => {
+    if (value.kind === IRNodeKind.Literal) {
+      return (value as IRLiteral).literalType !== "regexp";
+    }
+    if (value.kind !== IRNodeKind.Identifier) return false;
+    const name = (value as IRIdentifier).name;
+    const type = locals.has(name)
+      ? locals.get(name)
+      : params.find((param) => param.name === name)?.type;
+    return type !== undefined && PLAIN_TYPES.has(type);
+  };
+
+  const retainedBy = (use: Use): boolean => {
+    const param = use.callee?.params[use.argumentIndex!];
+    const binding = parameters.get(use.callee!)?.find((candidate) => candidate.param === param);
+    return binding?.passing === ParameterPassing.Value;
+  };
+
+  const reported = new Set<IRNode>();
+  const report = (node: IRNode, message: string) => {
+    const result = results.get(node) ??
+      createResult(PointerType.SharedPtr, {
+        type: OwnershipType.Shared,
+        scope: LifetimeScope.Local,
+        movable: false,
+        copyable: true,
+      });
+    result.issues.push({
+      type: MemoryIssueType.ArenaScope,
+      severity: "warning",
+      message: `${message}; the arena scope is not opened`,
+      nodes: [node],
+    });
+    results.set(node, result);
+    reported.add(node);
+  };
+
+  for (const binding of allocations) {
+    const escape = binding.uses.find((use) =>
+      (use.kind === UseKind.Store && outlivesScope(use.target!, true)) ||
+      (use.kind === UseKind.Argument && retainedBy(use))
+    );
+    if (escape) {
+      report(
+        binding.allocation,
+        `'${binding.name}' is allocated in an @arena function but ` +
+          (escape.kind === UseKind.Store ? "stored" : "kept by the callee"),
+      );
+      for (const use of binding.uses) reported.add(use.id);
+    }
+  }
+
+  // Values stored or pushed without a tracked local in between
+  walk(fn.body!, (node) => {
+    if (isFunctionLike(node) || node.kind === IRNodeKind.ClassExpression) return false;
+    let stored: IRNode[] = [];
+    if (node.kind === IRNodeKind.AssignmentExpression) {
+      const assignment = node as IRAssignmentExpression;
+      if (outlivesScope(assignment.left, true)) stored = [assignment.right];
+    } else if (node.kind === IRNodeKind.CallExpression) {
+      const callee = (node as IRCallExpression).callee;
+      if (
+        callee.kind === IRNodeKind.MemberExpression &&
+        (callee as IRMemberExpression).property.kind === IRNodeKind.Identifier &&
+        MUTATING_METHODS.has(((callee as IRMemberExpression).property as IRIdentifier).name) &&
+        outlivesScope((callee as IRMemberExpression).object, false)
+      ) {
+        stored = (node as IRCallExpression).arguments;
+      }
+    }
+    const escape = stored.find((value) => !isPlain(value) && !reported.has(value));
+    if (escape) {
+      report(
+        escape,
+        escape.kind === IRNodeKind.NewExpression
+          ? "An object allocated in an @arena function is stored"
+          : "A value built in an @arena function is stored outside it",
+      );
+    }
+    return true;
+  });
+
+  // The scope would release what escapes when the function returns
+  if (reported.size > 0) {
+    (fn as IRFunctionDeclaration).arenaScope = false;
+  }
+}
+
+function createResult(pointerType: PointerType, ownership: OwnershipInfo): MemoryAnalysisResult {
+  return { pointerType, ownership, issues: [], suggestions: [], confidence: 1 };
+}
+
+/**
+ * Depth-first walk over IR nodes following CHILD_FIELDS (src/ir/visitor.ts).
+ * Plain records (declarators, parameters, object properties) are looked
+ * through, so `parent` is the nearest IR node and `key` the field that held
+ * the visited node. The visitor returns false to skip children.
+ */
+function walk(node: IRNode, visit: Visitor, parent?: IRNode, key?: string): void {
+  if (visit(node, parent, key)) {
+    walkChildren(node, visit);
+  }
+}
+
+function walkChildren(node: IRNode, visit: Visitor): void {
+  forEachChild(node, (child, field) => walk(child, visit, node, field));
+}
@@ -0,0 +1,374 @@
+/**
+ * Reference cycle detection for class fields
+ *
+ * Class instances are held by `std::shared_ptr`, so a cycle of strong fields
+ * (a parent holding its children, each child pointing back at the parent)
+ * keeps every object in it alive forever. This builds the class field
+ * reference graph, finds its strongly connected components and turns one
+ * back-edge per cycle into a `std::weak_ptr`, reporting each change.
+ * Fields with an explicit `@weak`, `@shared` or `@unique` annotation are
+ * left as written.
+ */
+
+import {
+  type IRClassDeclaration,
+  type IRIdentifier,
+  type IRModule,
+  type IRNode,
+  IRNodeKind,
+  type IRProgram,
+  type IRPropertyDefinition,
+  MemoryManagement,
+} from "../ir/nodes.ts";
+import {
+  LifetimeScope,
+  type MemoryAnalysisResult,
+  MemoryIssueType,
+  OwnershipType,
+  PointerType,
+} from "./types.ts";
+
+/**
+ * Cycle analysis options (from ValidationConfig)
+ */
+export interface CycleOptions {
+  /** Break cycles by weakening back-edges (checkCircularDependencies) */
+  breakCycles: boolean;
+
+  /** Report cycles that cannot be broken automatically (checkMemoryLeaks) */
+  reportLeaks: boolean;
+}
+
+/**
+ * Field names that usually point back up an ownership tree
+ */
+const BACK_REFERENCE_PATTERNS = ["parent", "owner", "prev", "back", "container"];
+
+/**
+ * A strong field from one class to another
+ */
+interface FieldEdge {
+  from: string;
+  to: string;
+  field: IRPropertyDefinition;
+
+  /** Label for messages (`Declaring.field`) */
+  label: string;
+
+  /** Single nullable reference without an explicit annotation */
+  weakenable: boolean;
+}
+
+/**
+ * Find reference cycles between module classes and record the fields to
+ * weaken (and cycles that leak) in `results`
+ */
+export function analyzeReferenceCycles(
+  ir: IRNode,
+  options: CycleOptions,
+  results: Map<IRNode, MemoryAnalysisResult>,
+): void {
+  if (!options.breakCycles && !options.reportLeaks) {
+    return;
+  }
+
+  const classes = collectClassDeclarations(ir);
+  if (classes.size === 0) {
+    return;
+  }
+
+  const edges = buildFieldGraph(classes);
+  const order = [...classes.keys()];
+  const weakened = new Set<IRPropertyDefinition>();
+  const strongEdges = () => edges.filter((edge) => !weakened.has(edge.field));
+
+  let components = findCyclicComponents(order, edges);
+  while (options.breakCycles && components.length > 0) {
+    const strong = strongEdges();
+    const next = components
+      .map((component) => ({ component, edge: pickBackEdge(component, order, strong) }))
+      .find((candidate) => candidate.edge);
+    if (!next) break;
+
+    const edge = next.edge!;
+    weakened.add(edge.field);
+    results.set(edge.field, {
+      pointerType: PointerType.WeakPtr,
+      ownership: {
+        owner: classes.get(edge.from),
+        type: OwnershipType.Weak,
+        scope: LifetimeScope.Member,
+        movable: false,
+        copyable: true,
+      },
+      issues: [{
+        type: MemoryIssueType.CircularReference,
+        severity: "warning",
+        message: `Circular reference ${describe(next.component)}: ` +
+          `'${edge.label}' is emitted as std::weak_ptr to break the cycle`,
+        nodes: [edge.field],
+      }],
+      suggestions: [{
+        type: "add_annotation",
+        message: `Annotate '${edge.label}' with /** @weak */ to make this explicit`,
+        suggestedPointer: PointerType.WeakPtr,
+      }],
+      confidence: 0.8,
+    });
+
+    components = findCyclicComponents(order, strongEdges());
+  }
+
+  if (options.reportLeaks) {
+    for (const component of components) {
+      reportLeak(component, strongEdges(), results);
+    }
+  }
+}
+
+/**
+ * Top-level class declarations by name, in source order
+ */
+function collectClassDeclarations(ir: IRNode): Map<string, IRClassDeclaration> {
+  const classes = new Map<string, IRClassDeclaration>();
+  const modules = ir.kind === IRNodeKind.Program
+    ? (ir as IRProgram).modules
+    : ir.kind === IRNodeKind.Module
+    ? [ir as IRModule]
+    : [];
+
+  for (const module of modules) {
+    for (const statement of module.body) {
+      const declaration = statement.kind === IRNodeKind.ClassDeclaration
+        ? statement
+        : (statement as { declaration?: IRNode }).declaration;
+      if (declaration?.kind === IRNodeKind.ClassDeclaration) {
+        const classDecl = declaration as IRClassDeclaration;
+        if (classDecl.id) {
+          classes.set(classDecl.id.name, classDecl);
+        }
+      }
+    }
+  }
+  return classes;
+}
+
+/**
+ * Edges for every instance field, inherited fields included. A field typed
+ * as a base class may hold any subclass, so it links to those too.
+ */
+function buildFieldGraph(classes: Map<string, IRClassDeclaration>): FieldEdge[] {
+  const superOf = (cls: IRClassDeclaration): string | undefined =>
+    cls.superClass?.kind === IRNodeKind.Identifier
+      ? (cls.superClass as IRIdentifier).name
+      : undefined;
+
+  const subclasses = new Map<string, string[]>();
+  for (const [name, cls] of classes) {
+    const base = superOf(cls);
+    if (base && classes.has(base)) {
+      subclasses.set(base, [...(subclasses.get(base) ?? []), name]);
+    }
+  }
+  const withSubclasses = (name: string, seen = new Set<string>()): string[] => {
+    if (seen.has(name)) return [];
+    seen.add(name);
+    return [name, ...(subclasses.get(name) ?? []).flatMap((sub) => withSubclasses(sub, seen))];
+  };
+
+  const edges: FieldEdge[] = [];
+  for (const [name, cls] of classes) {
+    const seen = new Set<string>();
+    for (let owner: IRClassDeclaration | undefined = cls; owner && !seen.has(owner.id.name);) {
+      seen.add(owner.id.name);
+      for (const member of owner.members) {
+        if (member.kind !== IRNodeKind.VariableDeclaration) continue;
+        const field = member as IRPropertyDefinition;
+        if (field.isStatic || field.memory === MemoryManagement.Weak) continue;
+
+        const fieldName = field.key.kind === IRNodeKind.Identifier
+          ? (field.key as IRIdentifier).name
+          : String((field.key as { value?: unknown }).value);
+        for (const target of fieldTargets(field.type, classes)) {
+          for (const to of withSubclasses(target.name)) {
+            edges.push({
+              from: name,
+              to,
+              field,
+              label: `${owner.id.name}.${fieldName}`,
+              weakenable: target.single && field.memory === MemoryManagement.Auto,
+            });
+          }
+        }
+      }
+      const base = superOf(owner);
+      owner = base ? classes.get(base) : undefined;
+    }
+  }
+  return edges;
+}
+
+/**
+ * Module classes referenced by a field type. `T`, `T | null` and
+ * `Nullable<T>` are single references; anything else (arrays, maps, ...)
+ * is a container of references.
+ */
+function fieldTargets(
+  type: string,
+  classes: Map<string, IRClassDeclaration>,
+): { name: string; single: boolean }[] {
+  const nullable = type.match(/^js::typed::Nullable<(.+)>$/);
+  const parts = (nullable ? nullable[1] : type).split("|").map((part) => part.trim())
+    .filter((part) => !["null", "undefined", "js::null_t", "js::undefined_t"].includes(part));
+
+  if (parts.length === 1 && classes.has(parts[0])) {
+    return [{ name: parts[0], single: true }];
+  }
+  const names = new Set(type.match(/[A-Za-z_]\w*/g) ?? []);
+  return [...names].filter((name) => classes.has(name)).map((name) => ({ name, single: false }));
+}
+
+/**
+ * Tarjan's algorithm; returns components that contain a cycle (more than
+ * one class, or a class with a field of its own type)
+ */
+function findCyclicComponents(order: string[], edges: FieldEdge[]): string[][] {
+  const adjacency = new Map<string, string[]>();
+  for (const edge of edges) {
+    adjacency.set(edge.from, [...(adjacency.get(edge.from) ?? []), edge.to]);
+  }
+
+  const index = new Map<string, number>();
+  const lowlink = new Map<string, number>();
+  const stack: string[] = [];
+  const onStack = new Set<string>();
+  const components: string[][] = [];
+
+  const connect = (node: string) => {
+    index.set(node, index.size);
+    lowlink.set(node, index.get(node)!);
+    stack.push(node);
+    onStack.add(node);
+
+    for (const next of adjacency.get(node) ?? []) {
+      if (!index.has(next)) {
+        connect(next);
+        lowlink.set(node, Math.min(lowlink.get(node)!, lowlink.get(next)!));
+      } else if (onStack.has(next)) {
+        lowlink.set(node, Math.min(lowlink.get(node)!, index.get(next)!));
+      }
+    }
+
+    if (lowlink.get(node) === index.get(node)) {
+      const component: string[] = [];
+      let member: string;
+      do {
+        member = stack.pop()!;
+        onStack.delete(member);
+        component.push(member);
+      } while (member !== node);
+
+      const selfLoop = (adjacency.get(node) ?? []).includes(node);
+      if (component.length > 1 || selfLoop) {
+        components.push(component.sort((a, b) => order.indexOf(a) - order.indexOf(b)));
+      }
+    }
+  };
+
+  for (const node of order) {
+    if (!index.has(node)) connect(node);
+  }
+  return components.sort((a, b) => order.indexOf(a[0]) - order.indexOf(b[0]));
+}
+
+/**
+ * Choose the field to weaken in a cyclic component: a field named like a
+ * back-reference, otherwise (for cycles across classes) the first weakenable
+ * back-edge of a depth-first search from the first declared class.
+ * Self-referencing types such as linked lists are usually acyclic at
+ * runtime, so they are only weakened when the name says so.
+ */
+function pickBackEdge(
+  component: string[],
+  order: string[],
+  edges: FieldEdge[],
+): FieldEdge | undefined {
+  const members = new Set(component);
+  const internal = edges.filter((edge) => members.has(edge.from) && members.has(edge.to));
+
+  const named = internal.find((edge) =>
+    edge.weakenable && BACK_REFERENCE_PATTERNS.some((pattern) =>
+      edge.label.split(".")[1].toLowerCase().startsWith(pattern)
+    )
+  );
+  if (named || component.length === 1) {
+    return named;
+  }
+
+  const visited = new Set<string>();
+  const active = new Set<string>();
+  const search = (node: string): FieldEdge | undefined => {
+    visited.add(node);
+    active.add(node);
+    for (const edge of internal.filter((candidate) => candidate.from === node)) {
+      if (active.has(edge.to) && edge.weakenable) {
+        return edge;
+      }
+      if (!visited.has(edge.to)) {
+        const found = search(edge.to);
+        if (found) return found;
+      }
+    }
+    active.delete(node);
+    return undefined;
+  };
+  const root = component.reduce((a, b) => order.indexOf(a) <= order.indexOf(b) ? a : b);
+  return search(root);
+}
+
+/**
+ * Record a cycle that stays strong; reported on its first field
+ */
+function reportLeak(
+  component: string[],
+  edges: FieldEdge[],
+  results: Map<IRNode, MemoryAnalysisResult>,
+): void {
+  // A class that only refers to itself is a recursive structure, not a leak
+  if (component.length === 1) {
+    return;
+  }
+  const members = new Set(component);
+  const internal = edges.filter((edge) => members.has(edge.from) && members.has(edge.to));
+  if (internal.length === 0 || results.has(internal[0].field)) {
+    return;
+  }
+
+  results.set(internal[0].field, {
+    pointerType: PointerType.SharedPtr,
+    ownership: {
+      type: OwnershipType.Shared,
+      scope: LifetimeScope.Member,
+      movable: false,
+      copyable: true,
+    },
+    issues: [{
+      type: MemoryIssueType.MemoryLeak,
+      severity: "warning",
+      message: `Possible memory leak: ${component.join(" and ")} reference each other through ` +
+        `${[...new Set(internal.map((edge) => `'${edge.label}'`))].join(", ")}, ` +
+        "and no field can be weakened automatically",
+      nodes: internal.map((edge) => edge.field),
+    }],
+    suggestions: [{
+      type: "add_annotation",
+      message: "Annotate the back-reference with /** @weak */",
+      suggestedPointer: PointerType.WeakPtr,
+    }],
+    confidence: 0.6,
+  });
+}
+
+function describe(component: string[]): string {
+  return component.length === 1 ? `in ${component[0]}` : `between ${component.join(" and ")}`;
+}
@@ -156,6 +156,12 @@ export enum MemoryIssueType {
 
   /** Unnecessary heap allocation */
   UnnecessaryHeap = "unnecessary_heap",
+
+  /** Strong reference cycle that is never freed */
+  MemoryLeak = "memory_leak",
+
+  /** Arena allocation that outlives its `@arena` scope */
+  ArenaScope = "arena_scope",
 }
 
 /**
@@ -85,6 +85,30 @@ export { transpileFile } from "./transpiler.ts";
  */
 export { compile } from "./compiler.ts";
 
+/**
+ * Transpile every file of a project, in parallel with experimental.parallelCompilation
+ * @param config - Project configuration (project.include/exclude and output directory)
+ * @param options - Project root, worker count and options applied to every file
+ * @returns Promise resolving to the per-file results, in file order
+ */
+export { transpileProject } from "./project.ts";
+
+/**
+ * Options and results of a project run
+ */
+export type { ProjectFileResult, ProjectOptions, ProjectResult } from "./project.ts";
+
+/**
+ * Keep a project transpiled (and built) while its files change
+ */
+export { watchProject } from "./watch.ts";
+export type { WatchIteration, WatchOptions } from "./watch.ts";
+
+/**
+ * Per-phase timings of a run as a Chrome trace
+ */
+export { Profiler } from "./profiler.ts";
+
 /**
  * Compilation options for the compile function
  */
@@ -98,6 +122,11 @@ export type { CompileOptions } from "./compiler.ts";
  */
 export { parseTypeScript } from "./ast/parser.ts";
 
+/**
+ * Long-lived host that keeps parsed files and their programs across parses
+ */
+export { defaultProgramHost, ProgramHost } from "./ast/program-host.ts";
+
 /**
  * Generate C++ code from an IR module
  * @param module - Intermediate representation module
@@ -116,10 +145,20 @@ export type { TranspileOptions } from "./types.ts";
  */
 export type { TranspileResult } from "./types.ts";
 
+/**
+ * Per-phase timings recorded in TranspileStats.phases
+ */
+export type { PhaseTiming, PipelinePhase, TranspileStats } from "./types.ts";
+
 /**
  * Intermediate representation types
  */
-export type { IRModule, IRNode, IRProgram } from "./ir/nodes.ts";
+export type { IRModule, IRNode, IRProgram, ModuleFacts } from "./ir/nodes.ts";
+
+/**
+ * Typed IR traversal and cached per-module facts
+ */
+export { forEachChild, getModuleFacts, isIRNode, walkIR } from "./ir/visitor.ts";
 
 /**
  * Plugin system types for extending transpiler functionality
@@ -0,0 +1,176 @@
+/**
+ * Pipeline profiling
+ *
+ * Every transpile records its phases in TranspileStats.phases. A Profiler
+ * collects those of a whole run, per file, and writes them as Chrome
+ * trace-event JSON (`--profile`), viewable in chrome://tracing or Perfetto.
+ * Files transpiled at the same time (parallel project mode) are put on
+ * separate tracks.
+ */
+
+import type { PhaseTiming, PipelinePhase } from "./types.ts";
+import type { ProjectResult } from "./project.ts";
+
+/**
+ * Current time in ms since the Unix epoch, with sub-millisecond precision
+ */
+export function epochNow(): number {
+  return performance.timeOrigin + performance.now();
+}
+
+/**
+ * Records the phases of one transpile
+ */
+export class PhaseTimer {
+  readonly phases: PhaseTiming[] = [];
+
+  /**
+   * @param trace - Called with every finished phase (development.debug.tracePipeline)
+   */
+  constructor(private trace?: (timing: PhaseTiming) => void) {}
+
+  /**
+   * Run `task` as the given phase
+   */
+  async measure<T>(phase: PipelinePhase, task: () => T | Promise<T>): Promise<T> {
+    const start = epochNow();
+    try {
+      return await task();
+    } finally {
+      this.record(phase, start, epochNow() - start);
+    }
+  }
+
+  record(phase: PipelinePhase, start: number, duration: number): void {
+    const timing = { phase, start, duration };
+    this.phases.push(timing);
+    this.trace?.(timing);
+  }
+}
+
+/**
+ * Chrome trace event ("X" complete events and "M" metadata)
+ */
+export interface TraceEvent {
+  name: string;
+  cat?: string;
+  ph: "X" | "M";
+  /** Start in microseconds */
+  ts: number;
+  /** Duration in microseconds */
+  dur?: number;
+  pid: number;
+  tid: number;
+  args?: Record<string, unknown>;
+}
+
+/**
+ * Phase timings of a run, per file
+ */
+export class Profiler {
+  private files: Array<{ file: string; phases: PhaseTiming[] }> = [];
+
+  /**
+   * Add the phases of one file; phases without a file (a whole C++ build) use ""
+   */
+  add(file: string, phases: PhaseTiming[]): void {
+    if (phases.length > 0) {
+      this.files.push({ file, phases });
+    }
+  }
+
+  /**
+   * Add the files of a project run; cached and reused files only contribute
+   * the phases that actually ran
+   */
+  addProject(result: ProjectResult): void {
+    for (const file of result.files) {
+      const transpiled = file.cached || file.reused ? [] : file.result?.stats.phases ?? [];
+      this.add(file.module.relativePath, [
+        ...transpiled,
+        ...(file.writeTiming ? [file.writeTiming] : []),
+      ]);
+    }
+  }
+
+  /**
+   * Total time per phase over all files, in pipeline order
+   */
+  totals(): Map<PipelinePhase, number> {
+    const totals = new Map<PipelinePhase, number>();
+    for (const { phases } of this.files) {
+      for (const { phase, duration } of phases) {
+        totals.set(phase, (totals.get(phase) ?? 0) + duration);
+      }
+    }
+    return new Map([...totals].sort(([a], [b]) => PHASE_ORDER[a] - PHASE_ORDER[b]));
+  }
+
+  /**
+   * Trace events, one per phase and file, with timestamps relative to the
+   * first phase
+   */
+  toTraceEvents(): TraceEvent[] {
+    const spans = this.files
+      .map(({ file, phases }) => ({
+        file,
+        phases,
+        start: Math.min(...phases.map((timing) => timing.start)),
+        end: Math.max(...phases.map((timing) => timing.start + timing.duration)),
+      }))
+      .sort((a, b) => a.start - b.start);
+    const origin = spans[0]?.start ?? 0;
+
+    // Overlapping files go on different tracks, so each track nests properly
+    const trackEnds: number[] = [];
+    const events: TraceEvent[] = [];
+    for (const span of spans) {
+      let track = trackEnds.findIndex((end) => end <= span.start);
+      if (track === -1) {
+        track = trackEnds.length;
+        events.push({
+          name: "thread_name",
+          ph: "M",
+          ts: 0,
+          pid: 1,
+          tid: track + 1,
+          args: { name: `track ${track + 1}` },
+        });
+      }
+      trackEnds[track] = span.end;
+
+      for (const { phase, start, duration } of span.phases) {
+        events.push({
+          name: phase,
+          cat: "pipeline",
+          ph: "X",
+          ts: Math.round((start - origin) * 1000),
+          dur: Math.round(duration * 1000),
+          pid: 1,
+          tid: track + 1,
+          args: span.file ? { file: span.file } : undefined,
+        });
+      }
+    }
+    return events;
+  }
+
+  /**
+   * The trace as a JSON document for chrome://tracing
+   */
+  toChromeTrace(): string {
+    return JSON.stringify({ traceEvents: this.toTraceEvents(), displayTimeUnit: "ms" });
+  }
+}
+
+const PHASE_ORDER: Record<PipelinePhase, number> = {
+  pluginLoad: 0,
+  parse: 1,
+  typeCheck: 2,
+  transform: 3,
+  memoryAnalysis: 4,
+  codegen: 5,
+  sourceMap: 6,
+  write: 7,
+  compile: 8,
+};
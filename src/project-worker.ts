@@ -0,0 +1,29 @@
+/**
+ * Transpiler worker for parallel project compilation (see project.ts)
+ *
+ * Each message carries one file's source and options; the worker transpiles
+ * it and posts back the result or the error.
+ */
+
+import { TranspilerError } from "./errors.ts";
+import type { WorkerRequest, WorkerResponse } from "./project.ts";
+import { transpile } from "./transpiler.ts";
+
+self.onmessage = async (event: MessageEvent<WorkerRequest>) => {
+  const { id, source, options } = event.data;
+  let response: WorkerResponse;
+  try {
+    response = { id, result: await transpile(source, options) };
+  } catch (error) {
+    response = {
+      id,
+      error: error instanceof TranspilerError
+        ? { message: error.message, code: error.code, location: error.location }
+        : {
+          message: error instanceof Error ? error.message : String(error),
+          code: "INTERNAL_ERROR",
+        },
+    };
+  }
+  self.postMessage(response);
+};
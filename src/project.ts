@@ -0,0 +1,590 @@
+/**
+ * Project mode: transpile every file of a typescript2cxx project
+ *
+ * Files come from `project.include`/`project.exclude`, imports between them
+ * form the module dependency graph, and a module is transpiled once the
+ * modules it imports are done. With `experimental.parallelCompilation` ready
+ * modules are spread over a pool of Deno workers; results are always reported
+ * and written in file order, however the work was scheduled.
+ *
+ * With `experimental.incrementalCompilation` unchanged files come from the
+ * transpile cache (cache.ts) and outputs are only rewritten when they change.
+ * Given the previous result and the changed files (watch.ts), only those
+ * files and the modules importing them are transpiled again.
+ */
+
+import ts from "typescript";
+import { walk } from "@std/fs";
+import { dirname, globToRegExp, join, relative, resolve } from "@std/path";
+import { TranspileCache, writeIfChanged } from "./cache.ts";
+import { TranspilerError } from "./errors.ts";
+import { transpile } from "./transpiler.ts";
+import type { PhaseTiming, TranspileOptions, TranspileResult } from "./types.ts";
+import { epochNow } from "./profiler.ts";
+import type { ProjectConfig, TranspilerConfig } from "./config/types.ts";
+import { generateCMakeFromConfig } from "./cmake/config-integration.ts";
+
+/** Files of a project without a `project` section */
+const DEFAULT_PROJECT_FILES = { include: ["**/*.ts"], exclude: ["**/node_modules/**"] };
+
+/**
+ * Options for a project run
+ */
+export interface ProjectOptions {
+  /** Project root; include/exclude patterns and output paths are relative to it */
+  root?: string;
+
+  /** Output directory, overriding project.output.directory */
+  outputDir?: string;
+
+  /** Transpile options applied to every file (on top of those from the config) */
+  transpileOptions?: TranspileOptions;
+
+  /** Worker count for parallel compilation (default: hardware concurrency) */
+  workers?: number;
+
+  /** Write the generated files (default: true) */
+  write?: boolean;
+
+  /** Runtime directory for the generated CMakeLists.txt */
+  runtimeDir?: string;
+
+  /** Transpile cache directory (default: .typescript2cxx-cache in the output directory) */
+  cacheDir?: string;
+
+  /** Result of the previous run, reused for modules not affected by `changed` */
+  previous?: ProjectResult;
+
+  /** Files changed since `previous` (absolute paths, including removed files) */
+  changed?: string[];
+}
+
+/**
+ * A project file and the project files it imports
+ */
+export interface ProjectModule {
+  /** Absolute path */
+  path: string;
+
+  /** Path relative to the project root, with forward slashes */
+  relativePath: string;
+
+  /** Absolute paths of the imported project files, in import order */
+  imports: string[];
+}
+
+/**
+ * Module dependency graph of a project
+ */
+export interface ProjectGraph {
+  /** Modules sorted by relative path */
+  modules: ProjectModule[];
+
+  /** Importers of each module, by absolute path */
+  dependents: Map<string, string[]>;
+}
+
+/**
+ * Outcome for one project file
+ */
+export interface ProjectFileResult {
+  module: ProjectModule;
+  headerPath: string;
+  sourcePath: string;
+  result?: TranspileResult;
+  error?: TranspilerError;
+
+  /** Result taken from the transpile cache */
+  cached?: boolean;
+
+  /** Header or source content changed and was written */
+  written?: boolean;
+
+  /** Taken over from the previous run without transpiling */
+  reused?: boolean;
+
+  /** Time spent writing the outputs */
+  writeTiming?: PhaseTiming;
+}
+
+/**
+ * Outcome of a project run
+ */
+export interface ProjectResult {
+  /** One entry per module, in graph order */
+  files: ProjectFileResult[];
+  graph: ProjectGraph;
+  cmakeListsPath?: string;
+  success: boolean;
+  timeMs: number;
+}
+
+/**
+ * Find the project's source files, sorted by relative path
+ */
+export async function discoverProjectFiles(
+  root: string,
+  project: Pick<ProjectConfig, "include" | "exclude">,
+): Promise<string[]> {
+  const globOptions = { extended: true, globstar: true };
+  const include = project.include.map((pattern) => globToRegExp(pattern, globOptions));
+  const exclude = project.exclude.map((pattern) => globToRegExp(pattern, globOptions));
+  const files: string[] = [];
+
+  for await (const entry of walk(root, { includeDirs: false, exts: [".ts", ".tsx"] })) {
+    const relativePath = toProjectPath(root, entry.path);
+    if (
+      include.some((pattern) => pattern.test(relativePath)) &&
+      !exclude.some((pattern) => pattern.test(relativePath))
+    ) {
+      files.push(resolve(entry.path));
+    }
+  }
+
+  return files.sort((a, b) => compareStrings(toProjectPath(root, a), toProjectPath(root, b)));
+}
+
+/**
+ * Build the dependency graph from the relative imports of the given files
+ *
+ * With a previous graph over the same files, only the changed files are read
+ * again; the imports of the others still resolve to the same modules.
+ */
+export async function buildProjectGraph(
+  root: string,
+  files: string[],
+  previous?: { graph: ProjectGraph; changed: string[] },
+): Promise<ProjectGraph> {
+  const known = new Set(files.map((file) => resolve(file)));
+  const modules: ProjectModule[] = [];
+
+  const sameFiles = previous?.graph.modules.length === known.size &&
+    previous.graph.modules.every((module) => known.has(module.path));
+  const reusable = new Map(
+    sameFiles ? previous!.graph.modules.map((module) => [module.path, module]) : [],
+  );
+  const changed = new Set(previous?.changed.map((file) => resolve(file)));
+
+  for (const file of [...known].sort((a, b) => compareStrings(a, b))) {
+    const unchanged = !changed.has(file) ? reusable.get(file) : undefined;
+    if (unchanged) {
+      modules.push(unchanged);
+      continue;
+    }
+    const source = await Deno.readTextFile(file);
+    // Import and export-from specifiers, without a full parse
+    const { importedFiles } = ts.preProcessFile(source, true, false);
+    const imports: string[] = [];
+    for (const { fileName } of importedFiles) {
+      const target = resolveProjectImport(file, fileName, known);
+      if (target && !imports.includes(target)) {
+        imports.push(target);
+      }
+    }
+    modules.push({ path: file, relativePath: toProjectPath(root, file), imports });
+  }
+
+  modules.sort((a, b) => compareStrings(a.relativePath, b.relativePath));
+
+  const dependents = new Map<string, string[]>(modules.map((module) => [module.path, []]));
+  for (const module of modules) {
+    for (const target of module.imports) {
+      dependents.get(target)!.push(module.path);
+    }
+  }
+
+  return { modules, dependents };
+}
+
+/**
+ * The changed modules and every module importing them, directly or not
+ */
+export function affectedModules(graph: ProjectGraph, changed: string[]): Set<string> {
+  const affected = new Set<string>();
+  const queue = changed.map((file) => resolve(file));
+  while (queue.length > 0) {
+    const path = queue.pop()!;
+    const dependents = graph.dependents.get(path);
+    if (!dependents || affected.has(path)) continue;
+    affected.add(path);
+    queue.push(...dependents);
+  }
+  return affected;
+}
+
+/**
+ * Run `task` for every module, each after the modules it imports
+ *
+ * At most `concurrency` tasks run at once. Modules in an import cycle are
+ * released in graph order once nothing else is ready. Results are keyed by
+ * module path, so completion order does not leak into the output.
+ */
+export async function scheduleProject<T>(
+  graph: ProjectGraph,
+  concurrency: number,
+  task: (module: ProjectModule) => Promise<T>,
+): Promise<Map<string, T>> {
+  const results = new Map<string, T>();
+  const waitingOn = new Map<string, number>(
+    graph.modules.map((module) => [module.path, module.imports.length]),
+  );
+  const pending = new Set(graph.modules.map((module) => module.path));
+  const modules = new Map(graph.modules.map((module) => [module.path, module]));
+  const running = new Set<Promise<void>>();
+
+  const nextReady = (): ProjectModule | undefined => {
+    for (const path of pending) {
+      if (waitingOn.get(path) === 0) return modules.get(path);
+    }
+    // Only cycles are left: release the first pending module
+    if (running.size === 0 && pending.size > 0) {
+      return modules.get(pending.values().next().value!);
+    }
+    return undefined;
+  };
+
+  while (pending.size > 0 || running.size > 0) {
+    while (running.size < Math.max(1, concurrency)) {
+      const current = nextReady();
+      if (!current) break;
+      pending.delete(current.path);
+      const run: Promise<void> = task(current).then((result) => {
+        results.set(current.path, result);
+        for (const dependent of graph.dependents.get(current.path) ?? []) {
+          waitingOn.set(dependent, waitingOn.get(dependent)! - 1);
+        }
+        running.delete(run);
+      });
+      running.add(run);
+    }
+    if (running.size > 0) {
+      await Promise.race(running);
+    }
+  }
+
+  return results;
+}
+
+/**
+ * Transpile a whole project
+ */
+export async function transpileProject(
+  config: TranspilerConfig,
+  options: ProjectOptions = {},
+): Promise<ProjectResult> {
+  const startTime = performance.now();
+  const root = resolve(options.root ?? ".");
+  const project = config.project ?? DEFAULT_PROJECT_FILES;
+  const outputDir = resolve(root, options.outputDir ?? config.project?.output?.directory ?? ".");
+  const preserveStructure = config.project?.output?.preserveStructure ?? true;
+
+  const files = await discoverProjectFiles(root, project);
+  const previous = options.previous && options.changed
+    ? { result: options.previous, changed: options.changed }
+    : undefined;
+  const graph = await buildProjectGraph(
+    root,
+    files,
+    previous && { graph: previous.result.graph, changed: previous.changed },
+  );
+  const transpileOptions = { ...configToTranspileOptions(config), ...options.transpileOptions };
+  const outputs = planOutputs(graph, outputDir, preserveStructure);
+
+  // Importers of a removed file only show up in the previous graph
+  const affected = previous && new Set([
+    ...affectedModules(previous.result.graph, previous.changed),
+    ...affectedModules(graph, previous.changed),
+  ]);
+  const previousFiles = new Map(
+    previous?.result.files.map((file) => [file.module.path, file]),
+  );
+
+  const cache = config.experimental?.incrementalCompilation
+    ? new TranspileCache(options.cacheDir ?? join(outputDir, ".typescript2cxx-cache"))
+    : undefined;
+
+  const run = async (
+    module: ProjectModule,
+    transpileSource: (source: string, options: TranspileOptions) => Promise<TranspileResult>,
+  ): Promise<ProjectFileResult> => {
+    const { headerPath, sourcePath, outputName } = outputs.get(module.path)!;
+    const fileOptions = { ...transpileOptions, filename: module.path, outputName };
+    const last = previousFiles.get(module.path);
+    if (
+      affected && !affected.has(module.path) && last?.result &&
+      last.headerPath === headerPath && last.sourcePath === sourcePath
+    ) {
+      return { module, headerPath, sourcePath, result: last.result, reused: true };
+    }
+    try {
+      const source = await Deno.readTextFile(module.path);
+      const key = cache && await cache.key(source, fileOptions);
+      const cached = key ? await cache!.get(key) : undefined;
+      if (cached) {
+        return { module, headerPath, sourcePath, result: cached, cached: true };
+      }
+      const result = await transpileSource(source, fileOptions);
+      if (key) await cache!.set(key, result);
+      return { module, headerPath, sourcePath, result, cached: false };
+    } catch (error) {
+      return { module, headerPath, sourcePath, error: toTranspilerError(error) };
+    }
+  };
+
+  // Workers only pay off when more than one module has to be transpiled
+  const toTranspile = graph.modules.filter((module) =>
+    !affected || affected.has(module.path) || !previousFiles.has(module.path)
+  ).length;
+  let results: Map<string, ProjectFileResult>;
+  if (config.experimental?.parallelCompilation && toTranspile > 1) {
+    const pool = new TranspileWorkerPool(
+      Math.min(options.workers ?? navigator.hardwareConcurrency ?? 4, toTranspile),
+    );
+    try {
+      results = await scheduleProject(
+        graph,
+        pool.size,
+        (module) => run(module, (source, opts) => pool.transpile(source, opts)),
+      );
+    } finally {
+      pool.terminate();
+    }
+  } else {
+    results = await scheduleProject(graph, 1, (module) => run(module, transpile));
+  }
+
+  // Write in graph order, whatever order the modules finished in
+  const fileResults = graph.modules.map((module) => results.get(module.path)!);
+  const success = fileResults.every((file) => !file.error);
+  let cmakeListsPath: string | undefined;
+
+  if (options.write ?? true) {
+    for (const file of fileResults) {
+      // Reused outputs are already on disk
+      if (!file.result || file.reused) continue;
+      const writeStart = epochNow();
+      await Deno.mkdir(dirname(file.headerPath), { recursive: true });
+      const headerWritten = await writeIfChanged(file.headerPath, file.result.header);
+      const sourceWritten = await writeIfChanged(file.sourcePath, file.result.source);
+      file.written = headerWritten || sourceWritten;
+      file.writeTiming = { phase: "write", start: writeStart, duration: epochNow() - writeStart };
+    }
+
+    const cmake = success
+      ? generateCMakeFromConfig(
+        config,
+        fileResults.map((file) => toProjectPath(outputDir, file.sourcePath)),
+        fileResults.map((file) => toProjectPath(outputDir, file.headerPath)),
+        options.runtimeDir,
+      )
+      : null;
+    if (cmake) {
+      cmakeListsPath = join(outputDir, "CMakeLists.txt");
+      await writeIfChanged(cmakeListsPath, cmake);
+    }
+  }
+
+  // Reused modules never look up their cache entries, so only a full run prunes
+  if (!previous) {
+    await cache?.prune();
+  }
+
+  return {
+    files: fileResults,
+    graph,
+    cmakeListsPath,
+    success,
+    timeMs: performance.now() - startTime,
+  };
+}
+
+/**
+ * Transpile options implied by a project configuration
+ */
+export function configToTranspileOptions(config: TranspilerConfig): TranspileOptions {
+  const options: TranspileOptions = {};
+  const standard = config.target?.standard;
+  if (standard === "c++17" || standard === "c++20" || standard === "c++23") {
+    options.standard = standard;
+  }
+  if (config.compilation?.optimization?.level) {
+    options.optimization = config.compilation.optimization.level;
+  }
+  if (config.emit?.generateSourceMaps !== undefined) {
+    options.sourceMap = config.emit.generateSourceMaps;
+  }
+  if (config.types?.mappings) {
+    options.typeMappings = config.types.mappings;
+  }
+  if (config.experimental?.modules !== undefined) {
+    options.useModules = config.experimental.modules;
+  }
+  if (config.development?.debug?.tracePipeline) {
+    options.tracePipeline = true;
+  }
+  if (config.validation) {
+    options.validation = {
+      checkCircularDependencies: config.validation.checkCircularDependencies,
+      checkMemoryLeaks: config.validation.checkMemoryLeaks,
+    };
+  }
+  const plugins = config.plugins?.filter((plugin): plugin is string => typeof plugin === "string");
+  if (plugins && plugins.length > 0) {
+    options.plugins = plugins;
+  }
+  return options;
+}
+
+/**
+ * Header and source paths per module; generated includes are relative
+ * ("./util.h"), so the output keeps the source layout unless told otherwise
+ */
+function planOutputs(
+  graph: ProjectGraph,
+  outputDir: string,
+  preserveStructure: boolean,
+): Map<string, { headerPath: string; sourcePath: string; outputName: string }> {
+  const outputs = new Map<string, { headerPath: string; sourcePath: string; outputName: string }>();
+  const claimed = new Map<string, string>();
+
+  for (const module of graph.modules) {
+    const stem = module.relativePath.replace(/\.tsx?$/, "");
+    const outputStem = preserveStructure ? stem : stem.split("/").pop()!;
+    const previous = claimed.get(outputStem);
+    if (previous) {
+      throw new TranspilerError(
+        `${module.relativePath} and ${previous} both map to ${outputStem}.h; ` +
+          `enable project.output.preserveStructure`,
+        "OUTPUT_CONFLICT",
+      );
+    }
+    claimed.set(outputStem, module.relativePath);
+    outputs.set(module.path, {
+      headerPath: join(outputDir, `${outputStem}.h`),
+      sourcePath: join(outputDir, `${outputStem}.cpp`),
+      outputName: outputStem.split("/").pop()!,
+    });
+  }
+
+  return outputs;
+}
+
+/**
+ * Resolve a relative import to a project file, if it names one
+ */
+function resolveProjectImport(
+  importer: string,
+  specifier: string,
+  known: Set<string>,
+): string | undefined {
+  if (!specifier.startsWith("./") && !specifier.startsWith("../")) {
+    return undefined;
+  }
+  const base = resolve(dirname(importer), specifier);
+  const candidates = [
+    base,
+    base.replace(/\.js$/, ".ts"),
+    `${base}.ts`,
+    `${base}.tsx`,
+    join(base, "index.ts"),
+  ];
+  return candidates.find((candidate) => known.has(candidate));
+}
+
+function toProjectPath(root: string, path: string): string {
+  return relative(root, path).replaceAll("\\", "/");
+}
+
+function compareStrings(a: string, b: string): number {
+  return a < b ? -1 : a > b ? 1 : 0;
+}
+
+function toTranspilerError(error: unknown): TranspilerError {
+  if (error instanceof TranspilerError) return error;
+  return new TranspilerError(
+    error instanceof Error ? error.message : String(error),
+    "INTERNAL_ERROR",
+  );
+}
+
+/**
+ * Message from the driver to a worker (see project-worker.ts)
+ */
+export interface WorkerRequest {
+  id: number;
+  source: string;
+  options: TranspileOptions;
+}
+
+/**
+ * Message from a worker back to the driver
+ */
+export type WorkerResponse =
+  | { id: number; result: TranspileResult }
+  | { id: number; error: Pick<TranspilerError, "message" | "code" | "location"> };
+
+/**
+ * Fixed pool of transpiler workers, one file in flight per worker
+ */
+class TranspileWorkerPool {
+  private idle: Worker[] = [];
+  private queue: Array<(worker: Worker) => void> = [];
+  private workers: Worker[] = [];
+  private nextId = 0;
+
+  constructor(readonly size: number) {
+    for (let i = 0; i < size; i++) {
+      const worker = new Worker(new URL("./project-worker.ts", import.meta.url).href, {
+        type: "module",
+      });
+      this.workers.push(worker);
+      this.idle.push(worker);
+    }
+  }
+
+  async transpile(source: string, options: TranspileOptions): Promise<TranspileResult> {
+    const worker = await this.acquire();
+    try {
+      return await new Promise<TranspileResult>((resolvePromise, reject) => {
+        const id = this.nextId++;
+        worker.onmessage = (event: MessageEvent<WorkerResponse>) => {
+          if (event.data.id !== id) return;
+          if ("result" in event.data) {
+            resolvePromise(event.data.result);
+          } else {
+            const { message, code, location } = event.data.error;
+            reject(new TranspilerError(message, code, location));
+          }
+        };
+        worker.onerror = (event) => {
+          event.preventDefault();
+          reject(new TranspilerError(`${options.filename}: ${event.message}`, "INTERNAL_ERROR"));
+        };
+        worker.postMessage({ id, source, options } satisfies WorkerRequest);
+      });
+    } finally {
+      this.release(worker);
+    }
+  }
+
+  terminate(): void {
+    for (const worker of this.workers) {
+      worker.terminate();
+    }
+  }
+
+  private acquire(): Promise<Worker> {
+    const worker = this.idle.pop();
+    if (worker) return Promise.resolve(worker);
+    return new Promise((resolvePromise) => this.queue.push(resolvePromise));
+  }
+
+  private release(worker: Worker): void {
+    const waiter = this.queue.shift();
+    if (waiter) {
+      waiter(worker);
+    } else {
+      this.idle.push(worker);
+    }
+  }
+}
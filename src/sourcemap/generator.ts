@@ -250,6 +250,36 @@ export class SourceMapGenerator {
   }
 }
 
+/**
+ * Create a source map from the positions code generation recorded while
+ * writing the output (see CodeWriter.mark)
+ */
+export function createRecordedSourceMap(
+  originalSource: string,
+  originalFilename: string,
+  mappings: SourceMapMapping[],
+  generatedFilename?: string,
+): string {
+  const generator = new SourceMapGenerator({
+    file: generatedFilename || "output.cpp",
+    sourceRoot: "",
+  });
+  generator.addSource(originalFilename, originalSource);
+
+  for (const mapping of mappings) {
+    generator.addMapping(
+      mapping.generatedLine,
+      mapping.generatedColumn,
+      mapping.originalLine,
+      mapping.originalColumn,
+      originalFilename,
+      mapping.name,
+    );
+  }
+
+  return generator.toString();
+}
+
 /**
  * Create a source map for TypeScript to C++ transpilation
  */
@@ -45,6 +45,7 @@ import type {
   IRImportNamespaceSpecifier as _IRImportNamespaceSpecifier,
   IRImportSpecifier,
   IRInterfaceDeclaration,
+  IRInterfaceMember,
   IRLiteral,
   IRMemberExpression,
   IRMethodDefinition,
@@ -77,6 +78,7 @@ import type {
   IRVariableDeclaration,
   IRVariableDeclarator,
   IRWhileStatement,
+  IRYieldExpression,
 } from "../ir/nodes.ts";
 import { AccessModifier, IRNodeKind, MemoryManagement, VariableKind } from "../ir/nodes.ts";
 import { UnsupportedFeatureError as _UnsupportedFeatureError } from "../errors.ts";
@@ -222,6 +224,8 @@ class ASTTransformer {
     for (const statement of ast.statements) {
       const stmt = this.transformModuleItem(statement);
       if (stmt) {
+        // Statement positions end up in the source map
+        stmt.location ??= this.getLocation(statement);
         this.context.currentModule.body.push(stmt);
       }
     }
@@ -554,8 +558,9 @@ class ASTTransformer {
       returnType,
       body: null as unknown as IRBlockStatement,
       isAsync,
-      isGenerator: false,
+      isGenerator: !!node.asteriskToken,
       templateParams,
+      arenaScope: this.hasArenaTag(node, name, isAsync || !!node.asteriskToken, returnType),
     };
 
     // Transform body with function context
@@ -623,6 +628,7 @@ class ASTTransformer {
       members: [],
       isAbstract: !!node.modifiers?.some((m) => m.kind === ts.SyntaxKind.AbstractKeyword),
       templateParams,
+      isPooled: ts.getJSDocTags(node).some((tag) => tag.tagName.text === "pooled"),
     };
 
     // Collect class decorators
@@ -859,6 +865,9 @@ class ASTTransformer {
         init: decl.initializer ? this.transformExpression(decl.initializer) : undefined,
         memory: MemoryManagement.Auto,
       };
+      if (decl.type && ts.isIntersectionTypeNode(decl.type)) {
+        declarator.isIntersection = true;
+      }
 
       declarations.push(declarator);
     }
@@ -881,12 +890,18 @@ class ASTTransformer {
    * Transform interface declaration
    */
   private transformInterfaceDeclaration(node: ts.InterfaceDeclaration): IRInterfaceDeclaration {
+    const baseTypes = (node.heritageClauses ?? [])
+      .filter((clause) => clause.token === ts.SyntaxKind.ExtendsKeyword)
+      .flatMap((clause) => clause.types.map((type) => type.expression.getText()));
+
     return {
       kind: IRNodeKind.InterfaceDeclaration,
       id: { kind: IRNodeKind.Identifier, name: node.name.text },
-      extends: [],
+      extends: baseTypes,
+      typeParameters: node.typeParameters?.map((tp) => this.transformTypeParameter(tp)),
+      isSoa: this.hasSoaTag(node),
       body: {
-        body: [],
+        body: this.transformTypeMembers(node.members),
       },
     };
   }
@@ -894,13 +909,89 @@ class ASTTransformer {
   /**
    * Transform type alias
    */
-  private transformTypeAlias(_node: ts.TypeAliasDeclaration): null {
-    // Type aliases don't generate runtime code
+  private transformTypeAlias(node: ts.TypeAliasDeclaration): IRInterfaceDeclaration | null {
+    // An object type alias has the same layout as an interface
+    if (ts.isTypeLiteralNode(node.type)) {
+      return {
+        kind: IRNodeKind.InterfaceDeclaration,
+        id: { kind: IRNodeKind.Identifier, name: node.name.text },
+        extends: [],
+        typeParameters: node.typeParameters?.map((tp) => this.transformTypeParameter(tp)),
+        isSoa: this.hasSoaTag(node),
+        body: {
+          body: this.transformTypeMembers(node.type.members),
+        },
+      };
+    }
+
+    // Other type aliases don't generate runtime code
     // They are compile-time only constructs in TypeScript
     // Return null to skip code generation
     return null;
   }
 
+  /**
+   * Transform interface / type literal members
+   */
+  private transformTypeMembers(members: ts.NodeArray<ts.TypeElement>): IRInterfaceMember[] {
+    const result: IRInterfaceMember[] = [];
+
+    for (const member of members) {
+      if (ts.isPropertySignature(member)) {
+        result.push({
+          kind: IRNodeKind.PropertySignature,
+          key: this.transformMemberKey(member.name),
+          type: this.resolveType(member.type),
+          optional: !!member.questionToken,
+          readonly: !!member.modifiers?.some((m) => m.kind === ts.SyntaxKind.ReadonlyKeyword),
+        });
+      } else if (ts.isMethodSignature(member)) {
+        result.push({
+          kind: IRNodeKind.MethodSignature,
+          key: this.transformMemberKey(member.name),
+          params: this.transformParameters(member.parameters),
+          returnType: this.resolveType(member.type),
+          optional: !!member.questionToken,
+        });
+      } else if (ts.isIndexSignatureDeclaration(member)) {
+        const param = member.parameters[0];
+        result.push({
+          kind: IRNodeKind.IndexSignature,
+          indexName: param && ts.isIdentifier(param.name) ? param.name.text : "key",
+          indexType: this.resolveType(param?.type),
+          valueType: this.resolveType(member.type),
+          readonly: !!member.modifiers?.some((m) => m.kind === ts.SyntaxKind.ReadonlyKeyword),
+        });
+      } else {
+        // Call and construct signatures are kept as opaque methods
+        result.push({
+          kind: IRNodeKind.MethodSignature,
+          key: { kind: IRNodeKind.Literal, value: "()", raw: "()", literalType: "string" },
+          params: [],
+          returnType: "auto",
+          optional: false,
+        });
+      }
+    }
+
+    return result;
+  }
+
+  /**
+   * Whether a record type is annotated `@soa` (struct-of-arrays storage)
+   */
+  private hasSoaTag(node: ts.InterfaceDeclaration | ts.TypeAliasDeclaration): boolean {
+    return ts.getJSDocTags(node).some((tag) => tag.tagName.text === "soa");
+  }
+
+  private transformMemberKey(name: ts.PropertyName): IRIdentifier | IRLiteral {
+    if (ts.isIdentifier(name)) {
+      return { kind: IRNodeKind.Identifier, name: name.text };
+    }
+    const text = ts.isStringLiteral(name) || ts.isNumericLiteral(name) ? name.text : name.getText();
+    return { kind: IRNodeKind.Literal, value: text, raw: name.getText(), literalType: "string" };
+  }
+
   /**
    * Transform enum declaration
    */
@@ -1198,9 +1289,20 @@ class ASTTransformer {
   }
 
   /**
-   * Transform any statement
+   * Transform any statement, keeping its position for the source map
    */
   private transformStatement(node: ts.Statement): IRStatement {
+    const stmt = this.transformStatementNode(node);
+    if (node) {
+      stmt.location ??= this.getLocation(node);
+    }
+    return stmt;
+  }
+
+  /**
+   * Transform a statement by kind
+   */
+  private transformStatementNode(node: ts.Statement): IRStatement {
     if (!node) {
       // Return an empty block statement for undefined nodes
       const emptyBlock: IRBlockStatement = {
@@ -1318,6 +1420,9 @@ class ASTTransformer {
       case ts.SyntaxKind.AwaitExpression:
         return this.transformAwaitExpression(node as ts.AwaitExpression);
 
+      case ts.SyntaxKind.YieldExpression:
+        return this.transformYieldExpression(node as ts.YieldExpression);
+
       case ts.SyntaxKind.TypeOfExpression:
         return this.transformTypeOfExpression(node as ts.TypeOfExpression);
 
@@ -1897,6 +2002,17 @@ class ASTTransformer {
     };
   }
 
+  /**
+   * Transform yield expression
+   */
+  private transformYieldExpression(node: ts.YieldExpression): IRYieldExpression {
+    return {
+      kind: IRNodeKind.YieldExpression,
+      argument: node.expression ? this.transformExpression(node.expression) : undefined,
+      delegate: !!node.asteriskToken,
+    };
+  }
+
   /**
    * Transform new expression
    */
@@ -2481,6 +2597,48 @@ class ASTTransformer {
     currentScope.set(name, node);
   }
 
+  /**
+   * Whether a function opens an arena scope (`@arena` JSDoc tag with
+   * --memory=arena). Suspended coroutines would interleave arena scopes, so
+   * async functions and generators are skipped, as are functions returning
+   * values that may hold arena storage.
+   */
+  private hasArenaTag(
+    node: ts.FunctionDeclaration,
+    name: string,
+    isCoroutine: boolean,
+    returnType: string,
+  ): boolean {
+    if (
+      this.options.context.options.memoryStrategy !== "arena" ||
+      !ts.getJSDocTags(node).some((tag) => tag.tagName.text === "arena")
+    ) {
+      return false;
+    }
+    const report = (message: string) =>
+      this.options.context.warnings.push({
+        code: "ARENA_SCOPE",
+        message,
+        location: this.getLocation(node),
+        severity: "warning",
+      });
+
+    if (isCoroutine) {
+      report(`@arena is ignored on async and generator function '${name}'`);
+      return false;
+    }
+    // An inferred return type may be anything the body allocated
+    const returned = returnType === "auto"
+      ? (returnsValue(node) ? "an inferred type" : "void")
+      : returnType;
+    // The returned value would point into the arena once the scope resets
+    if (!["void", "bool", "js::number", "js::string"].includes(returned)) {
+      report(`'${name}' is marked @arena but returns ${returned}; the arena scope is not opened`);
+      return false;
+    }
+    return true;
+  }
+
   private warn(message: string): void {
     this.context.warnings.push({
       code: "TRANSFORM_WARNING",
@@ -2721,3 +2879,15 @@ class ASTTransformer {
     return modifiers ? modifiers.some((m) => m.kind === ts.SyntaxKind.ConstKeyword) : false;
   }
 }
+
+/**
+ * Whether a function body returns a value (nested functions aside)
+ */
+function returnsValue(node: ts.FunctionDeclaration): boolean {
+  const visit = (child: ts.Node): boolean => {
+    if (ts.isFunctionLike(child) || ts.isClassLike(child)) return false;
+    if (ts.isReturnStatement(child) && child.expression) return true;
+    return ts.forEachChild(child, visit) ?? false;
+  };
+  return !!node.body && visit(node.body);
+}
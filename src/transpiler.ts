@@ -8,7 +8,7 @@ import type {
   CompilerContext,
   TranspileOptions,
   TranspileResult,
-  TranspilerWarning as _TranspilerWarning,
+  TranspilerWarning,
   TranspileStats,
   TypeChecker,
 } from "./types.ts";
@@ -17,11 +17,21 @@ import type { Plugin, PluginContext } from "./plugins/types.ts";
 // These will be implemented as we build out the transpiler
 import { transformToIR } from "./transform/transformer.ts";
 import { generateCpp } from "./codegen/generator.ts";
-import { analyzeMemory } from "./memory/analyzer.ts";
-import type { MemoryAnalysisResult } from "./memory/types.ts";
-import type { IRNode } from "./ir/nodes.ts";
-import { IRNodeKind } from "./ir/nodes.ts";
+import { analyzeMemory, toMemoryManagement } from "./memory/analyzer.ts";
+import { type MemoryAnalysisResult, OwnershipType, PointerType } from "./memory/types.ts";
+import type {
+  IRIdentifier,
+  IRNewExpression,
+  IRNode,
+  IRParameter,
+  IRProgram,
+  IRPropertyDefinition,
+  IRVariableDeclaration,
+} from "./ir/nodes.ts";
+import { IRNodeKind, MemoryManagement, ParameterPassing } from "./ir/nodes.ts";
+import { getModuleFacts } from "./ir/visitor.ts";
 import { loadPlugins } from "./plugins/loader.ts";
+import { epochNow, PhaseTimer } from "./profiler.ts";
 
 /**
  * Transpile TypeScript code to C++
@@ -42,8 +52,17 @@ export async function transpile(
     optimizationsApplied: 0,
   };
 
+  // Per-phase timings, logged as they finish with development.debug.tracePipeline
+  const file = options.filename ?? "<anonymous>";
+  const timer = new PhaseTimer(
+    options.tracePipeline
+      ? ({ phase, duration }) => console.error(`[trace] ${file} ${phase} ${duration.toFixed(2)}ms`)
+      : undefined,
+  );
+
   try {
     // Load plugins
+    const pluginStart = epochNow();
     const plugins = await loadPlugins(options.plugins ?? []);
 
     // Create compiler context with extended properties
@@ -63,8 +82,10 @@ export async function transpile(
         await plugin.onInit(createPluginContext(plugin, context));
       }
     }
+    timer.record("pluginLoad", pluginStart, epochNow() - pluginStart);
 
     // Parse TypeScript with type checking enabled
+    const parseStart = epochNow();
     const parseResult = parseTypeScript(source, {
       filename: options.filename ?? "<anonymous>",
       tsx: options.tsx ?? false,
@@ -75,6 +96,8 @@ export async function transpile(
         typeMappings: options.typeMappings,
       },
     });
+    timer.record("parse", parseStart, parseResult.parseTime);
+    timer.record("typeCheck", parseStart + parseResult.parseTime, parseResult.typeCheckTime);
 
     // Check for type errors
     if (parseResult.typeCheckResult?.hasErrors) {
@@ -94,36 +117,47 @@ export async function transpile(
     }
 
     // Transform to IR with type checker
-    const ir = transformToIR(parseResult.ast, {
-      context,
-      plugins,
-      errorReporter,
-      outputName: options.outputName,
-      source,
-      filename: options.filename,
-      typeChecker: parseResult.typeChecker,
+    const ir = await timer.measure("transform", () => {
+      const program = transformToIR(parseResult.ast, {
+        context,
+        plugins,
+        errorReporter,
+        outputName: options.outputName,
+        source,
+        filename: options.filename,
+        typeChecker: parseResult.typeChecker,
+      });
+      stats.nodesProcessed = countIRNodes(program);
+      return program;
     });
 
-    stats.nodesProcessed = countIRNodes(ir);
-
     // Analyze memory management
     if (options.memoryStrategy !== "manual") {
-      const memoryResults = await analyzeMemory(ir, {
-        strategy: options.memoryStrategy ?? "auto",
-        options: options as Record<string, unknown>,
-      });
+      await timer.measure("memoryAnalysis", async () => {
+        const memoryResults = await analyzeMemory(ir, {
+          strategy: options.memoryStrategy ?? "auto",
+          options: options as Record<string, unknown>,
+        });
 
-      // Apply memory analysis results
-      applyMemoryAnalysis(ir, memoryResults);
+        // Apply memory analysis results
+        applyMemoryAnalysis(ir, memoryResults, context.warnings);
+      });
     }
 
-    // Generate C++ code
+    // Generate C++ code; the source map is built last and timed on its own
+    const codegenStart = epochNow();
     const generated = await generateCpp(ir, {
       options: context.options,
       context,
       plugins,
       errorReporter,
     });
+    const sourceMapTime = generated.sourceMapTime ?? 0;
+    const codegenEnd = epochNow();
+    timer.record("codegen", codegenStart, codegenEnd - codegenStart - sourceMapTime);
+    if (generated.sourceMap !== undefined) {
+      timer.record("sourceMap", codegenEnd - sourceMapTime, sourceMapTime);
+    }
 
     stats.linesGenerated = countLines(generated.header) + countLines(generated.source);
 
@@ -146,6 +180,7 @@ export async function transpile(
     }
 
     stats.timeMs = performance.now() - startTime;
+    stats.phases = timer.phases;
 
     return {
       header: generated.header,
@@ -290,29 +325,11 @@ function createPluginContext(plugin: Plugin, context: CompilerContext): PluginCo
 }
 
 /**
- * Count IR nodes for statistics
+ * Count IR nodes for statistics; the walk also computes the module facts
+ * that code generation reads later
  */
-function countIRNodes(node: IRNode): number {
-  let count = 1;
-
-  // Count child nodes recursively
-  const nodeAsRecord = node as unknown as Record<string, unknown>;
-  for (const key of Object.keys(nodeAsRecord)) {
-    const value = nodeAsRecord[key];
-    if (value && typeof value === "object") {
-      if (Array.isArray(value)) {
-        for (const item of value) {
-          if (item && typeof item === "object" && "kind" in item) {
-            count += countIRNodes(item as IRNode);
-          }
-        }
-      } else if ("kind" in value) {
-        count += countIRNodes(value as IRNode);
-      }
-    }
-  }
-
-  return count;
+function countIRNodes(program: IRProgram): number {
+  return program.modules.reduce((count, module) => count + getModuleFacts(module).nodeCount, 1);
 }
 
 /**
@@ -325,7 +342,55 @@ function countLines(code: string): number {
 /**
  * Apply memory analysis results to IR
  */
-function applyMemoryAnalysis(_ir: IRNode, _results: Map<IRNode, MemoryAnalysisResult>): void {
-  // TODO: Apply memory analysis results to IR nodes
-  // This would modify pointer types based on analysis
+function applyMemoryAnalysis(
+  _ir: IRNode,
+  results: Map<IRNode, MemoryAnalysisResult>,
+  warnings: TranspilerWarning[],
+): void {
+  for (const [node, result] of results) {
+    const memory = toMemoryManagement(result.pointerType);
+
+    for (const issue of result.issues) {
+      warnings.push({
+        code: issue.type.toUpperCase(),
+        message: issue.message,
+        location: node.location,
+        severity: issue.severity,
+      });
+    }
+
+    if (node.kind === IRNodeKind.NewExpression) {
+      (node as IRNewExpression).memory = memory;
+
+      // The declarator that owns the allocation gets the matching storage
+      const owner = result.ownership.owner;
+      if (owner?.kind === IRNodeKind.VariableDeclaration) {
+        for (const declarator of (owner as IRVariableDeclaration).declarations) {
+          if (declarator.init === node) {
+            declarator.memory = memory;
+          }
+        }
+      }
+    } else if (node.kind === IRNodeKind.Identifier) {
+      const id = node as IRIdentifier;
+      id.memory = memory;
+      id.isMoved = result.ownership.movable;
+    } else if (node.kind === IRNodeKind.VariableDeclaration && "key" in node) {
+      // Class fields only change when cycle analysis weakened them
+      if (memory === MemoryManagement.Weak) {
+        (node as IRPropertyDefinition).memory = memory;
+      }
+    } else if ("isRest" in node) {
+      // Parameters are plain records rather than IR nodes
+      const param = node as unknown as IRParameter;
+      param.memory = memory;
+      if (result.pointerType === PointerType.Reference) {
+        param.passing = ParameterPassing.Reference;
+      } else if (result.ownership.type === OwnershipType.Borrowed) {
+        param.passing = ParameterPassing.ConstReference;
+      } else {
+        param.passing = ParameterPassing.Value;
+      }
+    }
+  }
 }
@@ -5,6 +5,7 @@
  */
 
 import ts from "typescript";
+import { getLibSourceFile } from "../ast/program-host.ts";
 import type { ResolvedType, TypeCheckerOptions, TypeCheckResult } from "./types.ts";
 
 /**
@@ -29,6 +30,13 @@ export class TypeChecker {
     this.checker = this.program.getTypeChecker();
   }
 
+  /**
+   * Program behind this checker, to pass as `oldProgram` to the next one
+   */
+  getProgram(): ts.Program {
+    return this.program;
+  }
+
   /**
    * Create a TypeScript program for type checking
    */
@@ -49,7 +57,12 @@ export class TypeChecker {
     // Create custom compiler host
     const host = this.createCompilerHost(sourceFile, source, compilerOptions);
 
-    return ts.createProgram([sourceFile.fileName], compilerOptions, host);
+    return ts.createProgram({
+      rootNames: [sourceFile.fileName],
+      options: compilerOptions,
+      host,
+      oldProgram: this.options.oldProgram,
+    });
   }
 
   /**
@@ -65,18 +78,17 @@ export class TypeChecker {
     return {
       getSourceFile: (
         fileName: string,
-        languageVersion: ts.ScriptTarget,
-        onError?: (message: string) => void,
+        languageVersion: ts.ScriptTarget | ts.CreateSourceFileOptions,
       ): ts.SourceFile | undefined => {
         // Use our source file for the main file
         if (fileName === sourceFile.fileName) {
           return sourceFile;
         }
 
-        // Try to get lib files from default host
+        // Lib files are parsed once per process and shared between checkers
         if (fileName.includes("lib.") && fileName.endsWith(".d.ts")) {
           try {
-            return defaultHost.getSourceFile(fileName, languageVersion, onError);
+            return getLibSourceFile(fileName, languageVersion);
           } catch {
             // Return minimal lib if default fails
             return undefined;
@@ -423,6 +423,28 @@ export class SimpleTypeChecker {
             return typedArrayMap[typeName];
           }
 
+          // Async iteration protocols map to the runtime's async generator
+          const asyncIterableTypes = [
+            "AsyncGenerator",
+            "AsyncIterable",
+            "AsyncIterableIterator",
+            "AsyncIterator",
+          ];
+          if (asyncIterableTypes.includes(typeName)) {
+            const elementType = typeRef.typeArguments && typeRef.typeArguments.length > 0
+              ? this.resolveTypeNode(typeRef.typeArguments[0]).cppType
+              : "js::any";
+            return `js::AsyncGenerator<${elementType}>`;
+          }
+
+          // Generator objects map to the runtime's lazy generator range
+          if (typeName === "Generator" || typeName === "IterableIterator") {
+            const elementType = typeRef.typeArguments && typeRef.typeArguments.length > 0
+              ? this.resolveTypeNode(typeRef.typeArguments[0]).cppType
+              : "js::any";
+            return `js::Generator<${elementType}>`;
+          }
+
           if (typeName === "Array" && typeRef.typeArguments && typeRef.typeArguments.length > 0) {
             const elementType = this.resolveTypeNode(typeRef.typeArguments[0]);
             return `js::array<${elementType.cppType}>`;
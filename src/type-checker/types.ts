@@ -19,6 +19,9 @@ export interface TypeCheckerOptions {
 
   /** Additional type definition files */
   typeDefinitions?: string[];
+
+  /** Previous program for the same file, reused where it is unchanged */
+  oldProgram?: ts.Program;
 }
 
 /**
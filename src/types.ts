@@ -2,6 +2,8 @@
  * Core types for the TypeScript to C++ transpiler
  */
 
+import type { ValidationConfig } from "./config/types.ts";
+
 export interface TranspileOptions {
   /** Source filename for error reporting */
   filename?: string;
@@ -25,7 +27,7 @@ export interface TranspileOptions {
   optimization?: "O0" | "O1" | "O2" | "O3" | "Os";
 
   /** Memory management strategy */
-  memoryStrategy?: "auto" | "shared" | "unique" | "manual";
+  memoryStrategy?: "auto" | "shared" | "unique" | "manual" | "arena";
 
   /** Plugins to apply */
   plugins?: string[];
@@ -50,6 +52,12 @@ export interface TranspileOptions {
 
   /** Generate reflection metadata */
   generateReflection?: boolean;
+
+  /** Memory checks (reference cycles are weakened and leaks reported by default) */
+  validation?: Partial<Pick<ValidationConfig, "checkCircularDependencies" | "checkMemoryLeaks">>;
+
+  /** Log every pipeline phase with its duration to stderr */
+  tracePipeline?: boolean;
 }
 
 export interface TranspileResult {
@@ -118,6 +126,36 @@ export interface TranspileStats {
 
   /** Number of optimizations applied */
   optimizationsApplied: number;
+
+  /** Pipeline phases in the order they ran */
+  phases?: PhaseTiming[];
+}
+
+/**
+ * Stages of the pipeline, from loading plugins to compiling the C++ output
+ */
+export type PipelinePhase =
+  | "pluginLoad"
+  | "parse"
+  | "typeCheck"
+  | "transform"
+  | "memoryAnalysis"
+  | "codegen"
+  | "sourceMap"
+  | "write"
+  | "compile";
+
+/**
+ * One run of a pipeline phase
+ */
+export interface PhaseTiming {
+  phase: PipelinePhase;
+
+  /** Start, in ms since the Unix epoch (comparable across workers) */
+  start: number;
+
+  /** Duration in ms */
+  duration: number;
 }
 
 export interface FileInput {
@@ -0,0 +1,176 @@
+/**
+ * Watch mode for projects
+ *
+ * The first iteration is a full project run. After that, file system events
+ * are collected for `development.watch.debounce` ms and only the changed
+ * modules and the modules importing them are transpiled again; outputs that
+ * come out the same keep their timestamps. With `build`, the generated CMake
+ * project is built in a persistent build directory after every iteration, so
+ * the C++ side also recompiles only what changed. Each iteration reports the
+ * latency from the first file event to the transpiled (and built) output.
+ */
+
+import { join, resolve } from "@std/path";
+import { defaultProgramHost } from "./ast/program-host.ts";
+import { CMakeBuild, type CMakeBuildResult } from "./cmake/build.ts";
+import { TranspilerError } from "./errors.ts";
+import { type ProjectOptions, type ProjectResult, transpileProject } from "./project.ts";
+import type { TranspilerConfig } from "./config/types.ts";
+
+/** Debounce for file events without development.watch.debounce */
+export const DEFAULT_DEBOUNCE_MS = 100;
+
+/**
+ * Options for a watch session
+ */
+export interface WatchOptions extends Omit<ProjectOptions, "previous" | "changed"> {
+  /** Build the generated CMake project after every iteration */
+  build?: boolean;
+
+  /** CMake build directory (default: build in the output directory) */
+  buildDir?: string;
+
+  /** Extra arguments for the CMake configure step */
+  cmakeArgs?: string[];
+
+  /** Milliseconds to wait for more file events before an iteration */
+  debounce?: number;
+
+  /** Called after every iteration */
+  onIteration?: (iteration: WatchIteration) => void | Promise<void>;
+
+  /** Called when an iteration fails as a whole (not for per-file errors) */
+  onError?: (error: unknown) => void;
+
+  /** Stops the session */
+  signal?: AbortSignal;
+}
+
+/**
+ * One iteration of a watch session
+ */
+export interface WatchIteration {
+  /** Files whose change started the iteration; empty for the initial run */
+  changed: string[];
+
+  result: ProjectResult;
+
+  /** Modules transpiled in this iteration; the others were reused */
+  transpiled: number;
+
+  build?: CMakeBuildResult;
+
+  /** From the first file event to the transpiled (and built) output, in ms */
+  latencyMs: number;
+}
+
+/**
+ * Transpile a project, then keep it up to date until the signal aborts
+ */
+export async function watchProject(
+  config: TranspilerConfig,
+  options: WatchOptions = {},
+): Promise<void> {
+  if (options.build && !config.integration?.cmake?.generate) {
+    throw new TranspilerError(
+      "Building in watch mode needs integration.cmake.generate",
+      "CONFIG_ERROR",
+    );
+  }
+
+  const root = resolve(options.root ?? ".");
+  const outputDir = resolve(root, options.outputDir ?? config.project?.output?.directory ?? ".");
+  const debounce = options.debounce ?? config.development?.watch?.debounce ?? DEFAULT_DEBOUNCE_MS;
+  const builder = options.build
+    ? new CMakeBuild(outputDir, options.buildDir ?? join(outputDir, "build"), options.cmakeArgs)
+    : undefined;
+  let previous: ProjectResult | undefined;
+
+  const iterate = async (changed: string[], startTime: number) => {
+    const result = await transpileProject(config, {
+      ...options,
+      root,
+      outputDir,
+      previous,
+      changed: previous ? changed : undefined,
+    });
+
+    // Removed files no longer need their parsed trees
+    for (const module of previous?.graph.modules ?? []) {
+      if (!result.graph.dependents.has(module.path)) {
+        defaultProgramHost.forget(module.path);
+      }
+    }
+    previous = result;
+
+    const build = builder && result.success && result.cmakeListsPath
+      ? await builder.build()
+      : undefined;
+    await options.onIteration?.({
+      changed,
+      result,
+      transpiled: result.files.filter((file) => !file.reused).length,
+      build,
+      latencyMs: performance.now() - startTime,
+    });
+  };
+
+  await iterate([], performance.now());
+  if (options.signal?.aborted) return;
+
+  await watchSourceChanges(root, debounce, async (changed, startTime) => {
+    try {
+      await iterate(changed, startTime);
+    } catch (error) {
+      options.onError?.(error);
+    }
+  }, options.signal);
+}
+
+/**
+ * Call `handler` with the TypeScript files changed under `root`, once no
+ * event arrived for `debounce` ms; calls never overlap, and events arriving
+ * during one are collected for the next. The handler also gets the time of
+ * the first event it covers, for latency reporting. Handlers report their
+ * own errors; a rejected call does not end the session.
+ */
+export async function watchSourceChanges(
+  root: string,
+  debounce: number,
+  handler: (changed: string[], firstChange: number) => Promise<void>,
+  signal?: AbortSignal,
+): Promise<void> {
+  const watcher = Deno.watchFs(root, { recursive: true });
+  signal?.addEventListener("abort", () => watcher.close(), { once: true });
+
+  const changes = new Set<string>();
+  let firstChange = 0;
+  let timer: number | undefined;
+  let running = Promise.resolve();
+
+  const flush = () => {
+    timer = undefined;
+    const changed = [...changes].sort();
+    const startTime = firstChange;
+    changes.clear();
+    running = running.then(() => handler(changed, startTime)).catch(() => {});
+  };
+
+  for await (const event of watcher) {
+    if (event.kind === "access") continue;
+    const sources = event.paths.filter((path) => /\.tsx?$/.test(path));
+    if (sources.length === 0) continue;
+
+    if (changes.size === 0) {
+      firstChange = performance.now();
+    }
+    for (const path of sources) {
+      changes.add(resolve(path));
+    }
+    clearTimeout(timer);
+    timer = setTimeout(flush, debounce);
+  }
+
+  clearTimeout(timer);
+  await running;
+}
@@ -69,7 +69,19 @@ async function processTestFile(testPath: string): Promise<TestResult> {
     await ensureDir(runtimeDir);
 
     // Copy all runtime files
-    const runtimeFiles = ["core.h", "core.cpp", "type_guards.h"];
+    const runtimeFiles = [
+      "core.h",
+      "core.cpp",
+      "memory_resource.h",
+      "memory_stats.h",
+      "arena.h",
+      "type_guards.h",
+      "typed_wrappers.h",
+    ];
+    await ensureDir(join(runtimeDir, "core"));
+    for await (const entry of Deno.readDir(join(runtimePath, "core"))) {
+      runtimeFiles.push(`core/${entry.name}`);
+    }
     for (const file of runtimeFiles) {
       try {
         await Deno.copyFile(join(runtimePath, file), join(runtimeDir, file));
@@ -211,7 +211,18 @@ async function runTest(testName: string, code: string): Promise<TestResult> {
     const runtimeDir = join(testDir, "runtime");
     await ensureDir(runtimeDir);
 
-    const runtimeFiles = ["core.h", "typed_wrappers.h", "type_guards.h"];
+    const runtimeFiles = [
+      "core.h",
+      "memory_resource.h",
+      "memory_stats.h",
+      "arena.h",
+      "typed_wrappers.h",
+      "type_guards.h",
+    ];
+    await ensureDir(join(runtimeDir, "core"));
+    for await (const entry of Deno.readDir(join(Deno.cwd(), "runtime", "core"))) {
+      runtimeFiles.push(`core/${entry.name}`);
+    }
     await Promise.all(runtimeFiles.map(async (file) => {
       const sourcePath = join(Deno.cwd(), "runtime", file);
       const destPath = join(runtimeDir, file);
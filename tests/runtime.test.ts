@@ -262,7 +262,7 @@ describe("Runtime Library v0.3.0", () => {
       const code = `const x = 1;`;
       const result = await transpile(code);
 
-      assertStringIncludes(result.header, '"runtime/core.h"');
+      assertStringIncludes(result.header, '"runtime/core/any.h"');
       assertStringIncludes(result.header, "using namespace js;");
     });
   });
@@ -0,0 +1,150 @@
+/**
+ * Tests for the arena memory strategy (runtime/arena.h)
+ */
+
+import { describe, it } from "@std/testing/bdd";
+import { assertEquals, assertStringIncludes } from "@std/assert";
+import { transpile } from "../../src/transpiler.ts";
+
+const RECORD = `
+class Field {
+  name: string;
+  constructor(name: string) {
+    this.name = name;
+  }
+}
+
+class Record {
+  fields: Field[] = [];
+}
+`;
+
+describe("Arena Memory Strategy", () => {
+  it("should allocate class instances from the current arena", async () => {
+    const input = RECORD + `
+/** @arena */
+function handle(names: string[]): number {
+  const record = new Record();
+  for (const name of names) {
+    const field = new Field(name);
+    record.fields.push(field);
+  }
+  return record.fields.length;
+}
+`;
+
+    const result = await transpile(input, { memoryStrategy: "arena" });
+    assertStringIncludes(result.source, "js::ArenaScope arena_scope;");
+    assertStringIncludes(result.source, "js::arena_new<Field>(name)");
+    assertEquals(result.source.includes("std::make_shared<Field>"), false);
+    assertEquals(result.source.includes("std::make_unique<Field>"), false);
+  });
+
+  it("should only open arena scopes in functions marked @arena", async () => {
+    const input = RECORD + `
+function make(name: string): Field {
+  return new Field(name);
+}
+`;
+
+    const result = await transpile(input, { memoryStrategy: "arena" });
+    assertStringIncludes(result.source, "js::arena_new<Field>(name)");
+    assertEquals(result.source.includes("js::ArenaScope"), false);
+  });
+
+  it("should keep stack allocation for confined instances", async () => {
+    const input = RECORD + `
+/** @arena */
+function nameLength(name: string): number {
+  const field = new Field(name);
+  return field.name.length;
+}
+`;
+
+    const result = await transpile(input, { memoryStrategy: "arena" });
+    assertStringIncludes(result.source, "Field field = Field(name);");
+  });
+
+  it("should warn when an arena function returns allocated objects", async () => {
+    const input = RECORD + `
+/** @arena */
+function build(name: string): Field {
+  return new Field(name);
+}
+`;
+
+    const result = await transpile(input, { memoryStrategy: "arena" });
+    const warning = result.warnings.find((w) => w.code === "ARENA_SCOPE");
+    assertStringIncludes(warning!.message, "'build' is marked @arena");
+    assertEquals(result.source.includes("js::ArenaScope"), false);
+  });
+
+  it("should warn when an arena function returns an inferred type", async () => {
+    const input = RECORD + `
+/** @arena */
+function build(name: string) {
+  return new Field(name);
+}
+`;
+
+    const result = await transpile(input, { memoryStrategy: "arena" });
+    const warning = result.warnings.find((w) => w.code === "ARENA_SCOPE");
+    assertStringIncludes(warning!.message, "returns an inferred type");
+  });
+
+  it("should warn when an arena allocation is stored beyond the scope", async () => {
+    const input = RECORD + `
+class Holder {
+  field: Field | null = null;
+}
+
+/** @arena */
+function keep(holder: Holder, name: string): void {
+  const field = new Field(name);
+  holder.field = field;
+}
+`;
+
+    const result = await transpile(input, { memoryStrategy: "arena" });
+    const warning = result.warnings.find((w) => w.code === "ARENA_SCOPE");
+    assertStringIncludes(warning!.message, "'field' is allocated in an @arena function");
+    assertEquals(result.source.includes("js::ArenaScope"), false);
+  });
+
+  it("should not open the scope when an array built in it is stored outside", async () => {
+    const input = `
+/** @arena */
+function collect(rows: number[][], n: number): void {
+  const row: number[] = [];
+  row.push(n);
+  rows.push(row);
+}
+
+/** @arena */
+function count(totals: number[], n: number): void {
+  const row: number[] = [n, n];
+  totals.push(n);
+}
+`;
+
+    const result = await transpile(input, { memoryStrategy: "arena" });
+    const warning = result.warnings.find((w) => w.code === "ARENA_SCOPE");
+    assertStringIncludes(warning!.message, "stored outside it; the arena scope is not opened");
+    assertEquals(result.source.split("js::ArenaScope arena_scope;").length, 2);
+  });
+
+  it("should ignore @arena under other strategies", async () => {
+    const input = RECORD + `
+/** @arena */
+function make(name: string): number {
+  const record = new Record();
+  record.fields.push(new Field(name));
+  return record.fields.length;
+}
+`;
+
+    const result = await transpile(input);
+    assertEquals(result.source.includes("js::ArenaScope"), false);
+    assertStringIncludes(result.source, "std::make_shared<Field>(name)");
+  });
+});
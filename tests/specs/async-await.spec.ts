@@ -194,7 +194,12 @@ async function fetchAll(): Promise<void> {
 `;
 
       const result = await transpile(input, { standard: "c++20" });
-      assertEquals((result.header + result.source).includes("co_await js::Promise::all"), true);
+      assertEquals(
+        (result.header + result.source).includes(
+          "co_await js::promise_all(fetch1(), fetch2(), fetch3())",
+        ),
+        true,
+      );
     });
 
     it("should handle Promise.race", async () => {
@@ -209,7 +214,10 @@ async function fetchFirst(): Promise<string> {
 `;
 
       const result = await transpile(input, { standard: "c++20" });
-      assertEquals((result.header + result.source).includes("co_await js::Promise::race"), true);
+      assertEquals(
+        (result.header + result.source).includes("co_await js::promise_race(fetch1(), fetch2())"),
+        true,
+      );
       assertEquals((result.header + result.source).includes("co_return result"), true);
     });
 
@@ -0,0 +1,75 @@
+/**
+ * Tests for async generators and for await...of
+ */
+
+import { describe, it } from "@std/testing/bdd";
+import { assertEquals, assertStringIncludes } from "@std/assert";
+import { transpile } from "../../src/transpiler.ts";
+
+describe("Async Iteration", () => {
+  describe("Async generators", () => {
+    it("should lower async function* to js::AsyncGenerator", async () => {
+      const input = `
+async function* numbers(limit: number): AsyncGenerator<number> {
+  for (let i = 0; i < limit; i++) {
+    yield i;
+  }
+}
+`;
+
+      const result = await transpile(input, { standard: "c++20" });
+      assertStringIncludes(result.header, "js::AsyncGenerator<js::number> numbers(");
+      assertStringIncludes(result.source, "co_yield i");
+      assertStringIncludes(result.header, "runtime/async.h");
+    });
+
+    it("should use the first type argument as the element type", async () => {
+      const input = `
+async function* lines(): AsyncGenerator<string, void, unknown> {
+  yield "a";
+  return;
+}
+`;
+
+      const result = await transpile(input, { standard: "c++20" });
+      assertStringIncludes(result.header, "js::AsyncGenerator<js::string> lines()");
+      assertStringIncludes(result.source, "co_return;");
+    });
+  });
+
+  describe("for await...of", () => {
+    it("should lower for await to a co_await loop", async () => {
+      const input = `
+async function sum(source: AsyncIterable<number>): Promise<number> {
+  let total = 0;
+  for await (const value of source) {
+    total += value;
+  }
+  return total;
+}
+`;
+
+      const result = await transpile(input, { standard: "c++20" });
+      assertStringIncludes(result.source, "auto&& value_iter = js::async_iter(source);");
+      assertStringIncludes(result.source, "auto value_step = co_await value_iter.next();");
+      assertStringIncludes(result.source, "if (value_step.done) break;");
+      assertStringIncludes(result.source, "const auto& value = value_step.value;");
+    });
+
+    it("should keep plain for...of as a range-for", async () => {
+      const input = `
+function sum(values: number[]): number {
+  let total = 0;
+  for (const value of values) {
+    total += value;
+  }
+  return total;
+}
+`;
+
+      const result = await transpile(input);
+      assertStringIncludes(result.source, "for (const auto& value : values)");
+      assertEquals(result.source.includes("js::async_iter"), false);
+    });
+  });
+});
@@ -0,0 +1,80 @@
+/**
+ * Tests for AbortController/AbortSignal and timers (runtime/abort.h, runtime/timers.h)
+ */
+
+import { describe, it } from "@std/testing/bdd";
+import { assertEquals, assertStringIncludes } from "@std/assert";
+import { transpile } from "../../src/transpiler.ts";
+import { TypeMapper } from "../../src/codegen/generators/type-mapper.ts";
+
+describe("Cancellation", () => {
+  it("should construct AbortController as a value type", async () => {
+    const input = `
+const controller = new AbortController();
+`;
+
+    const result = await transpile(input, { standard: "c++20" });
+    assertStringIncludes(result.header + result.source, "js::AbortController()");
+    assertEquals((result.header + result.source).includes("make_shared<js::AbortController>"), false);
+    assertStringIncludes(result.header, '#include "runtime/abort.h"');
+  });
+
+  it("should map AbortSignal static factories", async () => {
+    const input = `
+async function load(path: string): Promise<string> {
+  const signal = AbortSignal.timeout(5000);
+  return await Deno.readTextFile(path);
+}
+`;
+
+    const result = await transpile(input, { standard: "c++20" });
+    assertStringIncludes(result.source, "js::AbortSignal::timeout(");
+    assertStringIncludes(result.header, '#include "runtime/abort.h"');
+  });
+
+  it("should include abort.h for signal parameters", async () => {
+    const input = `
+async function poll(signal: AbortSignal): Promise<void> {
+  signal.throwIfAborted();
+}
+`;
+
+    const result = await transpile(input, { standard: "c++20" });
+    assertStringIncludes(result.header, "js::AbortSignal signal");
+    assertStringIncludes(result.header, '#include "runtime/abort.h"');
+  });
+
+  it("should read signal.aborted and signal.reason as properties", async () => {
+    const input = `
+function check(signal: AbortSignal): void {
+  if (signal.aborted) {
+    throw signal.reason;
+  }
+}
+`;
+
+    const result = await transpile(input, { standard: "c++20" });
+    assertStringIncludes(result.source, "if (signal.aborted)");
+    assertStringIncludes(result.source, "signal.reason");
+    assertEquals(result.source.includes("signal.aborted()"), false);
+  });
+
+  it("should map setTimeout and drain the event loop", async () => {
+    const input = `
+const id = setTimeout(() => console.log("later"), 100);
+clearTimeout(id);
+`;
+
+    const result = await transpile(input, { standard: "c++20" });
+    assertStringIncludes(result.source, "js::setTimeout(");
+    assertStringIncludes(result.source, "js::clearTimeout(");
+    assertStringIncludes(result.header, '#include "runtime/timers.h"');
+    assertStringIncludes(result.source, "js::EventLoop::instance().run();");
+  });
+
+  it("should map cancellation types", () => {
+    const mapper = new TypeMapper();
+    assertEquals(mapper.mapType("AbortSignal"), "js::AbortSignal");
+    assertEquals(mapper.mapType("AbortController"), "js::AbortController");
+  });
+});
@@ -0,0 +1,70 @@
+/**
+ * Tests for the indentation-aware code writer (src/codegen/writer.ts)
+ */
+
+import { describe, it } from "@std/testing/bdd";
+import { assertEquals, assertStringIncludes } from "@std/assert";
+import { CodeWriter } from "../../src/codegen/writer.ts";
+import { transpile } from "../../src/transpiler.ts";
+
+describe("Code Writer", () => {
+  it("should indent every line that starts at the current level", () => {
+    const writer = new CodeWriter();
+    writer.writeLine("if (x) {").indent();
+    writer.writeLine("f();\ng();");
+    writer.write("h(").write("1);").writeLine();
+    writer.writeLine();
+    writer.dedent().writeLine("}");
+
+    assertEquals(writer.toString(), "if (x) {\n    f();\n    g();\n    h(1);\n\n}\n");
+    assertEquals(writer.lineCount, 6);
+    assertEquals(writer.indentLevel, 0);
+  });
+
+  it("should record positions at the indented column", () => {
+    const writer = new CodeWriter();
+    writer.writeLine("void run() {").indent();
+    writer.mark({ file: "a.ts", line: 3, column: 5 }).writeLine("f();");
+    writer.mark(undefined).writeLine("g();");
+
+    assertEquals(writer.mappings, [{
+      generatedLine: 1,
+      generatedColumn: 4,
+      originalLine: 2,
+      originalColumn: 4,
+      source: "a.ts",
+    }]);
+  });
+
+  it("should offset mappings of an appended writer", () => {
+    const body = new CodeWriter().indent();
+    body.mark({ file: "a.ts", line: 1, column: 1 }).writeLine("f();");
+
+    const writer = new CodeWriter();
+    writer.write("void Main() {");
+    writer.append(body).writeLine("}");
+
+    assertEquals(writer.toString(), "void Main() {\n    f();\n}\n");
+    assertEquals(writer.mappings[0].generatedLine, 1);
+    assertEquals(writer.mappings[0].generatedColumn, 4);
+  });
+
+  it("should indent nested statements once per level", async () => {
+    const result = await transpile(
+      `
+      function run(n: number): void {
+        for (let i = 0; i < n; i++) {
+          if (i > 1) {
+            console.log(i);
+          }
+        }
+      }
+    `,
+      { sourceMap: true },
+    );
+
+    assertStringIncludes(result.source, "\n    for (");
+    assertStringIncludes(result.source, "        if (");
+    assertEquals(JSON.parse(result.sourceMap!).mappings.replaceAll(";", "") !== "", true);
+  });
+});
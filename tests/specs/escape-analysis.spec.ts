@@ -0,0 +1,110 @@
+/**
+ * Tests for escape analysis of local class instances (src/memory/analyzer.ts)
+ */
+
+import { describe, it } from "@std/testing/bdd";
+import { assertEquals, assertStringIncludes } from "@std/assert";
+import { transpile } from "../../src/transpiler.ts";
+
+const VEC = `
+class Vec {
+  x: number;
+  y: number;
+  constructor(x: number, y: number) {
+    this.x = x;
+    this.y = y;
+  }
+  length(): number {
+    return Math.sqrt(this.x * this.x + this.y * this.y);
+  }
+}
+`;
+
+describe("Escape Analysis", () => {
+  it("should stack-allocate instances that never leave the function", async () => {
+    const input = VEC + `
+function norm(a: number, b: number): number {
+  const v = new Vec(a, b);
+  v.x = v.x * 2;
+  return v.length() + v.y;
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.source, "Vec v = Vec(a, b);");
+    assertStringIncludes(result.source, "v.x = (v.x * js::number(2))");
+    assertStringIncludes(result.source, "v.length()");
+    assertEquals(result.source.includes("make_shared<Vec>"), false);
+  });
+
+  it("should keep shared ownership for escaping instances", async () => {
+    const input = VEC + `
+function share(a: number, items: Vec[]): Vec {
+  const v = new Vec(a, a);
+  items.push(v);
+  return v;
+}
+
+function collect(items: Vec[]): void {
+  const v = new Vec(1, 2);
+  items.push(v);
+  v.x = 0;
+}
+
+function capture(): () => number {
+  const v = new Vec(3, 4);
+  return () => v.x;
+}
+`;
+
+    const result = await transpile(input);
+    assertEquals(result.source.includes("Vec v = Vec("), false);
+    assertStringIncludes(result.source, "std::make_shared<Vec>(a, a)");
+    assertStringIncludes(result.source, "std::make_shared<Vec>(js::number(1), js::number(2))");
+    assertStringIncludes(result.source, "std::make_shared<Vec>(js::number(3), js::number(4))");
+  });
+
+  it("should use unique_ptr for locals declared through a base class", async () => {
+    const input = `
+class Shape {
+  area(): number {
+    return 0;
+  }
+}
+
+class Square extends Shape {
+  constructor(public side: number) {
+    super();
+  }
+  area(): number {
+    return this.side * this.side;
+  }
+}
+
+function measure(): number {
+  const shape: Shape = new Square(3);
+  return shape.area();
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.source, "std::make_unique<Square>(");
+    assertStringIncludes(result.source, "shape->area()");
+  });
+
+  it("should honour the unique and shared strategies", async () => {
+    const input = VEC + `
+function sum(): number {
+  const v = new Vec(1, 2);
+  return v.x + v.y;
+}
+`;
+
+    const unique = await transpile(input, { memoryStrategy: "unique" });
+    assertStringIncludes(unique.source, "std::make_unique<Vec>(");
+    assertStringIncludes(unique.source, "v->x");
+
+    const shared = await transpile(input, { memoryStrategy: "shared" });
+    assertStringIncludes(shared.source, "std::make_shared<Vec>(");
+  });
+});
@@ -0,0 +1,112 @@
+/**
+ * Tests for non-blocking file I/O mapping onto runtime/fs.h
+ */
+
+import { describe, it } from "@std/testing/bdd";
+import { assertEquals, assertStringIncludes } from "@std/assert";
+import { transpile } from "../../src/transpiler.ts";
+import { TypeMapper } from "../../src/codegen/generators/type-mapper.ts";
+
+describe("File I/O", () => {
+  describe("Deno file APIs", () => {
+    it("should map Deno.readTextFile to js::fs::readTextFile", async () => {
+      const input = `
+async function load(path: string): Promise<string> {
+  const text = await Deno.readTextFile(path);
+  return text;
+}
+`;
+
+      const result = await transpile(input, { standard: "c++20" });
+      assertStringIncludes(result.source, "co_await js::fs::readTextFile(path)");
+      assertStringIncludes(result.header, '#include "runtime/fs.h"');
+    });
+
+    it("should map Deno.writeTextFile and Deno.stat", async () => {
+      const input = `
+async function save(path: string, data: string): Promise<void> {
+  await Deno.writeTextFile(path, data);
+  const info = await Deno.stat(path);
+  console.log(info.size);
+}
+`;
+
+      const result = await transpile(input, { standard: "c++20" });
+      assertStringIncludes(result.source, "js::fs::writeTextFile(path, data)");
+      assertStringIncludes(result.source, "js::fs::stat(path)");
+    });
+
+    it("should map Deno.open to a file handle", async () => {
+      const input = `
+async function openLog(): Promise<void> {
+  const file = await Deno.open("app.log");
+  await file.close();
+}
+`;
+
+      const result = await transpile(input, { standard: "c++20" });
+      assertStringIncludes(result.source, "js::fs::openFile(");
+    });
+
+    it("should translate open and write options objects", async () => {
+      const input = `
+async function log(options: Deno.WriteFileOptions): Promise<void> {
+  const file = await Deno.open("app.log", { write: true, create: true });
+  await file.close();
+  await Deno.writeTextFile("app.log", "line", { append: true });
+  await Deno.writeTextFile("app.log", "line", options);
+}
+`;
+
+      const result = await transpile(input, { standard: "c++20" });
+      assertStringIncludes(
+        result.source,
+        'js::fs::openFile("app.log"_S, js::fs::OpenOptions{.write = true, .create = true})',
+      );
+      assertStringIncludes(result.source, "js::fs::WriteFileOptions{.append = true}");
+      assertStringIncludes(result.source, 'js::fs::writeTextFile("app.log"_S, "line"_S);');
+      const warning = result.warnings.find((w) => w.code === "FS_OPTIONS");
+      assertStringIncludes(warning?.message ?? "", "Deno.writeTextFile");
+    });
+
+    it("should run the event loop after top-level code", async () => {
+      const input = `
+async function run(): Promise<void> {
+  const text = await Deno.readTextFile("input.txt");
+  console.log(text);
+}
+run();
+`;
+
+      const result = await transpile(input, { standard: "c++20" });
+      assertStringIncludes(result.source, "js::EventLoop::instance().run();");
+    });
+  });
+
+  describe("Node fs/promises", () => {
+    it("should map namespace imports of node:fs/promises", async () => {
+      const input = `
+import * as fsp from "node:fs/promises";
+
+async function load(path: string): Promise<string> {
+  return await fsp.readFile(path, "utf8");
+}
+`;
+
+      const result = await transpile(input, { standard: "c++20" });
+      assertStringIncludes(result.header, '#include "runtime/fs.h"');
+      assertStringIncludes(result.source, "js::fs::readFile(path");
+      assertEquals(result.header.includes("<node:fs/promises.h>"), false);
+    });
+  });
+
+  describe("Type mapping", () => {
+    it("should map file system declarations", () => {
+      const mapper = new TypeMapper();
+      assertEquals(mapper.mapType("Deno.FileInfo"), "js::fs::FileInfo");
+      assertEquals(mapper.mapType("Deno.FsFile"), "js::fs::FileHandle");
+      assertEquals(mapper.mapType("FileHandle"), "js::fs::FileHandle");
+      assertEquals(mapper.mapType("Promise<Deno.FileInfo>"), "js::Promise<js::fs::FileInfo>");
+    });
+  });
+});
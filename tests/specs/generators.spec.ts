@@ -0,0 +1,143 @@
+/**
+ * Tests for generator functions (function* / yield)
+ */
+
+import { describe, it } from "@std/testing/bdd";
+import { assertEquals, assertStringIncludes } from "@std/assert";
+import { transpile } from "../../src/transpiler.ts";
+
+describe("Generators", () => {
+  it("should lower function* to js::Generator", async () => {
+    const input = `
+function* range(limit: number): Generator<number> {
+  for (let i = 0; i < limit; i++) {
+    yield i;
+  }
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.header, "js::Generator<js::number> range(js::number limit);");
+    assertStringIncludes(result.header, '#include "runtime/generator.h"');
+    assertStringIncludes(result.source, "co_yield i");
+  });
+
+  it("should iterate generators lazily with range-for", async () => {
+    const input = `
+function* naturals(): IterableIterator<number> {
+  let n = 0;
+  while (true) {
+    yield n++;
+  }
+}
+
+function firstTen(): number {
+  let total = 0;
+  for (const n of naturals()) {
+    if (n >= 10) break;
+    total += n;
+  }
+  return total;
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.header, "js::Generator<js::number> naturals();");
+    assertStringIncludes(result.source, "for (const auto& n : naturals())");
+  });
+
+  it("should expand yield* into a delegating loop", async () => {
+    const input = `
+function* inner(): Generator<number> {
+  yield 1;
+}
+
+function* outer(): Generator<number> {
+  yield* inner();
+  yield 2;
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.source, "for (auto&& yield_item : inner()) co_yield yield_item;");
+  });
+
+  it("should map next() and return() on generator objects", async () => {
+    const input = `
+function* letters(): Generator<string> {
+  yield "a";
+  yield "b";
+}
+
+let gen = letters();
+const first = gen.next();
+gen.return();
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.source, "next()");
+    assertStringIncludes(result.source, "gen.return_()");
+  });
+
+  it("should only map return() on generator receivers", async () => {
+    const input = `
+interface Closer {
+  return(): void;
+}
+
+function stop(gen: Generator<number>, closer: Closer): void {
+  gen.return();
+  closer.return();
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.source, "gen.return_()");
+    assertEquals(result.source.includes("closer.return_"), false);
+  });
+
+  it("should end generators with a bare co_return", async () => {
+    const input = `
+function* once(): Generator<number> {
+  yield 1;
+  return;
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.source, "co_return;");
+  });
+
+  it("should still evaluate a returned value in generators", async () => {
+    const input = `
+function cleanup(): number {
+  return 0;
+}
+
+function* once(): Generator<number> {
+  yield 1;
+  return cleanup();
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.source, "static_cast<void>(cleanup());");
+    assertStringIncludes(result.source, "co_return;");
+  });
+
+  it("should keep plain returns in lambdas inside generators", async () => {
+    const input = `
+function* doubled(): Generator<number> {
+  const twice = (x: number): number => {
+    const y = x * 2;
+    return y;
+  };
+  yield twice(1);
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.source, "return y;");
+    assertEquals(result.source.includes("co_return y;"), false);
+  });
+});
@@ -0,0 +1,121 @@
+/**
+ * Tests for IR traversal and module facts (src/ir/visitor.ts)
+ */
+
+import { describe, it } from "@std/testing/bdd";
+import { assertEquals, assertStringIncludes } from "@std/assert";
+import { forEachChild, getModuleFacts, walkIR } from "../../src/ir/visitor.ts";
+import { type IRModule, type IRNode, IRNodeKind } from "../../src/ir/nodes.ts";
+import { transpile } from "../../src/transpiler.ts";
+
+const id = (name: string) => ({ kind: IRNodeKind.Identifier, name });
+
+function classModule(): IRModule {
+  // class Task { async run() { await work(); } }  function main() {}
+  const method = {
+    kind: IRNodeKind.FunctionDeclaration,
+    key: id("run"),
+    value: {
+      kind: IRNodeKind.FunctionDeclaration,
+      id: null,
+      params: [],
+      body: {
+        kind: IRNodeKind.BlockStatement,
+        body: [{
+          kind: IRNodeKind.ExpressionStatement,
+          expression: {
+            kind: IRNodeKind.AwaitExpression,
+            argument: { kind: IRNodeKind.CallExpression, callee: id("work"), arguments: [] },
+          },
+        }],
+      },
+    },
+  };
+  return {
+    kind: IRNodeKind.Module,
+    name: "task",
+    exports: [],
+    imports: [],
+    headers: [],
+    body: [
+      { kind: IRNodeKind.ClassDeclaration, id: id("Task"), members: [method] },
+      {
+        kind: IRNodeKind.FunctionDeclaration,
+        id: id("main"),
+        params: [{ name: "pair", type: "std::tuple<js::number, js::string>" }],
+        body: { kind: IRNodeKind.BlockStatement, body: [] },
+      },
+    ],
+  } as unknown as IRModule;
+}
+
+describe("IR Visitor", () => {
+  it("should visit children through records without a kind", () => {
+    // const point = { x: 1 }
+    const declaration = {
+      kind: IRNodeKind.VariableDeclaration,
+      cppType: "js::object",
+      declarations: [{
+        id: id("point"),
+        init: {
+          kind: IRNodeKind.ObjectExpression,
+          properties: [{
+            kind: "init",
+            key: id("x"),
+            value: { kind: IRNodeKind.Literal, value: 1 },
+          }],
+        },
+      }],
+    } as unknown as IRNode;
+
+    const children: string[] = [];
+    const fields: string[] = [];
+    forEachChild(declaration, (child, field) => {
+      children.push(child.kind);
+      fields.push(field);
+    });
+    assertEquals(children, [IRNodeKind.Identifier, IRNodeKind.ObjectExpression]);
+    assertEquals(fields, ["id", "init"]);
+
+    const all: string[] = [];
+    walkIR(declaration, (node) => {
+      all.push(node.kind);
+    });
+    assertEquals(all, [
+      IRNodeKind.VariableDeclaration,
+      IRNodeKind.Identifier,
+      IRNodeKind.ObjectExpression,
+      IRNodeKind.Identifier,
+      IRNodeKind.Literal,
+    ]);
+  });
+
+  it("should compute module facts in one walk and cache them", () => {
+    const module = classModule();
+    const facts = getModuleFacts(module);
+
+    assertEquals(facts, {
+      nodeCount: 14,
+      hasAsync: true,
+      hasGenerators: false,
+      usesTuples: true,
+      hasMain: true,
+      classNames: ["Task"],
+    });
+    assertEquals(module.facts, facts);
+    assertEquals(getModuleFacts(module) === facts, true);
+  });
+
+  it("should drive includes and forward declarations in generated code", async () => {
+    const result = await transpile(`
+      class Node { next: Node | null = null; }
+      async function load(): Promise<number> { return 1; }
+      function* count() { yield 1; }
+    `);
+
+    assertStringIncludes(result.header, "class Node;");
+    assertStringIncludes(result.header, "runtime/async.h");
+    assertStringIncludes(result.header, "runtime/generator.h");
+    assertEquals(result.stats.nodesProcessed > 10, true);
+  });
+});
@@ -0,0 +1,42 @@
+/**
+ * Tests for memory instrumentation hooks (runtime/memory_stats.h)
+ */
+
+import { describe, it } from "@std/testing/bdd";
+import { assertEquals, assertStringIncludes } from "@std/assert";
+import { transpile } from "../../src/transpiler.ts";
+import { CMakeGenerator } from "../../src/cmake/generator.ts";
+
+describe("Memory Statistics", () => {
+  it("should give generated classes an instance counter hook", async () => {
+    const input = `
+class Session {
+  id: number = 0;
+}
+
+interface Point {
+  x: number;
+  y: number;
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.header, "    JS_TRACK_INSTANCES(Session)\n};");
+    assertEquals(result.header.includes("JS_TRACK_INSTANCES(Point)"), false);
+  });
+
+  it("should offer JS_MEMORY_STATS as a CMake option", () => {
+    const cmake = new CMakeGenerator({
+      projectName: "stats",
+      sourceFiles: ["stats.cpp"],
+      headerFiles: ["stats.h"],
+    }).generate();
+    assertStringIncludes(cmake, "option(JS_MEMORY_STATS");
+    assertStringIncludes(cmake, "add_compile_definitions(JS_MEMORY_STATS)");
+  });
+
+  it("should install the allocation report from the generated main", async () => {
+    const result = await transpile(`console.log("hello");`);
+    assertStringIncludes(result.source, "    js::install_memory_report();\n    Main();");
+  });
+});
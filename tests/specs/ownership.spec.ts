@@ -0,0 +1,233 @@
+/**
+ * Tests for ownership inference (unique_ptr with moves, borrowed parameters)
+ */
+
+import { describe, it } from "@std/testing/bdd";
+import { assertEquals, assertStringIncludes } from "@std/assert";
+import { transpile } from "../../src/transpiler.ts";
+
+const NODE = `
+class Node {
+  value: number;
+  next: Node | null = null;
+  constructor(value: number) {
+    this.value = value;
+  }
+}
+
+class List {
+  head: Node | null = null;
+}
+`;
+
+describe("Ownership Inference", () => {
+  it("should move a uniquely owned local into its consumer", async () => {
+    const input = NODE + `
+function prepend(list: List, value: number): void {
+  const node = new Node(value);
+  node.value = node.value + 1;
+  list.head = node;
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(
+      result.source,
+      "std::unique_ptr<Node> node = std::make_unique<Node>(value);",
+    );
+    assertStringIncludes(result.source, "node->value = (node->value");
+    assertStringIncludes(result.source, "list->head = std::move(node);");
+  });
+
+  it("should not move a local that is used after being handed on", async () => {
+    const input = NODE + `
+function track(list: List, value: number): number {
+  const node = new Node(value);
+  list.head = node;
+  return node.value;
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.source, "std::make_shared<Node>(value)");
+    assertEquals(result.source.includes("std::move(node)"), false);
+  });
+
+  it("should not move a local read elsewhere in the same call", async () => {
+    const input = NODE + `
+function remember(value: number, node: Node): void {
+}
+
+function add(value: number): void {
+  const node = new Node(value);
+  remember(node.value, node);
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.source, "std::make_shared<Node>(value)");
+    assertEquals(result.source.includes("std::move(node)"), false);
+  });
+
+  it("should not move inside a loop", async () => {
+    const input = NODE + `
+function fill(list: List, count: number): void {
+  const node = new Node(count);
+  for (let i = 0; i < count; i++) {
+    list.head = node;
+  }
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.source, "std::make_shared<Node>(count)");
+    assertEquals(result.source.includes("std::move(node)"), false);
+  });
+
+  it("should pass parameters the callee does not retain by const reference", async () => {
+    const input = NODE + `
+function valueOf(node: Node): number {
+  return node.value;
+}
+
+function describe(node: Node): number {
+  return valueOf(node) * 2;
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.header, "js::number valueOf(const std::shared_ptr<Node>& node);");
+    assertStringIncludes(result.header, "js::number describe(const std::shared_ptr<Node>& node);");
+    assertStringIncludes(result.source, "node->value");
+  });
+
+  it("should only borrow objects callers pass from a local or parameter", async () => {
+    const input = NODE + `
+let current = new Node(1);
+
+function replace(): void {
+  current = new Node(2);
+}
+
+function inspect(node: Node): number {
+  replace();
+  return node.value;
+}
+
+function peek(node: Node): number {
+  return node.value;
+}
+
+function run(): number {
+  const local = new Node(3);
+  return inspect(current) + peek(local);
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.header, "js::number inspect(std::shared_ptr<Node> node);");
+    assertStringIncludes(result.header, "js::number peek(const std::shared_ptr<Node>& node);");
+  });
+
+  it("should pass retained parameters by value and move them at last use", async () => {
+    const input = NODE + `
+function push(list: List, node: Node): void {
+  node.next = list.head;
+  list.head = node;
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.header, "const std::shared_ptr<List>& list");
+    assertStringIncludes(result.header, "std::shared_ptr<Node> node");
+    assertStringIncludes(result.source, "list->head = std::move(node);");
+  });
+
+  it("should pass strings and arrays the callee only reads by const reference", async () => {
+    const input = `
+function total(values: number[], label: string): number {
+  console.log(label);
+  let sum = 0;
+  for (const value of values) {
+    sum += value;
+  }
+  return sum;
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(
+      result.header,
+      "js::number total(const js::array<js::number>& values, const js::string& label);",
+    );
+  });
+
+  it("should only borrow interfaces that are lowered to structs", async () => {
+    const input = `
+interface Point { x: number; y: number; }
+interface Reader { read(): string; }
+
+function norm(p: Point): number {
+  return p.x * p.x + p.y * p.y;
+}
+
+function drain(reader: Reader): string {
+  return reader.read();
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.header, "js::number norm(const Point& p);");
+    assertStringIncludes(result.header, "Reader reader");
+    assertEquals(result.header.includes("const Reader&"), false);
+  });
+
+  it("should pass arrays the callee writes through by reference", async () => {
+    const input = `
+function reset(values: number[]): void {
+  for (let i = 0; i < values.length; i++) {
+    values[i] = 0;
+  }
+}
+
+function run(): number {
+  const values = [1, 2, 3];
+  reset(values);
+  return values[0];
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.header, "void reset(js::array<js::number>& values);");
+  });
+
+  it("should copy written parameters of exported functions", async () => {
+    const input = `
+export function append(values: number[]): void {
+  values.push(1);
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.header, "void append(js::array<js::number> values);");
+  });
+
+  it("should move stored value parameters at their last use", async () => {
+    const input = `
+class Bag {
+  items: string[] = [];
+}
+
+function fill(bag: Bag, items: string[]): void {
+  bag.items = items;
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(
+      result.header,
+      "void fill(const std::shared_ptr<Bag>& bag, js::array<js::string> items);",
+    );
+    assertStringIncludes(result.source, "bag->items = std::move(items);");
+  });
+});
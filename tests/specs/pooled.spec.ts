@@ -0,0 +1,71 @@
+/**
+ * Tests for @pooled classes (runtime/pool.h)
+ */
+
+import { describe, it } from "@std/testing/bdd";
+import { assertEquals, assertStringIncludes } from "@std/assert";
+import { transpile } from "../../src/transpiler.ts";
+
+const PACKET = `
+/** @pooled */
+export class Packet {
+  id: number;
+  constructor(id: number) {
+    this.id = id;
+  }
+}
+
+class Session {
+  packets: Packet[] = [];
+}
+`;
+
+describe("Pooled Classes", () => {
+  it("should read @pooled from multi-line JSDoc blocks", async () => {
+    const input = `
+/**
+ * A network packet, allocated at a high rate.
+ * @pooled
+ */
+class Packet {
+  id: number = 0;
+}
+
+function receive(): number {
+  const packets: Packet[] = [new Packet()];
+  return packets.length;
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.source, "js::pooled_new<Packet>()");
+  });
+
+  it("should construct pooled classes through the type's pool", async () => {
+    const input = PACKET + `
+function receive(session: Session, id: number): void {
+  session.packets.push(new Packet(id));
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.header, '#include "runtime/pool.h"');
+    assertStringIncludes(result.source, "js::pooled_new<Packet>(id)");
+    assertEquals(result.source.includes("std::make_shared<Packet>"), false);
+  });
+
+  it("should not include the pool header without pooled classes", async () => {
+    const input = `
+class Plain {
+  value: number = 0;
+}
+
+function make(): Plain {
+  return new Plain();
+}
+`;
+
+    const result = await transpile(input);
+    assertEquals(result.header.includes("runtime/pool.h"), false);
+  });
+});
@@ -0,0 +1,54 @@
+/**
+ * Tests for pipeline phase timings and the Chrome trace (src/profiler.ts)
+ */
+
+import { describe, it } from "@std/testing/bdd";
+import { assertEquals } from "@std/assert";
+import { transpile } from "../../src/transpiler.ts";
+import { Profiler } from "../../src/profiler.ts";
+
+describe("Profiler", () => {
+  it("should record every transpile phase in order", async () => {
+    const result = await transpile(`const x: number = 1;\nconsole.log(x);`, {
+      filename: "x.ts",
+      sourceMap: true,
+    });
+    const phases = result.stats.phases ?? [];
+
+    assertEquals(phases.map((timing) => timing.phase), [
+      "pluginLoad",
+      "parse",
+      "typeCheck",
+      "transform",
+      "memoryAnalysis",
+      "codegen",
+      "sourceMap",
+    ]);
+    assertEquals(phases.every((timing) => timing.duration >= 0), true);
+    for (let i = 1; i < phases.length; i++) {
+      assertEquals(phases[i].start >= phases[i - 1].start, true);
+    }
+  });
+
+  it("should put overlapping files on separate tracks", () => {
+    const profiler = new Profiler();
+    profiler.add("a.ts", [
+      { phase: "parse", start: 1000, duration: 5 },
+      { phase: "codegen", start: 1005, duration: 10 },
+    ]);
+    profiler.add("b.ts", [{ phase: "parse", start: 1002, duration: 5 }]);
+    profiler.add("c.ts", [{ phase: "parse", start: 1020, duration: 1 }]);
+
+    const spans = profiler.toTraceEvents()
+      .filter((event) => event.ph === "X")
+      .map((event) => [event.name, event.ts, event.dur, event.tid]);
+    assertEquals(spans, [
+      ["parse", 0, 5000, 1],
+      ["codegen", 5000, 10000, 1],
+      ["parse", 2000, 5000, 2],
+      ["parse", 20000, 1000, 1],
+    ]);
+    assertEquals(JSON.parse(profiler.toChromeTrace()).traceEvents.length, 6);
+    assertEquals([...profiler.totals()], [["parse", 11], ["codegen", 10]]);
+  });
+});
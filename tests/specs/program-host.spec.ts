@@ -0,0 +1,49 @@
+/**
+ * Tests for the long-lived program host (src/ast/program-host.ts)
+ */
+
+import { describe, it } from "@std/testing/bdd";
+import { assertEquals, assertThrows } from "@std/assert";
+import { parseTypeScript } from "../../src/ast/parser.ts";
+import { ProgramHost } from "../../src/ast/program-host.ts";
+import { ParseError } from "../../src/errors.ts";
+
+describe("Program Host", () => {
+  it("should reuse the tree, program and checker of an unchanged file", () => {
+    const programHost = new ProgramHost();
+    const source = `function add(a: number, b: number): number { return a + b; }`;
+    const first = parseTypeScript(source, { filename: "add.ts", typeCheck: true, programHost });
+    const second = parseTypeScript(source, { filename: "add.ts", typeCheck: true, programHost });
+
+    assertEquals(second.ast === first.ast, true);
+    assertEquals(second.typeChecker === first.typeChecker, true);
+    assertEquals(second.typeCheckResult?.program === first.typeCheckResult?.program, true);
+    assertEquals(programHost.size, 1);
+  });
+
+  it("should reparse a changed file without touching the previous tree", () => {
+    const programHost = new ProgramHost();
+    const first = parseTypeScript(`const x = 1;`, { filename: "x.ts", programHost });
+    const second = parseTypeScript(`const x = 2;`, { filename: "x.ts", programHost });
+
+    assertEquals(second.ast === first.ast, false);
+    assertEquals(first.ast.text, `const x = 1;`);
+    assertEquals(second.ast.text, `const x = 2;`);
+    assertEquals(programHost.getProgram("x.ts").getSourceFile("x.ts") === second.ast, true);
+  });
+
+  it("should keep reporting syntax errors for a cached file", () => {
+    const programHost = new ProgramHost();
+    const parse = () => parseTypeScript(`let = ;`, { filename: "bad.ts", programHost });
+    assertThrows(parse, ParseError);
+    assertThrows(parse, ParseError);
+  });
+
+  it("should drop forgotten files", () => {
+    const programHost = new ProgramHost();
+    parseTypeScript(`const a = 1;`, { filename: "a.ts", programHost });
+    parseTypeScript(`const b = 1;`, { filename: "b.ts", programHost });
+    programHost.forget("a.ts");
+    assertEquals(programHost.size, 1);
+  });
+});
@@ -0,0 +1,137 @@
+/**
+ * Tests for project mode (src/project.ts)
+ */
+
+import { afterEach, beforeEach, describe, it } from "@std/testing/bdd";
+import { assertEquals, assertStringIncludes } from "@std/assert";
+import { join } from "@std/path";
+import {
+  affectedModules,
+  buildProjectGraph,
+  discoverProjectFiles,
+  transpileProject,
+} from "../../src/project.ts";
+import type { TranspilerConfig } from "../../src/config/types.ts";
+
+const files: Record<string, string> = {
+  "src/main.ts": `import { double } from "./math/double.ts";
+import { greet } from "./greet.ts";
+console.log(greet("world"), double(21));`,
+  "src/greet.ts": `export function greet(name: string): string {
+  return "hello " + name;
+}`,
+  "src/math/double.ts": `export function double(x: number): number {
+  return x * 2;
+}`,
+  "src/main.test.ts": `console.log("not part of the build");`,
+};
+
+function projectConfig(parallel: boolean, output: string): TranspilerConfig {
+  return {
+    project: {
+      include: ["src/**/*.ts"],
+      exclude: ["**/*.test.ts"],
+      entry: { main: "src/main.ts" },
+      output: { directory: output, clean: false, preserveStructure: true },
+    },
+    experimental: { parallelCompilation: parallel },
+  };
+}
+
+describe("Project Mode", () => {
+  let root: string;
+
+  beforeEach(async () => {
+    root = await Deno.makeTempDir();
+    for (const [path, content] of Object.entries(files)) {
+      await Deno.mkdir(join(root, path, ".."), { recursive: true });
+      await Deno.writeTextFile(join(root, path), content);
+    }
+  });
+
+  afterEach(async () => {
+    await Deno.remove(root, { recursive: true });
+  });
+
+  it("should discover files and their imports", async () => {
+    const found = await discoverProjectFiles(root, {
+      include: ["src/**/*.ts"],
+      exclude: ["**/*.test.ts"],
+    });
+    const graph = await buildProjectGraph(root, found);
+
+    assertEquals(graph.modules.map((module) => module.relativePath), [
+      "src/greet.ts",
+      "src/main.ts",
+      "src/math/double.ts",
+    ]);
+    assertEquals(graph.modules[1].imports, [
+      join(root, "src/math/double.ts"),
+      join(root, "src/greet.ts"),
+    ]);
+    assertEquals(graph.dependents.get(join(root, "src/greet.ts")), [join(root, "src/main.ts")]);
+  });
+
+  it("should produce the same output serially and in parallel", async () => {
+    const serial = await transpileProject(projectConfig(false, "serial"), { root });
+    const parallel = await transpileProject(projectConfig(true, "parallel"), {
+      root,
+      workers: 2,
+    });
+
+    assertEquals(serial.success, true);
+    assertEquals(parallel.success, true);
+    assertEquals(
+      parallel.files.map((file) => file.module.relativePath),
+      serial.files.map((file) => file.module.relativePath),
+    );
+    for (let i = 0; i < serial.files.length; i++) {
+      assertEquals(parallel.files[i].result?.header, serial.files[i].result?.header);
+      assertEquals(parallel.files[i].result?.source, serial.files[i].result?.source);
+    }
+
+    const header = await Deno.readTextFile(join(root, "parallel/src/main.h"));
+    assertStringIncludes(header, '#include "./greet.h"');
+    await Deno.stat(join(root, "parallel/src/math/double.cpp"));
+  });
+
+  it("should reuse cached results and leave unchanged outputs alone", async () => {
+    const config: TranspilerConfig = {
+      ...projectConfig(false, "out"),
+      experimental: { incrementalCompilation: true },
+    };
+
+    const first = await transpileProject(config, { root });
+    assertEquals(first.files.map((file) => file.cached), [false, false, false]);
+    const headerPath = join(root, "out/src/greet.h");
+    const firstWrite = (await Deno.stat(headerPath)).mtime;
+
+    await Deno.writeTextFile(
+      join(root, "src/math/double.ts"),
+      `export function double(x: number): number {\n  return x + x;\n}`,
+    );
+    const second = await transpileProject(config, { root });
+    assertEquals(second.files.map((file) => file.cached), [true, true, false]);
+    assertEquals(second.files.map((file) => file.written), [false, false, true]);
+    assertEquals((await Deno.stat(headerPath)).mtime, firstWrite);
+  });
+
+  it("should only transpile changed modules and their importers again", async () => {
+    const config = projectConfig(false, "out");
+    const first = await transpileProject(config, { root });
+    const changed = join(root, "src/math/double.ts");
+    assertEquals([...affectedModules(first.graph, [changed])].sort(), [
+      join(root, "src/main.ts"),
+      changed,
+    ]);
+
+    await Deno.writeTextFile(
+      changed,
+      `export function double(x: number): number {\n  return x + x;\n}`,
+    );
+    const second = await transpileProject(config, { root, previous: first, changed: [changed] });
+    assertEquals(second.files.map((file) => file.reused ?? false), [true, false, false]);
+    assertEquals(second.files[0].result, first.files[0].result);
+    assertEquals(second.graph.modules[0] === first.graph.modules[0], true);
+  });
+});
@@ -0,0 +1,164 @@
+/**
+ * Tests for Promise.all / allSettled / any / race (runtime/async.h)
+ */
+
+import { describe, it } from "@std/testing/bdd";
+import { assertEquals, assertStringIncludes } from "@std/assert";
+import { transpile } from "../../src/transpiler.ts";
+
+const REPO_ROOT = new URL("../../", import.meta.url).pathname;
+const CXX = Deno.env.get("CXX") ?? "c++";
+
+async function hasCompiler(): Promise<boolean> {
+  try {
+    const { success } = await new Deno.Command(CXX, { args: ["--version"] }).output();
+    return success;
+  } catch {
+    return false;
+  }
+}
+
+const COMPILER_AVAILABLE = await hasCompiler();
+
+/**
+ * Compile a program against the runtime headers and return what it prints
+ */
+async function compileAndRun(program: string): Promise<string> {
+  const dir = await Deno.makeTempDir();
+  try {
+    await Deno.writeTextFile(`${dir}/main.cpp`, program);
+    const build = await new Deno.Command(CXX, {
+      args: ["-std=c++20", `-I${REPO_ROOT}`, `-I${REPO_ROOT}runtime`, "main.cpp", "-o", "main"],
+      cwd: dir,
+    }).output();
+    assertEquals(build.success, true, new TextDecoder().decode(build.stderr));
+    const run = await new Deno.Command(`${dir}/main`).output();
+    assertEquals(run.success, true);
+    return new TextDecoder().decode(run.stdout);
+  } finally {
+    await Deno.remove(dir, { recursive: true });
+  }
+}
+
+const COMBINATORS = `
+#include <iostream>
+#include "runtime/async.h"
+
+using namespace js;
+
+Task<number> twice(number n) { co_return n * number(2); }
+Task<void> nothing() { co_return; }
+
+bool finished = false;
+
+Task<void> run() {
+    auto all = co_await promise_all(twice(number(1)), twice(number(2)), number(5));
+    std::cout << "all " << all.length() << " " << all[0].value() << " " << all[2].value() << "\\n";
+
+    array<Task<number>> tasks{twice(number(3)), twice(number(4))};
+    auto fromArray = co_await promise_all(tasks);
+    std::cout << "array " << fromArray[1].value() << "\\n";
+
+    auto pending = std::make_shared<Promise<number>>();
+    auto failing = std::make_shared<Promise<number>>();
+    auto raced = promise_race(pending, failing);
+    failing->rejectWith(std::make_exception_ptr(js::any(string("boom"))));
+    try {
+        co_await raced;
+    } catch (const js::any& reason) {
+        std::cout << "race rejected " << reason.toString().value() << "\\n";
+    }
+    try {
+        co_await promise_all(pending, failing);
+    } catch (const js::any&) {
+        std::cout << "all rejected\\n";
+    }
+    auto settled = co_await promise_all_settled(failing, twice(number(6)));
+    std::cout << "settled " << settled[0].status.value() << " " << settled[1].status.value()
+              << " " << settled[1].value->value() << "\\n";
+    auto first = co_await promise_any(failing, pending, twice(number(7)));
+    std::cout << "any " << first.value() << "\\n";
+
+    auto none = co_await promise_all();
+    auto noneSettled = co_await promise_all_settled();
+    std::cout << "empty " << none.length() << " " << noneSettled.length() << "\\n";
+    try {
+        co_await promise_any();
+    } catch (const js::any&) {
+        std::cout << "empty any rejected\\n";
+    }
+
+    co_await promise_all(nothing(), nothing());
+    auto voids = co_await promise_all_settled(
+        nothing(), Promise<void>::reject(std::make_exception_ptr(js::any(string("void")))));
+    std::cout << "void " << voids[0].status.value() << " " << voids[1].status.value() << "\\n";
+    co_await promise_race(nothing());
+    co_await promise_any(nothing());
+    finished = true;
+}
+
+int main() {
+    auto task = run();
+    EventLoop::instance().run();
+    return finished ? 0 : 1;
+}
+`;
+
+describe("Promise Combinators", () => {
+  it("should pass the elements of an array literal one by one", async () => {
+    const input = `
+async function scale(n: number): Promise<number> {
+  return n * 2;
+}
+
+async function run(): Promise<number> {
+  const values = await Promise.all([scale(1), scale(2)]);
+  const first = await Promise.race([scale(3), scale(4)]);
+  const fastest = await Promise.any([scale(5)]);
+  return values.length + first + fastest;
+}
+`;
+
+    const result = await transpile(input, { standard: "c++20" });
+    assertStringIncludes(
+      result.source,
+      "co_await js::promise_all(scale(js::number(1)), scale(js::number(2)))",
+    );
+    assertStringIncludes(result.source, "co_await js::promise_race(");
+    assertStringIncludes(result.source, "co_await js::promise_any(");
+    assertStringIncludes(result.header, '#include "runtime/async.h"');
+  });
+
+  it("should pass an array of tasks as a whole", async () => {
+    const input = `
+async function settle(tasks: Promise<number>[]): Promise<number> {
+  const results = await Promise.allSettled(tasks);
+  return results.length;
+}
+`;
+
+    const result = await transpile(input, { standard: "c++20" });
+    assertStringIncludes(result.source, "co_await js::promise_all_settled(tasks)");
+  });
+
+  it("should settle, reject and accept empty and void inputs", {
+    ignore: !COMPILER_AVAILABLE,
+  }, async () => {
+    const output = await compileAndRun(COMBINATORS);
+    assertEquals(
+      output,
+      [
+        "all 3 2 5",
+        "array 8",
+        "race rejected boom",
+        "all rejected",
+        "settled rejected fulfilled 12",
+        "any 14",
+        "empty 0 0",
+        "empty any rejected",
+        "void fulfilled rejected",
+        "",
+      ].join("\n"),
+    );
+  });
+});
@@ -0,0 +1,92 @@
+/**
+ * Tests for reference cycle detection between class fields (src/memory/cycles.ts)
+ */
+
+import { describe, it } from "@std/testing/bdd";
+import { assertEquals, assertStringIncludes } from "@std/assert";
+import { transpile } from "../../src/transpiler.ts";
+
+const TREE = `
+class Tree {
+  root: Leaf | null = null;
+}
+
+class Leaf {
+  owner: Tree | null = null;
+  value: number = 0;
+  setOwner(tree: Tree): void {
+    this.owner = tree;
+  }
+  getOwner(): Tree | null {
+    return this.owner;
+  }
+}
+`;
+
+describe("Reference Cycles", () => {
+  it("should weaken a back-reference to the owning class", async () => {
+    const result = await transpile(TREE);
+    assertStringIncludes(result.header, "std::weak_ptr<Tree> owner;");
+    assertEquals(result.header.includes("std::weak_ptr<Leaf>"), false);
+    assertStringIncludes(result.source, "this->owner = tree;");
+    assertStringIncludes(result.source, "return this->owner.lock();");
+
+    const warning = result.warnings.find((w) => w.code === "CIRCULAR_REFERENCE");
+    assertEquals(warning?.severity, "warning");
+    assertStringIncludes(warning!.message, "'Leaf.owner'");
+  });
+
+  it("should weaken the back-edge of a cycle without naming hints", async () => {
+    const input = `
+class Engine {
+  car: Car | null = null;
+}
+
+class Car {
+  engine: Engine | null = null;
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.header, "std::weak_ptr<Engine> engine;");
+    assertEquals(result.header.includes("std::weak_ptr<Car>"), false);
+  });
+
+  it("should leave self-referencing lists alone", async () => {
+    const input = `
+class ListNode {
+  value: number = 0;
+  next: ListNode | null = null;
+}
+`;
+
+    const result = await transpile(input);
+    assertEquals(result.header.includes("std::weak_ptr"), false);
+    assertEquals(result.warnings.some((w) => w.code === "CIRCULAR_REFERENCE"), false);
+  });
+
+  it("should report cycles through containers as possible leaks", async () => {
+    const input = `
+class Graph {
+  nodes: Vertex[] = [];
+}
+
+class Vertex {
+  graphs: Graph[] = [];
+}
+`;
+
+    const result = await transpile(input);
+    assertEquals(result.header.includes("std::weak_ptr"), false);
+    const warning = result.warnings.find((w) => w.code === "MEMORY_LEAK");
+    assertStringIncludes(warning!.message, "Graph and Vertex");
+  });
+
+  it("should honour the validation options", async () => {
+    const result = await transpile(TREE, {
+      validation: { checkCircularDependencies: false, checkMemoryLeaks: false },
+    });
+    assertEquals(result.header.includes("std::weak_ptr"), false);
+    assertEquals(result.warnings.some((w) => w.code === "CIRCULAR_REFERENCE"), false);
+  });
+});
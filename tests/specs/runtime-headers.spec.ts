@@ -0,0 +1,97 @@
+/**
+ * Tests for the modular runtime headers (runtime/core/), libjsruntime and
+ * the js.runtime module
+ */
+
+import { describe, it } from "@std/testing/bdd";
+import { assertEquals, assertStringIncludes } from "@std/assert";
+import { transpile } from "../../src/transpiler.ts";
+import { CMakeGenerator } from "../../src/cmake/generator.ts";
+
+describe("Runtime Headers", () => {
+  it("should include only the runtime headers a module uses", async () => {
+    const result = await transpile(`console.log("hello");`);
+    assertStringIncludes(result.header, '#include "runtime/core/any.h"');
+    assertStringIncludes(result.header, '#include "runtime/core/console.h"');
+    assertEquals(result.header.includes('"runtime/core.h"'), false);
+    assertEquals(result.header.includes("runtime/core/date.h"), false);
+    assertEquals(result.header.includes("runtime/core/math.h"), false);
+  });
+
+  it("should include Date and Math when they are used", async () => {
+    const input = `
+function stamp(): number {
+  const now = new Date();
+  return Math.floor(now.getTime() / 1000);
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.header, '#include "runtime/core/date.h"');
+    assertStringIncludes(result.header, '#include "runtime/core/math.h"');
+  });
+
+  it("should keep a custom runtime include as given", async () => {
+    const result = await transpile(`console.log("hello");`, { runtimeInclude: "my/runtime.h" });
+    assertStringIncludes(result.header, '#include "my/runtime.h"');
+    assertEquals(result.header.includes("runtime/core/"), false);
+  });
+
+  it("should build the runtime once as the jsruntime library", () => {
+    const cmake = new CMakeGenerator({
+      projectName: "app",
+      sourceFiles: ["app.cpp"],
+      headerFiles: ["app.h"],
+      runtimeDir: "runtime",
+    }).generate();
+    assertStringIncludes(cmake, "add_library(jsruntime STATIC runtime/core.cpp)");
+    assertStringIncludes(cmake, "target_compile_definitions(jsruntime PUBLIC JS_RUNTIME_LIBRARY)");
+    assertStringIncludes(cmake, "target_link_libraries(app\n    jsruntime\n)");
+  });
+
+  it("should precompile the runtime headers", () => {
+    const cmake = new CMakeGenerator({
+      projectName: "app",
+      sourceFiles: ["app.cpp"],
+      headerFiles: ["app.h"],
+      runtimeDir: "runtime",
+    }).generate();
+    assertStringIncludes(cmake, "option(JS_PRECOMPILE_RUNTIME");
+    assertStringIncludes(cmake, "target_precompile_headers(app PRIVATE runtime/core.h)");
+  });
+
+  it("should import the runtime as a module with useModules", async () => {
+    const result = await transpile(`console.log(Math.max(1, 2));`, { useModules: true });
+    assertStringIncludes(result.header, '#include "runtime/memory_stats.h"');
+    assertStringIncludes(result.header, "import js.runtime;");
+    assertEquals(result.header.includes('"runtime/core/'), false);
+  });
+
+  it("should build the runtime module instead of a precompiled header", () => {
+    const cmake = new CMakeGenerator({
+      projectName: "app",
+      minimumVersion: "3.20",
+      sourceFiles: ["app.cpp"],
+      headerFiles: ["app.h"],
+      runtimeDir: "runtime",
+      useModules: true,
+    }).generate();
+    assertStringIncludes(cmake, "cmake_minimum_required(VERSION 3.28)");
+    assertStringIncludes(cmake, "FILE_SET CXX_MODULES");
+    assertStringIncludes(cmake, "FILES runtime/js.runtime.cppm");
+    assertEquals(cmake.includes("target_precompile_headers"), false);
+  });
+
+  it("should compile sources in unity batches when requested", () => {
+    const cmake = new CMakeGenerator({
+      projectName: "app",
+      sourceFiles: ["main.cpp", "a.cpp", "b.cpp"],
+      headerFiles: ["a.h", "b.h"],
+      unityBuild: true,
+      unityBatchSize: 16,
+    }).generate();
+    assertStringIncludes(cmake, "option(JS_UNITY_BUILD");
+    assertStringIncludes(cmake, "UNITY_BUILD ON");
+    assertStringIncludes(cmake, "UNITY_BUILD_BATCH_SIZE 16");
+  });
+});
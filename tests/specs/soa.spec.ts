@@ -0,0 +1,105 @@
+/**
+ * Tests for struct-of-arrays storage of @soa interfaces (runtime/soa.h)
+ */
+
+import { describe, it } from "@std/testing/bdd";
+import { assertEquals, assertStringIncludes } from "@std/assert";
+import { transpile } from "../../src/transpiler.ts";
+
+const PARTICLE = `
+/** @soa */
+interface Particle {
+  x: number;
+  vx: number;
+  alive: boolean;
+}
+`;
+
+describe("Struct-of-Arrays Layout", () => {
+  it("should describe @soa structs with a js::soa_layout specialization", async () => {
+    const result = await transpile(PARTICLE);
+    assertStringIncludes(result.header, '#include "runtime/soa.h"');
+    assertStringIncludes(result.header, "struct Particle {");
+    assertStringIncludes(result.header, "struct js::soa_layout<Particle> {");
+    assertStringIncludes(
+      result.header,
+      "static constexpr auto members = std::make_tuple(&Particle::x, &Particle::vx, " +
+        "&Particle::alive);",
+    );
+    assertStringIncludes(result.header, "        js::number& x;");
+    assertStringIncludes(result.header, "        const bool& alive;");
+  });
+
+  it("should store arrays of @soa structs column by column", async () => {
+    const input = PARTICLE + `
+function step(particles: Particle[], dt: number): void {
+  for (let i = 0; i < particles.length; i++) {
+    particles[i].x += particles[i].vx * dt;
+  }
+}
+
+function spawn(particles: Particle[]): void {
+  particles.push({ x: 0, vx: 1, alive: true });
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.header, "void step(js::soa_array<Particle>& particles");
+    assertStringIncludes(result.source, "particles[i].x");
+    assertStringIncludes(result.source, "particles[i].vx");
+    assertStringIncludes(
+      result.source,
+      "particles.push(Particle{.x = js::number(0), .vx = js::number(1), .alive = true})",
+    );
+    assertEquals(result.source.includes("js::array<Particle>"), false);
+  });
+
+  it("should iterate @soa arrays through proxy references", async () => {
+    const input = PARTICLE + `
+function count(particles: Particle[]): number {
+  let alive = 0;
+  for (const p of particles) {
+    if (p.alive) {
+      alive++;
+    }
+  }
+  return alive;
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.source, "for (auto&& p : particles)");
+    assertStringIncludes(result.source, "p.alive");
+  });
+
+  it("should keep arrays of unannotated structs as js::array", async () => {
+    const input = `
+interface Point {
+  x: number;
+  y: number;
+}
+
+function first(points: Point[]): number {
+  return points[0].x;
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.header, "const js::array<Point>& points");
+    assertStringIncludes(result.source, "].x");
+    assertEquals(result.header.includes("runtime/soa.h"), false);
+  });
+
+  it("should warn when @soa is placed on an interface that is not a struct", async () => {
+    const input = `
+/** @soa */
+interface Shape {
+  area(): number;
+}
+`;
+
+    const result = await transpile(input);
+    const warning = result.warnings.find((w) => w.code === "SOA_LAYOUT");
+    assertStringIncludes(warning!.message, "@soa is ignored on 'Shape'");
+  });
+});
@@ -0,0 +1,115 @@
+/**
+ * Tests for lowering closed interfaces to structs
+ */
+
+import { describe, it } from "@std/testing/bdd";
+import { assertEquals, assertStringIncludes } from "@std/assert";
+import { transpile } from "../../src/transpiler.ts";
+
+const POINT = `
+interface Point {
+  x: number;
+  y: number;
+}
+`;
+
+describe("Value Records", () => {
+  it("should emit closed interfaces as structs in declaration order", async () => {
+    const input = POINT + `
+type Label = {
+  text: string;
+  at: Point;
+  size?: number;
+};
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(
+      result.header,
+      "struct Point {\n    js::number x;\n    js::number y;\n};",
+    );
+    assertStringIncludes(result.header, "static_assert(std::is_trivially_copyable_v<Point>);");
+    assertStringIncludes(result.header, "struct Label {");
+    assertStringIncludes(result.header, "    std::optional<js::number> size;");
+    assertEquals(result.header.includes("is_trivially_copyable_v<Label>"), false);
+  });
+
+  it("should build object literals by aggregate initialization", async () => {
+    const input = POINT + `
+const origin: Point = { x: 0, y: 0 };
+
+function translate(p: Point, dx: number): Point {
+  return { x: p.x + dx, y: p.y };
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(
+      result.source,
+      "Point origin = Point{.x = js::number(0), .y = js::number(0)};",
+    );
+    assertStringIncludes(result.source, "return Point{.x = (p.x + dx), .y = p.y};");
+    assertEquals(result.source.includes("js::object"), false);
+  });
+
+  it("should access nested struct fields directly", async () => {
+    const input = POINT + `
+interface Segment {
+  from: Point;
+  to: Point;
+}
+
+function width(s: Segment): number {
+  return s.to.x - s.from.x;
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.source, "s.to.x");
+    assertStringIncludes(result.source, "s.from.x");
+  });
+
+  it("should keep js::object for literals that do not match the shape", async () => {
+    const input = POINT + `
+function computed(): void {
+  const p: Point = { ["x"]: 1, y: 2 };
+  console.log(p);
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.source, "js::object p = ");
+    assertEquals(result.source.includes("Point p"), false);
+    assertEquals(result.warnings.some((w) => w.code === "STRUCT_LITERAL"), true);
+  });
+
+  it("should build object literal arguments of struct parameters", async () => {
+    const input = POINT + `
+function translate(p: Point, dx: number): number {
+  return p.x + dx;
+}
+
+function shifted(): number {
+  return translate({ x: 1, y: 2 }, 3);
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(
+      result.source,
+      "translate(Point{.x = js::number(1), .y = js::number(2)}, js::number(3))",
+    );
+  });
+
+  it("should keep interfaces with methods as abstract classes", async () => {
+    const input = `
+interface Shape {
+  area(): number;
+}
+`;
+
+    const result = await transpile(input);
+    assertStringIncludes(result.header, "class IShape {");
+    assertEquals(result.header.includes("struct Shape"), false);
+  });
+});
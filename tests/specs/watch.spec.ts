@@ -0,0 +1,70 @@
+/**
+ * Tests for project watch mode (src/watch.ts)
+ */
+
+import { afterEach, beforeEach, describe, it } from "@std/testing/bdd";
+import { assertEquals } from "@std/assert";
+import { join } from "@std/path";
+import { watchProject, type WatchIteration } from "../../src/watch.ts";
+
+describe("Watch Mode", () => {
+  let root: string;
+
+  beforeEach(async () => {
+    // File events carry real paths (e.g. /private/var on macOS)
+    root = await Deno.realPath(await Deno.makeTempDir());
+    await Deno.writeTextFile(
+      join(root, "main.ts"),
+      `import { answer } from "./answer.ts";\nconsole.log(answer());`,
+    );
+    await Deno.writeTextFile(
+      join(root, "answer.ts"),
+      `export function answer(): number {\n  return 42;\n}`,
+    );
+    await Deno.writeTextFile(join(root, "other.ts"), `console.log("other");`);
+  });
+
+  afterEach(async () => {
+    await Deno.remove(root, { recursive: true });
+  });
+
+  it("should retranspile changed modules and their importers", async () => {
+    const controller = new AbortController();
+    const iterations: WatchIteration[] = [];
+    let next: (() => void) | undefined;
+
+    const session = watchProject({ project: { include: ["*.ts"], exclude: [] } }, {
+      root,
+      outputDir: "out",
+      debounce: 20,
+      signal: controller.signal,
+      onIteration: (iteration) => {
+        iterations.push(iteration);
+        next?.();
+      },
+    });
+
+    // Wait for the initial run and the watcher to start
+    while (iterations.length === 0) {
+      await new Promise((resolve) => setTimeout(resolve, 10));
+    }
+    await new Promise((resolve) => setTimeout(resolve, 50));
+
+    const changed = new Promise<void>((resolve) => next = resolve);
+    await Deno.writeTextFile(
+      join(root, "answer.ts"),
+      `export function answer(): number {\n  return 6 * 7;\n}`,
+    );
+    await changed;
+    controller.abort();
+    await session;
+
+    assertEquals(iterations[0].transpiled, 3);
+    assertEquals(iterations[1].changed, [join(root, "answer.ts")]);
+    assertEquals(iterations[1].transpiled, 2);
+    assertEquals(
+      iterations[1].result.files.map((file) => [file.module.relativePath, file.reused ?? false]),
+      [["answer.ts", false], ["main.ts", false], ["other.ts", true]],
+    );
+  });
+});